@@ -41,11 +41,11 @@ AC_REQUIRE([MPFR_CHECK_LIBM])
 AC_REQUIRE([MPFR_CHECK_LIBQUADMATH])
 AC_REQUIRE([AC_CANONICAL_HOST])
 
-dnl Features for the MPFR shared cache. This needs to be done
-dnl quite early since this may change CC, CFLAGS and LIBS, which
-dnl may affect the other tests.
+dnl Features for the MPFR shared cache and the parallel functions (both
+dnl need threads). This needs to be done quite early since this may
+dnl change CC, CFLAGS and LIBS, which may affect the other tests.
 
-if test "$enable_shared_cache" = yes; then
+if test "$enable_shared_cache" = yes || test "$enable_parallel" = yes; then
 
 dnl Prefer ISO C11 threads (as in mpfr-thread.h).
   MPFR_CHECK_C11_THREAD()
@@ -93,19 +93,19 @@ pthread_rwlock_t lock; (void) lock;
     fi
   fi
 
-  AC_MSG_CHECKING(if shared cache can be supported)
+  AC_MSG_CHECKING(if threads can be supported)
   if test "$mpfr_c11_thread_ok" = yes; then
     AC_MSG_RESULT([yes, with ISO C11 threads])
   elif test "$mpfr_pthread_ok" = yes; then
     AC_MSG_RESULT([yes, with pthread])
   else
     AC_MSG_RESULT(no)
-    AC_MSG_ERROR([shared cache needs C11 threads or pthread support])
+    AC_MSG_ERROR([shared cache and parallel functions need C11 threads or pthread support])
   fi
 
 fi
 
-dnl End of features for the MPFR shared cache.
+dnl End of features for the MPFR shared cache and the parallel functions.
 
 AC_CHECK_HEADER([limits.h],, AC_MSG_ERROR([limits.h not found]))
 AC_CHECK_HEADER([float.h],,  AC_MSG_ERROR([float.h not found]))
@@ -833,6 +833,67 @@ Please use another compiler or build MPFR without --enable-float128.])
       ])
 fi
 
+dnl Check if function multiversioning can be used with the levels of the
+dnl x86-64 psABI, i.e. whether the target_clones attribute (which needs
+dnl ifunc support from the toolchain and the C library) and the
+dnl corresponding __builtin_cpu_supports features are supported.
+if test "$enable_fmv" = yes; then
+   AC_MSG_CHECKING(if function multiversioning is supported)
+   AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+__attribute__ ((target_clones ("arch=x86-64-v3", "arch=x86-64-v2", "default")))
+int f (int x) { return x + 1; }
+]], [[
+return f (__builtin_cpu_supports ("x86-64-v3") +
+          __builtin_cpu_supports ("x86-64-v2")) == 0;
+]])],
+      [AC_MSG_RESULT(yes)
+       AC_DEFINE([MPFR_WANT_FMV],1,[Build several variants of hot functions])],
+      [AC_MSG_RESULT(no)
+       AC_MSG_ERROR(
+[function multiversioning is not supported (this needs an x86-64 target,
+the target_clones attribute and ifunc support). Please build MPFR without
+--enable-fmv.])])
+fi
+
+dnl Check for the intrinsics giving an addition (subtraction) of 64-bit
+dnl integers with carry (borrow) in and out, used in add1sp.c and sub1sp.c
+dnl when limbs have 64 bits: __builtin_addcll and __builtin_subcll (clang,
+dnl GCC 14+), otherwise _addcarry_u64 and _subborrow_u64 (x86-64).
+AC_CACHE_CHECK([for __builtin_addcll and __builtin_subcll],
+               mpfr_cv_have_builtin_addcll, [
+AC_LINK_IFELSE([AC_LANG_PROGRAM([[]], [[
+volatile unsigned long long a = 17, b = 42;
+unsigned long long s, d, c1, c2;
+s = __builtin_addcll (a, b, 1, &c1);
+d = __builtin_subcll (a, b, c1, &c2);
+return s != 60 || c2 != 1 || d + b + c1 != a;
+]])],
+   mpfr_cv_have_builtin_addcll=yes, mpfr_cv_have_builtin_addcll=no)
+])
+if test "$mpfr_cv_have_builtin_addcll" = yes; then
+   AC_DEFINE([MPFR_HAVE_BUILTIN_ADDCLL],1,
+             [Define if __builtin_addcll and __builtin_subcll work])
+else
+   AC_CACHE_CHECK([for _addcarry_u64 and _subborrow_u64],
+                  mpfr_cv_have_addcarry_u64, [
+   AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+#include <x86intrin.h>
+]], [[
+volatile unsigned long long a = 17, b = 42;
+unsigned long long s, d;
+unsigned char c1, c2;
+c1 = _addcarry_u64 (1, a, b, &s);
+c2 = _subborrow_u64 (c1, a, b, &d);
+return s != 60 || c2 != 1 || d + b != a;
+]])],
+      mpfr_cv_have_addcarry_u64=yes, mpfr_cv_have_addcarry_u64=no)
+   ])
+   if test "$mpfr_cv_have_addcarry_u64" = yes; then
+      AC_DEFINE([MPFR_HAVE_ADDCARRY_U64],1,
+                [Define if _addcarry_u64 and _subborrow_u64 work])
+   fi
+fi
+
 dnl Check if _Float16 is available and if the conversion functions,
 dnl which use the optional uint16_t type, can be compiled.
 dnl Also check whether it is possible to convert between _Float16
@@ -130,8 +130,8 @@ mpfr_acos (mpfr_ptr acos, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
                                        MPFR_PREC (acos), rnd_mode)))
         break;
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (tmp, prec);
-      mpfr_set_prec (arcc, prec);
+      mpfr_ziv_set_prec (tmp, prec);
+      mpfr_ziv_set_prec (arcc, prec);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -142,7 +142,7 @@ mpfr_acosh (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
         /* reactualisation of the precision */
         MPFR_ZIV_NEXT (loop, Nt);
-        mpfr_set_prec (t, Nt);
+        mpfr_ziv_set_prec (t, Nt);
       }
     MPFR_ZIV_FREE (loop);
 
@@ -119,3 +119,25 @@ mpfr_add (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
           return mpfr_add1(a, b, c, rnd_mode);
     }
 }
+
+/* Vector form of mpfr_add: r[i] <- a[i] + b[i] for 0 <= i < n, with the
+   ternary value of each sum stored in inex[i]. The elements whose inputs
+   are regular and share the precision of r[0] directly go to mpfr_add1sp
+   or mpfr_sub1sp; the other ones are handled by mpfr_add. */
+void
+mpfr_add_vec (int *inex, const mpfr_ptr *r, const mpfr_ptr *a,
+              const mpfr_ptr *b, unsigned long n, mpfr_rnd_t rnd_mode)
+{
+  unsigned long i;
+  mpfr_prec_t p;
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  p = MPFR_GET_PREC (r[0]);
+  MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                 MPFR_SIGN (a[i]) == MPFR_SIGN (b[i]) ?
+                 mpfr_add1sp (r[i], a[i], b[i], rnd_mode) :
+                 mpfr_sub1sp (r[i], a[i], b[i], rnd_mode),
+                 mpfr_add (r[i], a[i], b[i], rnd_mode));
+}
@@ -25,6 +25,241 @@ If not, see <https://www.gnu.org/licenses/>. */
    detection of reused arguments, do comparisons on the pointers to the
    significands instead of pointers to the MPFR numbers. */
 
+/* In-place addition or subtraction, for mpfr_add1 and mpfr_sub1: a and b
+   share their significand, PREC(a) = PREC(b), PREC(c) <= PREC(a), and
+   neither b nor c is a UBF.
+   Set a to sign * (|b| + |c|) if sub = 0, to sign * (|b| - |c|) otherwise,
+   assuming EXP(b) >= EXP(c) for an addition, EXP(b) >= EXP(c) + 2 for a
+   subtraction. Only the limbs of a that overlap with c and those reached by
+   the carry or borrow propagation are read and written, so that the cost is
+   O(PREC(c)) in general instead of O(PREC(a)), and even less when the low
+   limbs of c are zero.
+   For a subtraction, the case where the most significant bit of a could
+   change is not handled (it would need a shift of all the limbs): 0 is then
+   returned and a is unchanged. Otherwise 1 is returned and the ternary value
+   is stored in *inex. The rounding mode must not be MPFR_RNDF. */
+int
+mpfr_add1_inplace (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, int sign,
+                   int sub, mpfr_rnd_t rnd_mode, int *inex)
+{
+  mp_limb_t *ap, *cp, *tp;
+  mpfr_prec_t aq;
+  mp_size_t an, cn, tn, k0, i;
+  mpfr_exp_t exp;
+  mpfr_uexp_t diff_exp;
+  mp_limb_t rb, sb, cy, ulp;
+  int sh;
+  MPFR_TMP_DECL(marker);
+  MPFR_LOG_FUNC
+    (("b[%Pd]=%.*Rg c[%Pd]=%.*Rg sub=%d rnd=%d",
+      mpfr_get_prec (b), mpfr_log_prec, b,
+      mpfr_get_prec (c), mpfr_log_prec, c, sub, rnd_mode),
+     ("a[%Pd]=%.*Rg", mpfr_get_prec (a), mpfr_log_prec, a));
+
+  ap = MPFR_MANT (a);
+  cp = MPFR_MANT (c);
+  aq = MPFR_GET_PREC (a);
+  an = MPFR_LIMB_SIZE (a);
+  cn = MPFR_LIMB_SIZE (c);
+  exp = MPFR_GET_EXP (b);
+  diff_exp = (mpfr_uexp_t) exp - MPFR_GET_EXP (c);
+  sh = (mpfr_prec_t) an * GMP_NUMB_BITS - aq;
+  ulp = MPFR_LIMB_ONE << sh;
+
+  MPFR_ASSERTD (ap == MPFR_MANT (b) && ap != cp);
+  MPFR_ASSERTD (MPFR_GET_PREC (b) == aq);
+  MPFR_ASSERTD (rnd_mode != MPFR_RNDF);
+  MPFR_ASSERTD (MPFR_GET_EXP (c) <= exp - 2 * (sub != 0));
+
+  /* Skip the low zero limbs of c, which can be numerous when c is a small
+     integer or a dyadic constant stored in a large precision. This keeps
+     the most significant bit of {cp, cn} at the same position. */
+  while (*cp == 0)
+    {
+      cp++;
+      cn--;
+    }
+
+  MPFR_TMP_MARK(marker);
+  tp = MPFR_TMP_LIMBS_ALLOC (cn + 2);
+  tn = k0 = 0;
+
+  /* Split |c| into the part above ulp(a), stored in {tp, tn} and aligned
+     with the limb k0 of a, and the part below ulp(a), of which we keep the
+     round bit rb and the sticky bit sb. */
+  if (diff_exp > (mpfr_uexp_t) aq) /* |c| < 1/2 ulp(a) */
+    {
+      rb = 0;
+      sb = 1;
+    }
+  else if (diff_exp == (mpfr_uexp_t) aq) /* 1/2 ulp(a) <= |c| < ulp(a) */
+    {
+      rb = 1;
+      sb = cp[cn - 1] ^ MPFR_LIMB_HIGHBIT;
+      for (i = 0; sb == 0 && i < cn - 1; i++)
+        sb = cp[i];
+    }
+  else
+    {
+      /* position of the least significant bit of {cp, cn} with respect
+         to the least significant bit of {ap, an} */
+      mpfr_exp_t lo = (mpfr_exp_t) (an - cn) * GMP_NUMB_BITS
+        - (mpfr_exp_t) diff_exp;
+      mp_limb_t rl, sl; /* bit of c at position -1, and the bits below */
+
+      if (lo >= 0)
+        {
+          int s = lo % GMP_NUMB_BITS;
+
+          k0 = lo / GMP_NUMB_BITS;
+          if (s != 0)
+            tp[cn] = mpn_lshift (tp, cp, cn, s);
+          else
+            MPN_COPY (tp, cp, cn);
+          tn = cn + (s != 0);
+          rl = sl = 0;
+        }
+      else
+        {
+          mp_size_t q = (mpfr_uexp_t) -lo / GMP_NUMB_BITS;
+          int s = (mpfr_uexp_t) -lo % GMP_NUMB_BITS;
+
+          /* since |c| >= ulp(a), c has at least one bit at a position >= 0 */
+          MPFR_ASSERTD (q < cn);
+          tn = cn - q;
+          if (s != 0)
+            {
+              sl = mpn_rshift (tp, cp + q, tn, s);
+              rl = sl >> (GMP_NUMB_BITS - 1);
+              sl <<= 1;
+            }
+          else
+            {
+              MPN_COPY (tp, cp + q, tn);
+              q--;
+              rl = cp[q] >> (GMP_NUMB_BITS - 1);
+              sl = cp[q] << 1;
+            }
+          for (i = 0; sl == 0 && i < q; i++)
+            sl = cp[i];
+        }
+
+      if (k0 > 0)
+        rb = sb = 0;
+      else if (sh != 0)
+        {
+          rb = (tp[0] >> (sh - 1)) & 1;
+          sb = (tp[0] & MPFR_LIMB_MASK (sh - 1)) | rl | sl;
+          tp[0] &= ~MPFR_LIMB_MASK (sh);
+        }
+      else
+        {
+          rb = rl;
+          sb = sl;
+        }
+    }
+
+  if (sub)
+    {
+      if (rb != 0 || sb != 0)
+        {
+          /* |b| - |c| = (|b| - {tp, tn} - ulp(a)) + (ulp(a) - low(c)),
+             where low(c) is the part of |c| below ulp(a): the round bit
+             of ulp(a) - low(c) is the complement of rb unless low(c) is
+             1/2 ulp(a), and its sticky bit is sb */
+          MPFR_ASSERTD (k0 == 0);
+          if (sb != 0)
+            rb ^= 1;
+          if (tn == 0)
+            tp[tn++] = ulp;
+          else if (mpn_add_1 (tp, tp, tn, ulp))
+            tp[tn++] = 1;
+        }
+      /* The most significant bit of a must not change. Since |c| < |b|/2,
+         {tp, tn} fits in an - k0 limbs. If it reaches the most significant
+         limb of a, the borrow coming from the lower limbs is at most 1;
+         otherwise the borrow must not propagate up to this limb. */
+      MPFR_ASSERTD (k0 + tn <= an);
+      if (k0 + tn == an)
+        {
+          if (ap[an - 1] - MPFR_LIMB_HIGHBIT <= tp[tn - 1])
+            goto not_done;
+        }
+      else
+        {
+          for (i = k0 + tn; i < an - 1 && ap[i] == 0; i++)
+            ;
+          if (i == an - 1 && ap[an - 1] == MPFR_LIMB_HIGHBIT)
+            goto not_done;
+        }
+
+      MPFR_SET_SIGN (a, sign);
+      cy = tn == 0 ? 0 : mpn_sub_n (ap + k0, ap + k0, tp, tn);
+      for (i = k0 + tn; cy != 0; i++)
+        cy = ap[i]-- == 0;
+      MPFR_ASSERTD (ap[an - 1] & MPFR_LIMB_HIGHBIT);
+    }
+  else
+    {
+      MPFR_SET_SIGN (a, sign);
+      cy = tn == 0 ? 0 : mpn_add_n (ap + k0, ap + k0, tp, tn);
+      for (i = k0 + tn; cy != 0 && i < an; i++)
+        cy = ++ap[i] == 0;
+      if (MPFR_UNLIKELY (cy != 0)) /* |b| + |c| >= 2^EXP(b) */
+        {
+          if (MPFR_UNLIKELY (exp == __gmpfr_emax))
+            {
+              *inex = mpfr_overflow (a, rnd_mode, sign);
+              goto end;
+            }
+          exp++;
+          sb |= rb;
+          rb = (ap[0] >> sh) & 1;
+          mpn_rshift (ap, ap, an, 1);
+          ap[an - 1] |= MPFR_LIMB_HIGHBIT;
+          ap[0] &= ~MPFR_LIMB_MASK (sh);
+        }
+    }
+
+  MPFR_UPDATE2_RND_MODE (rnd_mode, sign);
+  /* now rnd_mode is either MPFR_RNDN, MPFR_RNDZ or MPFR_RNDA. */
+  if (rb == 0 && sb == 0)
+    *inex = 0;
+  else if (rnd_mode == MPFR_RNDZ ||
+           (rnd_mode == MPFR_RNDN &&
+            (rb == 0 || (sb == 0 && (ap[0] & ulp) == 0))))
+    *inex = -sign;
+  else /* add one ulp */
+    {
+      *inex = sign;
+      ap[0] += ulp;
+      cy = ap[0] < ulp;
+      for (i = 1; cy != 0 && i < an; i++)
+        cy = ++ap[i] == 0;
+      if (MPFR_UNLIKELY (cy != 0))
+        {
+          /* not possible for a subtraction, since |b| - |c| < |b| */
+          MPFR_ASSERTD (sub == 0);
+          if (MPFR_UNLIKELY (exp == __gmpfr_emax))
+            {
+              *inex = mpfr_overflow (a, rnd_mode, sign);
+              goto end;
+            }
+          exp++;
+          ap[an - 1] = MPFR_LIMB_HIGHBIT;
+        }
+    }
+  MPFR_SET_EXP (a, exp);
+
+ end:
+  MPFR_TMP_FREE(marker);
+  return 1;
+
+ not_done:
+  MPFR_TMP_FREE(marker);
+  return 0;
+}
+
 /* compute sign(b) * (|b| + |c|), assuming that b and c
    are not NaN, Inf, nor zero. Assumes EXP(b) >= EXP(c).
 */
@@ -59,6 +294,20 @@ mpfr_add1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
   MPFR_ASSERTD (exp <= __gmpfr_emax);
 
+  if (MPFR_UNLIKELY (MPFR_MANT (a) == MPFR_MANT (b)) &&
+      MPFR_MANT (a) != MPFR_MANT (c) &&
+      MPFR_GET_PREC (a) == MPFR_GET_PREC (b) &&
+      MPFR_GET_PREC (c) <= MPFR_GET_PREC (a) && rnd_mode != MPFR_RNDF &&
+      ! MPFR_IS_UBF (b) && ! MPFR_IS_UBF (c))
+    {
+      /* in-place addition, typically a small correction to a large
+         accumulator: see mpfr_add1_inplace. MPFR_RNDF is left to the
+         generic code, so that the result does not depend on whether a
+         and b are the same variable. */
+      mpfr_add1_inplace (a, b, c, MPFR_SIGN (b), 0, rnd_mode, &inex);
+      MPFR_RET (inex);
+    }
+
   MPFR_TMP_MARK(marker);
 
   aq = MPFR_GET_PREC (a);
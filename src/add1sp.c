@@ -370,7 +370,7 @@ mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   mpfr_prec_t sh = 2*GMP_NUMB_BITS - p;
   mp_limb_t rb; /* round bit */
   mp_limb_t sb; /* sticky bit */
-  mp_limb_t a1, a0;
+  mp_limb_t a1, a0, cy;
   mp_limb_t mask;
   mpfr_uexp_t d;
 
@@ -379,8 +379,8 @@ mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   if (bx == cx)
     {
       /* since bp[1], cp[1] >= MPFR_LIMB_HIGHBIT, a carry always occurs */
-      a0 = bp[0] + cp[0];
-      a1 = bp[1] + cp[1] + (a0 < bp[0]);
+      MPFR_ADDC (a0, cy, bp[0], cp[0], 0);
+      MPFR_ADDC (a1, cy, bp[1], cp[1], cy);
       a0 = (a0 >> 1) | (a1 << (GMP_NUMB_BITS - 1));
       bx ++;
       rb = a0 & (MPFR_LIMB_ONE << (sh - 1));
@@ -403,9 +403,10 @@ mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
       if (d < GMP_NUMB_BITS) /* 0 < d < GMP_NUMB_BITS */
         {
           sb = cp[0] << (GMP_NUMB_BITS - d); /* bits from cp[-1] after shift */
-          a0 = bp[0] + ((cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d));
-          a1 = bp[1] + (cp[1] >> d) + (a0 < bp[0]);
-          if (a1 < bp[1]) /* carry in high word */
+          MPFR_ADDC (a0, cy, bp[0],
+                     (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d), 0);
+          MPFR_ADDC (a1, cy, bp[1], cp[1] >> d, cy);
+          if (cy) /* carry in high word */
             {
             exponent_shift:
               sb |= a0 & MPFR_LIMB_ONE;
@@ -424,8 +425,8 @@ mpfr_add1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
         {
           sb = (d == GMP_NUMB_BITS) ? cp[0]
             : cp[0] | (cp[1] << (2*GMP_NUMB_BITS-d));
-          a0 = bp[0] + (cp[1] >> (d - GMP_NUMB_BITS));
-          a1 = bp[1] + (a0 < bp[0]);
+          MPFR_ADDC (a0, cy, bp[0], cp[1] >> (d - GMP_NUMB_BITS), 0);
+          a1 = bp[1] + cy;
           if (a1 == 0)
             goto exponent_shift;
           rb = a0 & (MPFR_LIMB_ONE << (sh - 1));
@@ -623,7 +624,7 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   mpfr_prec_t sh = 3*GMP_NUMB_BITS - p;
   mp_limb_t rb; /* round bit */
   mp_limb_t sb; /* sticky bit */
-  mp_limb_t a2, a1, a0;
+  mp_limb_t a2, a1, a0, cy;
   mp_limb_t mask;
   mpfr_uexp_t d;
 
@@ -632,9 +633,9 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   if (bx == cx)
     {
       /* since bp[2], cp[2] >= MPFR_LIMB_HIGHBIT, a carry always occurs */
-      a0 = bp[0] + cp[0];
-      a1 = bp[1] + cp[1] + (a0 < bp[0]);
-      a2 = bp[2] + cp[2] + (a1 < bp[1] || (a1 == bp[1] && a0 < bp[0]));
+      MPFR_ADDC (a0, cy, bp[0], cp[0], 0);
+      MPFR_ADDC (a1, cy, bp[1], cp[1], cy);
+      MPFR_ADDC (a2, cy, bp[2], cp[2], cy);
       /* since p < 3 * GMP_NUMB_BITS, we lose no bit in a0 >> 1 */
       a0 = (a1 << (GMP_NUMB_BITS - 1)) | (a0 >> 1);
       bx ++;
@@ -658,14 +659,13 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
       mask = MPFR_LIMB_MASK(sh);
       if (d < GMP_NUMB_BITS) /* 0 < d < GMP_NUMB_BITS */
         {
-          mp_limb_t cy;
           sb = cp[0] << (GMP_NUMB_BITS - d); /* bits from cp[-1] after shift */
-          a0 = bp[0] + ((cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d));
-          a1 = bp[1] + ((cp[2] << (GMP_NUMB_BITS - d)) | (cp[1] >> d))
-            + (a0 < bp[0]);
-          cy = a1 < bp[1] || (a1 == bp[1] && a0 < bp[0]); /* carry in a1 */
-          a2 = bp[2] + (cp[2] >> d) + cy;
-          if (a2 < bp[2] || (a2 == bp[2] && cy)) /* carry in high word */
+          MPFR_ADDC (a0, cy, bp[0],
+                     (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d), 0);
+          MPFR_ADDC (a1, cy, bp[1],
+                     (cp[2] << (GMP_NUMB_BITS - d)) | (cp[1] >> d), cy);
+          MPFR_ADDC (a2, cy, bp[2], cp[2] >> d, cy);
+          if (cy) /* carry in high word */
             {
             exponent_shift:
               sb |= a0 & MPFR_LIMB_ONE;
@@ -691,13 +691,9 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
             : (cp[1] << (2*GMP_NUMB_BITS - d)) | cp[0];
           c0shifted = (d == GMP_NUMB_BITS) ? cp[1]
             : (cp[2] << (2*GMP_NUMB_BITS-d)) | (cp[1] >> (d - GMP_NUMB_BITS));
-          a0 = bp[0] + c0shifted;
-          a1 = bp[1] + (cp[2] >> (d - GMP_NUMB_BITS)) + (a0 < bp[0]);
-          /* if a1 < bp[1], there was a carry in the above addition,
-             or when a1 = bp[1] and one of the added terms is non-zero
-             (the sum of cp[2] >> (d - GMP_NUMB_BITS) and a0 < bp[0]
-             is at most 2^GMP_NUMB_BITS-d) */
-          a2 = bp[2] + ((a1 < bp[1]) || (a1 == bp[1] && a0 < bp[0]));
+          MPFR_ADDC (a0, cy, bp[0], c0shifted, 0);
+          MPFR_ADDC (a1, cy, bp[1], cp[2] >> (d - GMP_NUMB_BITS), cy);
+          a2 = bp[2] + cy;
           if (a2 == 0)
             goto exponent_shift;
           rb = a0 & (MPFR_LIMB_ONE << (sh - 1));
@@ -711,9 +707,9 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
           MPFR_ASSERTD (2*GMP_NUMB_BITS <= d && d < 3*GMP_NUMB_BITS);
           sb = (d == 2*GMP_NUMB_BITS ? 0 : cp[2] << (3*GMP_NUMB_BITS - d))
             | cp[1] | cp[0];
-          a0 = bp[0] + (cp[2] >> (d - 2*GMP_NUMB_BITS));
-          a1 = bp[1] + (a0 < bp[0]);
-          a2 = bp[2] + (a1 < bp[1]);
+          MPFR_ADDC (a0, cy, bp[0], cp[2] >> (d - 2*GMP_NUMB_BITS), 0);
+          MPFR_ADDC (a1, cy, bp[1], 0, cy);
+          a2 = bp[2] + cy;
           if (a2 == 0)
             goto exponent_shift;
           rb = a0 & (MPFR_LIMB_ONE << (sh - 1));
@@ -770,6 +766,25 @@ mpfr_add1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
     }
 }
 
+/* Special code for 3*GMP_NUMB_BITS < p <= 8*GMP_NUMB_BITS, generated from
+   add1sp_fixed.h: mpfr_add1spN is used when MPFR_PREC2LIMBS(p) = N and the
+   exponents of b and c differ by less than GMP_NUMB_BITS. */
+#define FUNCTION mpfr_add1sp4
+#define N 4
+#include "add1sp_fixed.h"
+#define FUNCTION mpfr_add1sp5
+#define N 5
+#include "add1sp_fixed.h"
+#define FUNCTION mpfr_add1sp6
+#define N 6
+#include "add1sp_fixed.h"
+#define FUNCTION mpfr_add1sp7
+#define N 7
+#include "add1sp_fixed.h"
+#define FUNCTION mpfr_add1sp8
+#define N 8
+#include "add1sp_fixed.h"
+
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
 /* {ap, n} <- {bp, n} + {cp + q, n - q} >> r where d = q * GMP_NUMB_BITS + r.
@@ -784,7 +799,7 @@ static mp_limb_t
 mpfr_addrsh (mp_limb_t *ap, mp_limb_t *bp, mp_limb_t *cp, mp_size_t n,
              mp_size_t d, mp_limb_t *low)
 {
-  mp_limb_t cy, cy2, c_shifted;
+  mp_limb_t cy, c_shifted;
   mp_size_t i;
 
   if (d < GMP_NUMB_BITS)
@@ -796,17 +811,11 @@ mpfr_addrsh (mp_limb_t *ap, mp_limb_t *bp, mp_limb_t *cp, mp_size_t n,
       for (i = 0, cy = 0; i < n - 1; i++)
         {
           c_shifted = (cp[i+1] << (GMP_NUMB_BITS - d)) | (cp[i] >> d);
-          ap[i] = bp[i] + c_shifted;
-          cy2 = ap[i] < c_shifted;
-          ap[i] += cy;
-          cy = cy2 + (ap[i] < cy);
+          MPFR_ADDC (ap[i], cy, bp[i], c_shifted, cy);
         }
       /* most significant limb is special */
       c_shifted = cp[i] >> d;
-      ap[i] = bp[i] + c_shifted;
-      cy2 = ap[i] < c_shifted;
-      ap[i] += cy;
-      cy = cy2 + (ap[i] < cy);
+      MPFR_ADDC (ap[i], cy, bp[i], c_shifted, cy);
     }
   else /* d >= GMP_NUMB_BITS */
     {
@@ -829,18 +838,12 @@ mpfr_addrsh (mp_limb_t *ap, mp_limb_t *bp, mp_limb_t *cp, mp_size_t n,
           for (i = 0, cy = 0; i < n - q - 1; i++)
             {
               c_shifted = (cp[q+i+1] << (GMP_NUMB_BITS - r)) | (cp[q+i] >> r);
-              ap[i] = bp[i] + c_shifted;
-              cy2 = ap[i] < c_shifted;
-              ap[i] += cy;
-              cy = cy2 + (ap[i] < cy);
+              MPFR_ADDC (ap[i], cy, bp[i], c_shifted, cy);
             }
           /* most significant limb of c is special */
           MPFR_ASSERTD(i == n - q - 1);
           c_shifted = cp[n-1] >> r;
-          ap[i] = bp[i] + c_shifted;
-          cy2 = ap[i] < c_shifted;
-          ap[i] += cy;
-          cy = cy2 + (ap[i] < cy);
+          MPFR_ADDC (ap[i], cy, bp[i], c_shifted, cy);
           /* upper limbs are copied */
           cy = mpn_add_1 (ap + n - q, bp + n - q, q, cy);
         }
@@ -852,7 +855,7 @@ mpfr_addrsh (mp_limb_t *ap, mp_limb_t *bp, mp_limb_t *cp, mp_size_t n,
    Returns 0 iff result is exact,
    a negative value when the result is less than the exact value,
    a positive value otherwise. */
-MPFR_HOT_FUNCTION_ATTR int
+MPFR_HOT_FUNCTION_ATTR MPFR_FMV_FUNCTION_ATTR int
 mpfr_add1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_uexp_t d;
@@ -891,6 +894,25 @@ mpfr_add1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
   if (p == 2 * GMP_NUMB_BITS)
     return mpfr_add1sp2n (a, b, c, rnd_mode);
+
+  /* |EXP(b) - EXP(c)| < GMP_NUMB_BITS is tested with unsigned arithmetic,
+     which avoids an integer overflow */
+  if (3 * GMP_NUMB_BITS < p && p <= 8 * GMP_NUMB_BITS &&
+      (mpfr_uexp_t) MPFR_GET_EXP (b) - MPFR_GET_EXP (c) + (GMP_NUMB_BITS - 1)
+      < 2 * GMP_NUMB_BITS - 1)
+    switch (MPFR_PREC2LIMBS (p))
+      {
+      case 4:
+        return mpfr_add1sp4 (a, b, c, rnd_mode, p);
+      case 5:
+        return mpfr_add1sp5 (a, b, c, rnd_mode, p);
+      case 6:
+        return mpfr_add1sp6 (a, b, c, rnd_mode, p);
+      case 7:
+        return mpfr_add1sp7 (a, b, c, rnd_mode, p);
+      case 8:
+        return mpfr_add1sp8 (a, b, c, rnd_mode, p);
+      }
 #endif
 
   /* We need to get the sign before the possible exchange. */
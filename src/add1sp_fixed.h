@@ -0,0 +1,148 @@
+/* mpfr_add1spN -- add two floating-point numbers of N limbs
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Special code for (N-1)*GMP_NUMB_BITS < p = PREC(a) = PREC(b) = PREC(c)
+   <= N*GMP_NUMB_BITS, when the exponents of b and c differ by less than
+   GMP_NUMB_BITS (the other cases are rare for additions, and are left to
+   the generic code). Before including this file, define FUNCTION as the
+   name of the function and N as the number of limbs (see add1sp.c). Since
+   N is a constant, the compiler can unroll the loops on the limbs.
+
+   Since d = |EXP(b) - EXP(c)| < GMP_NUMB_BITS, the part of c shifted out
+   fits in one limb, thus sb below holds it exactly before normalization.
+   The sum is written directly to a, which may share its significand with
+   b or c: ap[i] is written after bp[i], cp[i] and cp[i+1] have been read. */
+
+static int
+FUNCTION (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
+          mpfr_prec_t p)
+{
+  mpfr_exp_t bx = MPFR_GET_EXP (b);
+  mpfr_exp_t cx = MPFR_GET_EXP (c);
+  mp_limb_t *ap = MPFR_MANT(a);
+  mp_limb_t *bp = MPFR_MANT(b);
+  mp_limb_t *cp = MPFR_MANT(c);
+  mpfr_prec_t sh = N * GMP_NUMB_BITS - p;
+  mp_limb_t rb, sb, cy, mask = MPFR_LIMB_MASK(sh);
+  mpfr_uexp_t d;
+  int i;
+
+  MPFR_ASSERTD((N - 1) * GMP_NUMB_BITS < p && p <= N * GMP_NUMB_BITS);
+
+  if (bx < cx)  /* swap b and c */
+    {
+      mpfr_exp_t tx;
+      mp_limb_t *tp;
+      tx = bx; bx = cx; cx = tx;
+      tp = bp; bp = cp; cp = tp;
+    }
+  d = (mpfr_uexp_t) bx - cx;
+  MPFR_ASSERTD(d < GMP_NUMB_BITS);
+
+  if (d == 0)
+    {
+      /* both significands have their most significant bit set, thus there
+         is a carry, and the only neglected bit is the bit of weight 2^sh
+         of the sum, which is the round bit (as in the generic code) */
+      MPFR_ADDC (ap[0], cy, bp[0], cp[0], 0);
+      for (i = 1; i < N; i++)
+        MPFR_ADDC (ap[i], cy, bp[i], cp[i], cy);
+      MPFR_ASSERTD(cy != 0);
+      rb = ap[0] & (MPFR_LIMB_ONE << sh);
+      sb = 0;
+      mpn_rshift (ap, ap, N, 1);
+      ap[N - 1] |= MPFR_LIMB_HIGHBIT;
+      ap[0] &= ~mask;
+      bx ++;
+    }
+  else
+    {
+      sb = cp[0] << (GMP_NUMB_BITS - d); /* neglected part of c */
+      MPFR_ADDC (ap[0], cy, bp[0],
+                 (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d), 0);
+      for (i = 1; i < N - 1; i++)
+        MPFR_ADDC (ap[i], cy, bp[i],
+                   (cp[i + 1] << (GMP_NUMB_BITS - d)) | (cp[i] >> d), cy);
+      MPFR_ADDC (ap[N - 1], cy, bp[N - 1], cp[N - 1] >> d, cy);
+
+      if (cy != 0) /* carry in high word */
+        {
+          /* the most significant bit of sb must be kept exact, since it is
+             the round bit when sh = 0 */
+          sb = (ap[0] << (GMP_NUMB_BITS - 1)) | (sb >> 1) | (sb & 1);
+          mpn_rshift (ap, ap, N, 1);
+          ap[N - 1] |= MPFR_LIMB_HIGHBIT;
+          bx ++;
+        }
+
+      if (sh == 0)
+        {
+          rb = sb & MPFR_LIMB_HIGHBIT;
+          sb ^= rb;
+        }
+      else
+        {
+          rb = ap[0] & (MPFR_LIMB_ONE << (sh - 1));
+          sb |= (ap[0] & mask) ^ rb;
+          ap[0] &= ~mask;
+        }
+    }
+
+  /* now perform rounding */
+  if (MPFR_UNLIKELY(bx > __gmpfr_emax))
+    return mpfr_overflow (a, rnd_mode, MPFR_SIGN(a));
+
+  MPFR_SET_EXP (a, bx);
+  if ((rb == 0 && sb == 0) || rnd_mode == MPFR_RNDF)
+    MPFR_RET(0);
+  else if (rnd_mode == MPFR_RNDN)
+    {
+      if (rb == 0 || (sb == 0 && (ap[0] & (MPFR_LIMB_ONE << sh)) == 0))
+        goto truncate;
+      else
+        goto add_one_ulp;
+    }
+  else if (MPFR_IS_LIKE_RNDZ(rnd_mode, MPFR_IS_NEG(a)))
+    {
+    truncate:
+      MPFR_RET(-MPFR_SIGN(a));
+    }
+  else /* round away from zero */
+    {
+    add_one_ulp:
+      ap[0] += MPFR_LIMB_ONE << sh;
+      for (i = 1; i < N && ap[i - 1] == 0; i++)
+        ap[i] ++;
+      if (MPFR_UNLIKELY(ap[N - 1] == 0))
+        {
+          ap[N - 1] = MPFR_LIMB_HIGHBIT;
+          /* no need to have MPFR_LIKELY here, since we are in a rare branch */
+          if (bx + 1 <= __gmpfr_emax)
+            MPFR_SET_EXP (a, bx + 1);
+          else /* overflow */
+            return mpfr_overflow (a, rnd_mode, MPFR_SIGN(a));
+        }
+      MPFR_RET(MPFR_SIGN(a));
+    }
+}
+
+#undef FUNCTION
+#undef N
@@ -229,12 +229,13 @@ mpfr_agm (mpfr_ptr r, mpfr_srcptr op2, mpfr_srcptr op1, mpfr_rnd_t rnd_mode)
           if (eq > p / 4)
             {
               mpfr_t w;
+              MPFR_GROUP_DECL (group);
               MPFR_BLOCK_DECL (flags3);
 
               MPFR_LOG_MSG (("4*eq > p\n", 0));
 
               /* vf = V(k) */
-              mpfr_init2 (w, (p + 1) / 2);
+              MPFR_GROUP_INIT_1 (group, (p + 1) / 2, w);
               MPFR_BLOCK
                 (flags3,
                  mpfr_sub (w, v, u, MPFR_RNDN);       /* e = V(k-1)-U(k-1) */
@@ -246,14 +247,14 @@ mpfr_agm (mpfr_ptr r, mpfr_srcptr op2, mpfr_srcptr op1, mpfr_rnd_t rnd_mode)
                 {
                   mpfr_sub (v, vf, w, MPFR_RNDN);
                   err = MPFR_GET_EXP (vf) - MPFR_GET_EXP (v); /* 0 or 1 */
-                  mpfr_clear (w);
+                  MPFR_GROUP_CLEAR (group);
                   break;
                 }
               /* There has been an underflow because of the cancellation
                  between V(k-1) and U(k-1). Let's use the conventional
                  method. */
               MPFR_LOG_MSG (("4*eq > p -> underflow\n", 0));
-              mpfr_clear (w);
+              MPFR_GROUP_CLEAR (group);
               MPFR_CLEAR_UNDERFLOW ();
             }
           /* U(k) increases, so that U.V can overflow (but not underflow). */
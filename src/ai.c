@@ -198,10 +198,10 @@ mpfr_ai1 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
   for (;;)
     {
       MPFR_LOG_MSG (("Working precision: %Pd\n", wprec));
-      mpfr_set_prec (ti, wprec);
-      mpfr_set_prec (tip1, wprec);
-      mpfr_set_prec (x3, wprec);
-      mpfr_set_prec (s, wprec);
+      mpfr_ziv_set_prec (ti, wprec);
+      mpfr_ziv_set_prec (tip1, wprec);
+      mpfr_ziv_set_prec (x3, wprec);
+      mpfr_ziv_set_prec (s, wprec);
 
       mpfr_sqr (x3, x, MPFR_RNDU);
       mpfr_mul (x3, x3, x, (MPFR_IS_POS (x)?MPFR_RNDU:MPFR_RNDD));  /* x3=x^3 */
@@ -433,10 +433,10 @@ mpfr_ai2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
       MPFR_LOG_MSG (("working precision: %Pd\n", wprec));
 
       for (j=0; j<=L; j++)
-        mpfr_set_prec (z[j], wprec);
-      mpfr_set_prec (s, wprec);
-      mpfr_set_prec (u0, wprec); mpfr_set_prec (u1, wprec);
-      mpfr_set_prec (result, wprec);
+        mpfr_ziv_set_prec (z[j], wprec);
+      mpfr_ziv_set_prec (s, wprec);
+      mpfr_ziv_set_prec (u0, wprec); mpfr_ziv_set_prec (u1, wprec);
+      mpfr_ziv_set_prec (result, wprec);
 
       mpfr_set_ui (u0, 1, MPFR_RNDN);
       mpfr_set (u1, x, MPFR_RNDN);
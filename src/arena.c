@@ -0,0 +1,114 @@
+/* Limb arena for the temporaries of the MPFR_GROUP_* macros
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* If the arena is enabled */
+#if MPFR_ARENA_MAX_SIZE
+
+/* The arena is a single block of arena_size limbs, local to the thread,
+   whose first arena_top limbs are in use. Blocks are taken from the top
+   and given back with mpfr_arena_release, in the reverse order (like
+   MPFR_TMP_MARK/MPFR_TMP_FREE). Since the block cannot be moved while
+   some limbs are in use, it is only enlarged when it is empty, to the
+   largest size that has been needed so far (arena_need); the requests
+   that do not fit in the meantime are served from the heap by the caller.
+   Since the requests made above a block served from the heap do not count
+   this block, arena_need may underestimate the need of nested calls, thus
+   the arena is enlarged by at least half its size. Thus after a few calls
+   to some function, the next calls with the same precision do not use the
+   heap at all for their groups. */
+static MPFR_THREAD_ATTR mpfr_limb_ptr arena_base = NULL;
+static MPFR_THREAD_ATTR mp_size_t arena_size = 0;
+static MPFR_THREAD_ATTR mp_size_t arena_top = 0;
+static MPFR_THREAD_ATTR mp_size_t arena_need = 0;
+
+mp_size_t
+mpfr_arena_mark (void)
+{
+  return arena_top;
+}
+
+/* Return n limbs from the arena, or NULL if they do not fit in it. */
+mpfr_limb_ptr
+mpfr_arena_alloc (mp_size_t n)
+{
+  mpfr_limb_ptr p;
+
+  MPFR_ASSERTD (n > 0);
+  MPFR_ASSERTD (arena_top <= arena_size);
+  if (MPFR_UNLIKELY (n > arena_size - arena_top))
+    {
+      mp_size_t need;
+
+      need = n > MPFR_ARENA_MAX_SIZE - arena_top ?
+        MPFR_ARENA_MAX_SIZE : arena_top + n;
+      if (need > arena_need)
+        arena_need = need;
+      if (arena_top != 0 || n > MPFR_ARENA_MAX_SIZE)
+        return NULL;
+    }
+  /* The arena is empty and smaller than needed so far (possibly by blocks
+     that did not fit above other ones): replace it by a larger one. */
+  if (MPFR_UNLIKELY (arena_top == 0 && arena_size < arena_need))
+    {
+      mp_size_t size = arena_size + arena_size / 2;
+
+      if (size < arena_need)
+        size = arena_need;
+      else if (size > MPFR_ARENA_MAX_SIZE)
+        size = MPFR_ARENA_MAX_SIZE;
+      if (arena_size != 0)
+        mpfr_free_func (arena_base, arena_size * MPFR_BYTES_PER_MP_LIMB);
+      arena_size = size;
+      arena_base = (mpfr_limb_ptr)
+        mpfr_allocate_func (arena_size * MPFR_BYTES_PER_MP_LIMB);
+    }
+  p = arena_base + arena_top;
+  arena_top += n;
+  return p;
+}
+
+/* Give back all the limbs taken since mpfr_arena_mark returned mark. */
+void
+mpfr_arena_release (mp_size_t mark)
+{
+  MPFR_ASSERTD (mark >= 0 && mark <= arena_top);
+  arena_top = mark;
+}
+
+#endif
+
+void
+mpfr_free_arena (void)
+{
+#if MPFR_ARENA_MAX_SIZE
+  /* The arena is not in use if this function is called from the
+     application, but let's not free limbs that may still be used. */
+  if (arena_top == 0 && arena_size != 0)
+    {
+      mpfr_free_func (arena_base, arena_size * MPFR_BYTES_PER_MP_LIMB);
+      arena_base = NULL;
+      arena_size = 0;
+    }
+  arena_need = 0;
+#endif
+}
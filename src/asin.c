@@ -101,7 +101,7 @@ mpfr_asin (mpfr_ptr asin, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       MPFR_ZIV_INIT (loop, prec);
       for (;;)
         {
-          mpfr_set_prec (xp, prec);
+          mpfr_ziv_set_prec (xp, prec);
           mpfr_sqr (xp, x, MPFR_RNDN);
           mpfr_ui_sub (xp, 1, xp, MPFR_RNDN);
           mpfr_sqrt (xp, xp, MPFR_RNDN);
@@ -104,7 +104,7 @@ mpfr_asinh (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       /* actualization of the precision */
       MPFR_ZIV_NEXT (loop, Nt);
-      mpfr_set_prec (t, Nt);
+      mpfr_ziv_set_prec (t, Nt);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -132,7 +132,7 @@ mpfr_atan2 (mpfr_ptr dest, mpfr_srcptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
                                       MPFR_PREC (dest), rnd_mode))
                     break;
                   MPFR_ZIV_NEXT (loop2, prec2);
-                  mpfr_set_prec (tmp2, prec2);
+                  mpfr_ziv_set_prec (tmp2, prec2);
                 }
               MPFR_ZIV_FREE (loop2);
               if (MPFR_IS_NEG (y))
@@ -235,7 +235,7 @@ mpfr_atan2 (mpfr_ptr dest, mpfr_srcptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
                                          rnd_mode)))
           break;
         MPFR_ZIV_NEXT (loop, prec);
-        mpfr_set_prec (tmp, prec);
+        mpfr_ziv_set_prec (tmp, prec);
       }
   else /* x < 0 */
     /*  Use sign(y)*(PI - atan (|y/x|)) */
@@ -263,8 +263,8 @@ mpfr_atan2 (mpfr_ptr dest, mpfr_srcptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
                                            rnd_mode)))
             break;
           MPFR_ZIV_NEXT (loop, prec);
-          mpfr_set_prec (tmp, prec);
-          mpfr_set_prec (pi, prec);
+          mpfr_ziv_set_prec (tmp, prec);
+          mpfr_ziv_set_prec (pi, prec);
         }
       mpfr_clear (pi);
     }
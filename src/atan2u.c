@@ -342,7 +342,7 @@ mpfr_atan2u (mpfr_ptr z, mpfr_srcptr y, mpfr_srcptr x, unsigned long u,
                                        MPFR_PREC (z), rnd_mode)))
         break;
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (tmp, prec);
+      mpfr_ziv_set_prec (tmp, prec);
     }
   MPFR_ZIV_FREE (loop);
   inex = mpfr_set (z, tmp, rnd_mode);
@@ -198,8 +198,8 @@ mpfr_atanh (mpfr_ptr y, mpfr_srcptr xt, mpfr_rnd_t rnd_mode)
 
       /* reactualisation of the precision */
       MPFR_ZIV_NEXT (loop, Nt);
-      mpfr_set_prec (t, Nt);
-      mpfr_set_prec (te, Nt);
+      mpfr_ziv_set_prec (t, Nt);
+      mpfr_ziv_set_prec (te, Nt);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -167,8 +167,8 @@ mpfr_atanu (mpfr_ptr y, mpfr_srcptr x, unsigned long u, mpfr_rnd_t rnd_mode)
                                        MPFR_PREC (y), rnd_mode)))
         break;
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (tmp, prec);
-      mpfr_set_prec (pi, prec);
+      mpfr_ziv_set_prec (tmp, prec);
+      mpfr_ziv_set_prec (pi, prec);
     }
   MPFR_ZIV_FREE (loop);
 
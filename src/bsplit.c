@@ -0,0 +1,181 @@
+/* Binary splitting in several threads, for the constants.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* The mpz_t numbers of the states of the binary splittings are freed by
+   mpfr_free_cache, possibly after the mpz_t pool: they must not come from
+   it or go to it (see pool.c). */
+#define MPFR_POOL_DONT_REDEFINE
+#include "mpfr-impl.h"
+
+/* In a binary splitting, the two halves of a range of terms are computed
+   independently, then combined. A function doing a binary splitting on
+   n terms with the threads given by mpfr_bsplit_nthreads (n) calls
+   mpfr_bsplit_fork on its two halves as long as it has two threads or
+   more, giving a part of its threads to each half (the other half being
+   computed in a new thread). With a single thread, it continues
+   sequentially. Since the computations on integers are exact, the result
+   does not depend on the number of threads.
+
+   When the terms do not depend on the precision (for log(2) and Catalan's
+   constant, but not for Euler's constant), the cache of the constant keeps
+   the state of the binary splitting for the terms of index 0 to n-1, that
+   is, T, Q such that T/Q is the partial sum and the product P of the term
+   ratios, so that a higher precision only requires the computation of the
+   new terms, combined with the state by mpfr_bs_state_extend.
+
+   The halves must only do integer computations (no MPFR functions, whose
+   state such as the exponent range is thread-local). The new threads use
+   their own mpz_t pool, which is freed before they terminate. */
+
+/* minimum number of terms per thread */
+#ifndef MPFR_BSPLIT_PARALLEL_THRESHOLD
+# define MPFR_BSPLIT_PARALLEL_THRESHOLD 4096
+#endif
+
+/* maximum number of threads for the computation of a constant, which is
+   local to each thread, like the exponent range */
+static MPFR_THREAD_ATTR unsigned int const_nthreads = 1;
+
+void
+mpfr_set_const_nthreads (unsigned int n)
+{
+  const_nthreads = n == 0 ? 1 : n;
+}
+
+unsigned int
+mpfr_get_const_nthreads (void)
+{
+  return const_nthreads;
+}
+
+/* Return the number of threads to use for a binary splitting of n terms,
+   each one getting at least MPFR_BSPLIT_PARALLEL_THRESHOLD terms. */
+unsigned int
+mpfr_bsplit_nthreads (unsigned long n)
+{
+#ifdef MPFR_HAVE_THREADS
+  unsigned long k = n / MPFR_BSPLIT_PARALLEL_THRESHOLD;
+
+  return k == 0 ? 1 : k < const_nthreads ? (unsigned int) k : const_nthreads;
+#else
+  (void) n;
+  return 1;
+#endif
+}
+
+#ifdef MPFR_HAVE_THREADS
+
+typedef struct {
+  void (*f) (void *);
+  void *arg;
+} mpfr_bsplit_half_t;
+
+MPFR_THREAD_FUNC (bsplit_half, arg)
+{
+  mpfr_bsplit_half_t *h = (mpfr_bsplit_half_t *) arg;
+
+  h->f (h->arg);
+  mpfr_free_pool ();
+  MPFR_THREAD_RETURN;
+}
+
+#endif
+
+/* Call f (a) and f (b), the latter in a new thread if possible. */
+void
+mpfr_bsplit_fork (void (*f) (void *), void *a, void *b)
+{
+#ifdef MPFR_HAVE_THREADS
+  mpfr_bsplit_half_t h;
+  MPFR_THREAD_T thr;
+  int started;
+
+  h.f = f;
+  h.arg = b;
+  started = MPFR_THREAD_CREATE (thr, bsplit_half, &h);
+  f (a);
+  if (started)
+    MPFR_THREAD_JOIN (thr);
+  else
+    f (b);
+#else
+  f (a);
+  f (b);
+#endif
+}
+
+/* Return a new state, for no terms. */
+mpfr_bs_state_t *
+mpfr_bs_state_init (void)
+{
+  mpfr_bs_state_t *s;
+
+  s = (mpfr_bs_state_t *) mpfr_allocate_func (sizeof (mpfr_bs_state_t));
+  s->n = 0;
+  mpz_init (s->T);
+  mpz_init_set_ui (s->P, 1);
+  mpz_init_set_ui (s->Q, 1);
+  return s;
+}
+
+void
+mpfr_bs_state_clear (mpfr_bs_state_t *s)
+{
+  mpz_clear (s->T);
+  mpz_clear (s->P);
+  mpz_clear (s->Q);
+  mpfr_free_func (s, sizeof (mpfr_bs_state_t));
+}
+
+/* Extend the state s to the terms of index 0 to n-1, where T, P, Q are the
+   values for the terms of index s->n to n-1 (T is modified). */
+void
+mpfr_bs_state_extend (mpfr_bs_state_t *s, mpz_t T, mpz_t P, mpz_t Q,
+                      unsigned long n)
+{
+  mp_bitcnt_t v, w;
+
+  MPFR_ASSERTD (n > s->n);
+  mpz_mul (s->T, s->T, Q);
+  mpz_mul (T, T, s->P);
+  mpz_add (s->T, s->T, T);
+  mpz_mul (s->P, s->P, P);
+  mpz_mul (s->Q, s->Q, Q);
+  s->n = n;
+
+  /* remove common trailing zeros if any */
+  v = mpz_scan1 (s->T, 0);
+  if (v > 0)
+    {
+      w = mpz_scan1 (s->Q, 0);
+      if (w < v)
+        v = w;
+      w = mpz_scan1 (s->P, 0);
+      if (w < v)
+        v = w;
+      if (v > 0)
+        {
+          mpz_fdiv_q_2exp (s->T, s->T, v);
+          mpz_fdiv_q_2exp (s->Q, s->Q, v);
+          mpz_fdiv_q_2exp (s->P, s->P, v);
+        }
+    }
+}
@@ -93,6 +93,31 @@ mpfr_buildopt_sharedcache_p (void)
 #endif
 }
 
+int
+mpfr_buildopt_parallel_p (void)
+{
+#ifdef MPFR_WANT_PARALLEL
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+/* The variant of the functions with MPFR_FMV_FUNCTION_ATTR (see
+   mpfr-impl.h) that has been selected for the processor, with the same
+   priorities as the resolvers generated by the compiler. */
+const char *
+mpfr_buildopt_fmv_variant (void)
+{
+#ifdef MPFR_WANT_FMV
+  if (__builtin_cpu_supports ("x86-64-v3"))
+    return "x86-64-v3";
+  if (__builtin_cpu_supports ("x86-64-v2"))
+    return "x86-64-v2";
+#endif
+  return "default";
+}
+
 const char *mpfr_buildopt_tune_case (void)
 {
   /* MPFR_TUNE_CASE is always defined (can be "default"). */
@@ -27,24 +27,128 @@ If not, see <https://www.gnu.org/licenses/>. */
 void
 mpfr_init_cache (mpfr_cache_t cache, int (*func)(mpfr_ptr, mpfr_rnd_t))
 {
-  MPFR_PREC (cache->x) = 0; /* Invalid prec to detect that the cache is not
-                               valid. Maybe add a flag? */
+  cache->val = NULL;
   cache->func = func;
+  cache->func_bs = NULL;
+  cache->bs = NULL;
 }
 #endif
 
+/* The value of a cache is a pointer to an immutable mpfr_cache_val_t,
+   which is replaced by a new one (in a write lock) when more precision is
+   needed. With a thread-local cache, the old value is freed immediately.
+   With a shared cache:
+
+   * If MPFR_CACHE_LOCK_FREE is defined, a reader does not take the lock:
+     it registers itself in the readers counter of its slot for the current
+     epoch parity, loads the value (and can then use it safely), and
+     unregisters itself once the value has been rounded. A writer publishes
+     the new value, then waits for a grace period before freeing the old
+     one, like with SRCU: the epoch is incremented twice, and after each
+     increment, the writer waits until the readers counters of the previous
+     parity are all zero. A reader that may have loaded the old value has
+     registered itself before this load, thus before the new value has
+     been published, so that it is waited for at one of the two steps.
+     All these atomic operations are sequentially consistent.
+
+   * Otherwise, the readers take the lock in read mode. Since the readers
+     and the writers are mutually exclusive, the old value can be freed
+     immediately. */
+
+#ifdef MPFR_CACHE_LOCK_FREE
+
+/* slot of the current thread plus 1 (0 if not assigned yet); the slots
+   are assigned in a round-robin way */
+static MPFR_THREAD_ATTR unsigned int cache_slot;
+static unsigned int cache_next_slot;
+
+static unsigned int
+cache_get_slot (void)
+{
+  if (MPFR_UNLIKELY (cache_slot == 0))
+    cache_slot = 1 + __atomic_fetch_add (&cache_next_slot, 1,
+                                         __ATOMIC_RELAXED)
+      % MPFR_CACHE_SLOTS;
+  return cache_slot - 1;
+}
+
+# define CACHE_READ_DECL unsigned int _slot, _parity;
+# define CACHE_READ_BEGIN(c)                                            \
+  do {                                                                  \
+    _slot = cache_get_slot ();                                          \
+    _parity = __atomic_load_n (&(c)->epoch, __ATOMIC_SEQ_CST) & 1;      \
+    __atomic_fetch_add (&(c)->readers[_parity][_slot].n, 1,             \
+                        __ATOMIC_SEQ_CST);                              \
+  } while (0)
+# define CACHE_READ_END(c)                                              \
+  __atomic_fetch_sub (&(c)->readers[_parity][_slot].n, 1, __ATOMIC_SEQ_CST)
+# define CACHE_LOAD(c) __atomic_load_n (&(c)->val, __ATOMIC_SEQ_CST)
+# define CACHE_STORE(c,v) __atomic_store_n (&(c)->val, (v), __ATOMIC_SEQ_CST)
+
+/* Wait until no readers may use a value that has just been replaced. */
+static void
+cache_synchronize (mpfr_cache_ptr cache)
+{
+  int k, i;
+
+  for (k = 0; k < 2; k++)
+    {
+      unsigned int parity =
+        __atomic_fetch_add (&cache->epoch, 1, __ATOMIC_SEQ_CST) & 1;
+
+      for (;;)
+        {
+          unsigned long n = 0;
+
+          for (i = 0; i < MPFR_CACHE_SLOTS; i++)
+            n += __atomic_load_n (&cache->readers[parity][i].n,
+                                  __ATOMIC_SEQ_CST);
+          if (n == 0)
+            break;
+          MPFR_LOCK_YIELD ();
+        }
+    }
+}
+
+#else
+
+# define CACHE_READ_DECL
+# define CACHE_READ_BEGIN(c) MPFR_LOCK_READ((c)->lock)
+# define CACHE_READ_END(c) MPFR_UNLOCK_READ((c)->lock)
+# define CACHE_LOAD(c) ((c)->val)
+# define CACHE_STORE(c,v) ((void) ((c)->val = (v)))
+# define cache_synchronize(c) ((void) 0)
+
+#endif
+
+static void
+cache_free_val (mpfr_cache_val_t *v)
+{
+  mpfr_clear (v->x);
+  mpfr_free_func (v, sizeof (mpfr_cache_val_t));
+}
+
 void
 mpfr_clear_cache (mpfr_cache_t cache)
 {
-  if (MPFR_UNLIKELY (MPFR_PREC (cache->x) != 0))
+  if (MPFR_UNLIKELY (CACHE_LOAD (cache) != NULL))
     {
+      mpfr_cache_val_t *v;
+
       /* Get the cache in read-write mode */
       MPFR_LOCK_WRITE(cache->lock);
 
-      if (MPFR_LIKELY (MPFR_PREC (cache->x) != 0))
+      v = cache->val;
+      if (MPFR_LIKELY (v != NULL))
+        {
+          CACHE_STORE (cache, NULL);
+          cache_synchronize (cache);
+          cache_free_val (v);
+        }
+      if (cache->bs != NULL)
         {
-          mpfr_clear (cache->x);
-          MPFR_PREC (cache->x) = 0;
+          mpfr_bs_state_clear (cache->bs);
+          cache->bs = NULL;
         }
 
       /* Free the cache in read-write mode */
@@ -52,12 +156,126 @@ mpfr_clear_cache (mpfr_cache_t cache)
     }
 }
 
+/* Publish the new value v of the cache, and free the old value old (which
+   may be NULL). This must be called with the write lock. */
+static void
+cache_replace (mpfr_cache_ptr cache, mpfr_cache_val_t *v,
+               mpfr_cache_val_t *old)
+{
+  CACHE_STORE (cache, v);
+  if (old != NULL)
+    {
+      cache_synchronize (cache);
+      cache_free_val (old);
+    }
+}
+
+/* Replace the value of the cache by a value of precision at least dprec.
+   This must be called without being registered as a reader. */
+static void
+cache_update (mpfr_cache_ptr cache, mpfr_prec_t dprec)
+{
+  mpfr_cache_val_t *v, *old;
+  mpfr_prec_t cprec;
+
+  /* Get the cache in read-write mode */
+  MPFR_LOCK_WRITE(cache->lock);
+
+  /* Retest the precision once we get the lock (since it might have
+     changed). If there is no lock, there is no harm in this code. */
+  old = cache->val;
+  if (MPFR_LIKELY (old == NULL || MPFR_PREC (old->x) < dprec))
+    {
+      /* No previous result in the cache or the precision of the
+         previous result is not sufficient. */
+      if (MPFR_UNLIKELY (old == NULL))  /* No previous result. */
+        cprec = dprec;
+      else
+        {
+          /* We increase the cache size by at least 10% to avoid
+             invalidating the cache many times if one performs
+             several computations with small increase of precision. */
+          cprec = MPFR_PREC (old->x);
+          cprec += cprec / 10;
+          if (cprec < dprec)
+            cprec = dprec;
+        }
+
+      v = (mpfr_cache_val_t *) mpfr_allocate_func (sizeof (mpfr_cache_val_t));
+      mpfr_init2 (v->x, cprec);
+      /* The state of a binary splitting is only used here, with the
+         lock. */
+      v->inexact = cache->func_bs != NULL ?
+        (*cache->func_bs) (v->x, MPFR_RNDN, &cache->bs) :
+        (*cache->func) (v->x, MPFR_RNDN);
+      cache_replace (cache, v, old);
+    }
+
+  /* Free the cache in read-write mode */
+  MPFR_UNLOCK_WRITE(cache->lock);
+}
+
+/* Set x to the value of the cache, with its precision, and return the
+   associated ternary value, or 2 if the cache is empty (x is unchanged).
+   This is used to save the cache contents (see fpif.c). */
+int
+mpfr_cache_get_value (mpfr_ptr x, mpfr_cache_t cache)
+{
+  mpfr_cache_val_t *v;
+  int inexact = 2;
+  CACHE_READ_DECL
+
+  MPFR_DEFERRED_INIT_CALL(cache);
+
+  CACHE_READ_BEGIN (cache);
+  v = CACHE_LOAD (cache);
+  if (v != NULL)
+    {
+      mpfr_set_prec (x, MPFR_PREC (v->x));
+      mpfr_set (x, v->x, MPFR_RNDN);  /* exact */
+      inexact = v->inexact;
+    }
+  CACHE_READ_END (cache);
+
+  return inexact;
+}
+
+/* Use x, whose ternary value with respect to the constant is inexact, as
+   the value of the cache, unless the cache already has a value with at
+   least the same precision. This is used to load the cache contents (see
+   fpif.c), x having been checked by the caller. */
+void
+mpfr_cache_set_value (mpfr_cache_t cache, mpfr_srcptr x, int inexact)
+{
+  mpfr_cache_val_t *v, *old;
+
+  MPFR_ASSERTN (MPFR_IS_POS (x) && MPFR_IS_PURE_FP (x));
+
+  MPFR_DEFERRED_INIT_CALL(cache);
+
+  MPFR_LOCK_WRITE(cache->lock);
+
+  old = cache->val;
+  if (old == NULL || MPFR_PREC (old->x) < MPFR_PREC (x))
+    {
+      v = (mpfr_cache_val_t *) mpfr_allocate_func (sizeof (mpfr_cache_val_t));
+      mpfr_init2 (v->x, MPFR_PREC (x));
+      mpfr_set (v->x, x, MPFR_RNDN);  /* exact */
+      v->inexact = inexact;
+      cache_replace (cache, v, old);
+    }
+
+  MPFR_UNLOCK_WRITE(cache->lock);
+}
+
 int
 mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 {
   mpfr_prec_t dprec = MPFR_PREC (dest);
   mpfr_prec_t cprec;  /* precision of the cache */
+  mpfr_cache_val_t *v;
   int inexact, sign;
+  CACHE_READ_DECL
   MPFR_SAVE_EXPO_DECL (expo);
 
   /* Call the initialisation function of the cache if it's needed */
@@ -65,70 +283,41 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 
   MPFR_SAVE_EXPO_MARK (expo);
 
-  /* Get the cache in read-only mode */
-  MPFR_LOCK_READ(cache->lock);
-  /* Read the precision within the cache */
-  cprec = MPFR_PREC (cache->x);
-  if (MPFR_UNLIKELY (dprec > cprec))
+  /* Get the cache in read-only mode, and update it if need be (which
+     requires to leave the read-only mode first, and it may even be
+     cleared by another thread in the mean time). */
+  for (;;)
     {
-      /* Free the cache in read-only mode */
-      /* And get the cache in read-write mode */
-      MPFR_LOCK_READ2WRITE(cache->lock);
-
-      /* Retest the precision once we get the lock (since it might have
-         changed). If there is no lock, there is no harm in this code. */
-      cprec = MPFR_PREC (cache->x);
-      if (MPFR_LIKELY (dprec > cprec))
-        {
-          /* No previous result in the cache or the precision of the
-             previous result is not sufficient. */
-          if (MPFR_UNLIKELY (cprec == 0))  /* No previous result. */
-            {
-              cprec = dprec;
-              mpfr_init2 (cache->x, cprec);
-            }
-          else
-            {
-              /* We increase the cache size by at least 10% to avoid
-                 invalidating the cache many times if one performs
-                 several computations with small increase of precision. */
-              cprec += cprec / 10;
-              if (cprec < dprec)
-                cprec = dprec;
-              /* no need to keep the previous value */
-              mpfr_set_prec (cache->x, cprec);
-            }
-
-          cache->inexact = (*cache->func) (cache->x, MPFR_RNDN);
-        }
-
-      /* Free the cache in read-write mode */
-      /* Get the cache in read-only mode */
-      MPFR_LOCK_WRITE2READ(cache->lock);
+      CACHE_READ_BEGIN (cache);
+      v = CACHE_LOAD (cache);
+      if (MPFR_LIKELY (v != NULL && MPFR_PREC (v->x) >= dprec))
+        break;
+      CACHE_READ_END (cache);
+      cache_update (cache, dprec);
     }
 
-  /* now cprec >= dprec is the precision of cache->x */
+  /* now cprec >= dprec is the precision of v->x */
+  cprec = MPFR_PREC (v->x);
   MPFR_ASSERTD (cprec >= dprec);
-  MPFR_ASSERTD (MPFR_PREC (cache->x) == cprec);
 
   /* First, check if the cache has the exact value (unlikely).
-     Else the exact value is between (assuming x=cache->x > 0):
-       x and x+ulp(x) if cache->inexact < 0,
-       x-ulp(x) and x if cache->inexact > 0,
+     Else the exact value is between (assuming x=v->x > 0):
+       x and x+ulp(x) if v->inexact < 0,
+       x-ulp(x) and x if v->inexact > 0,
      and abs(x-exact) <= ulp(x)/2. */
 
   /* we assume all cached constants are positive */
-  MPFR_ASSERTN (MPFR_IS_POS (cache->x)); /* TODO... */
-  sign = MPFR_SIGN (cache->x);
-  MPFR_EXP (dest) = MPFR_GET_EXP (cache->x);
+  MPFR_ASSERTN (MPFR_IS_POS (v->x)); /* TODO... */
+  sign = MPFR_SIGN (v->x);
+  MPFR_EXP (dest) = MPFR_GET_EXP (v->x);
   MPFR_SET_SIGN (dest, sign);
 
-  /* round cache->x from precision cprec down to precision dprec;
+  /* round v->x from precision cprec down to precision dprec;
      since we are in extended exponent range, for the values considered
      here, an overflow is not possible (and wouldn't make much sense). */
   MPFR_RNDRAW_GEN (inexact, dest,
-                   MPFR_MANT (cache->x), cprec, rnd, sign,
-                   if (MPFR_UNLIKELY (cache->inexact == 0))
+                   MPFR_MANT (v->x), cprec, rnd, sign,
+                   if (MPFR_UNLIKELY (v->inexact == 0))
                      {
                        if ((_sp[0] & _ulp) == 0)
                          {
@@ -138,9 +327,9 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
                        else
                          goto addoneulp;
                      }
-                   else if (cache->inexact < 0)
+                   else if (v->inexact < 0)
                      goto addoneulp;
-                   else /* cache->inexact > 0 */
+                   else /* v->inexact > 0 */
                      {
                        inexact = -sign;
                        goto trunc_doit;
@@ -151,7 +340,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
 
   /* Rather a likely, this is a 100% success rate for
      all constants of MPFR */
-  if (MPFR_LIKELY (cache->inexact != 0))
+  if (MPFR_LIKELY (v->inexact != 0))
     {
       switch (rnd)
         {
@@ -159,7 +348,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
         case MPFR_RNDD:
           if (MPFR_UNLIKELY (inexact == 0))
             {
-              inexact = cache->inexact;
+              inexact = v->inexact;
               if (inexact > 0)
                 {
                   mpfr_nextbelow (dest);
@@ -171,7 +360,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
         case MPFR_RNDA:
           if (MPFR_UNLIKELY (inexact == 0))
             {
-              inexact = cache->inexact;
+              inexact = v->inexact;
               if (inexact < 0)
                 {
                   mpfr_nextabove (dest);
@@ -181,7 +370,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
           break;
         default: /* MPFR_RNDN */
           if (MPFR_UNLIKELY(inexact == 0))
-            inexact = cache->inexact;
+            inexact = v->inexact;
           break;
         }
     }
@@ -189,7 +378,7 @@ mpfr_cache (mpfr_ptr dest, mpfr_cache_t cache, mpfr_rnd_t rnd)
   MPFR_SAVE_EXPO_FREE (expo);
 
   /* Free the cache in read-only mode */
-  MPFR_UNLOCK_READ(cache->lock);
+  CACHE_READ_END (cache);
 
   return mpfr_check_range (dest, inexact, rnd);
 }
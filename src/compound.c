@@ -353,10 +353,10 @@ mpfr_compound_si (mpfr_ptr y, mpfr_srcptr x, long n, mpfr_rnd_t rnd_mode)
         }
 
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (t, prec);
+      mpfr_ziv_set_prec (t, prec);
       MPFR_ASSERTN (e2 <= MPFR_PREC_MAX);
       extra = e2 > 0 ? e2 : 0;
-      mpfr_set_prec (u, MPFR_ADD_PREC (prec, extra));
+      mpfr_ziv_set_prec (u, MPFR_ADD_PREC (prec, extra));
     }
 
   inexact = mpfr_set (y, t, rnd_mode);
@@ -685,9 +685,9 @@ mpfr_compound (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
         }
 
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (t, prec);
+      mpfr_ziv_set_prec (t, prec);
       extra = new_extra;
-      mpfr_set_prec (u, MPFR_ADD_PREC (prec, extra));
+      mpfr_ziv_set_prec (u, MPFR_ADD_PREC (prec, extra));
     }
 
   inexact = mpfr_set (z, t, rnd_mode);
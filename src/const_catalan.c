@@ -22,8 +22,11 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
+static int mpfr_const_catalan_bs (mpfr_ptr, mpfr_rnd_t, mpfr_bs_state_t **);
+
 /* Declare the cache */
-MPFR_DECL_INIT_CACHE (__gmpfr_cache_const_catalan, mpfr_const_catalan_internal)
+MPFR_DECL_INIT_CACHE_BS (__gmpfr_cache_const_catalan,
+                         mpfr_const_catalan_internal, mpfr_const_catalan_bs)
 
 /* Set User Interface */
 #undef mpfr_const_catalan
@@ -32,9 +35,30 @@ mpfr_const_catalan (mpfr_ptr x, mpfr_rnd_t rnd_mode) {
   return mpfr_cache (x, __gmpfr_cache_const_catalan, rnd_mode);
 }
 
-/* return T, Q such that T/Q = sum(k!^2/(2k)!/(2k+1)^2, k=n1..n2-1) */
+static void S (mpz_t, mpz_t, mpz_t, unsigned long, unsigned long,
+               unsigned int);
+
+/* arguments of S for mpfr_bsplit_fork */
+typedef struct
+{
+  mpz_ptr T, P, Q;
+  unsigned long n1, n2;
+  unsigned int nthr;
+} S_args;
+
 static void
-S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
+S_half (void *arg)
+{
+  S_args *a = (S_args *) arg;
+
+  S (a->T, a->P, a->Q, a->n1, a->n2, a->nthr);
+}
+
+/* return T, Q such that T/Q = sum(k!^2/(2k)!/(2k+1)^2, k=n1..n2-1),
+   the halves being computed in parallel when nthr >= 2 (see bsplit.c) */
+static void
+S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2,
+   unsigned int nthr)
 {
   if (n2 == n1 + 1)
     {
@@ -56,11 +80,32 @@ S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
     {
       unsigned long m = (n1 + n2) / 2;
       mpz_t T2, P2, Q2;
-      S (T, P, Q, n1, m);
       mpz_init (T2);
       mpz_init (P2);
       mpz_init (Q2);
-      S (T2, P2, Q2, m, n2);
+      if (nthr >= 2)
+        {
+          S_args a, b;
+
+          a.T = T;
+          a.P = P;
+          a.Q = Q;
+          a.n1 = n1;
+          a.n2 = m;
+          a.nthr = nthr - nthr / 2;
+          b.T = T2;
+          b.P = P2;
+          b.Q = Q2;
+          b.n1 = m;
+          b.n2 = n2;
+          b.nthr = nthr / 2;
+          mpfr_bsplit_fork (S_half, &a, &b);
+        }
+      else
+        {
+          S (T, P, Q, n1, m, 1);
+          S (T2, P2, Q2, m, n2, 1);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
@@ -79,13 +124,17 @@ S (mpz_t T, mpz_t P, mpz_t Q, unsigned long n1, unsigned long n2)
    https://web.archive.org/web/20090624123133/http://www-2.cs.cmu.edu/~adamchik/articles/catalan/catalan.htm
 
    G = Pi/8*log(2+sqrt(3)) + 3/8*sum(k!^2/(2k)!/(2k+1)^2,k=0..infinity)
+
+   The binary splitting state *s (allocated if NULL) of the sum is extended
+   to the number of terms needed for the precision of g (see bsplit.c).
 */
-int
-mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
+static int
+mpfr_const_catalan_bs (mpfr_ptr g, mpfr_rnd_t rnd_mode, mpfr_bs_state_t **s)
 {
   mpfr_t x, y, z;
   mpz_t T, P, Q;
   mpfr_prec_t pg, p;
+  unsigned long N;
   int inex;
   MPFR_ZIV_DECL (loop);
   MPFR_GROUP_DECL (group);
@@ -115,6 +164,9 @@ mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
   pg = MPFR_PREC (g);
   p = pg + MPFR_INT_CEIL_LOG2 (pg) + 7;
 
+  if (*s == NULL)
+    *s = mpfr_bs_state_init ();
+
   MPFR_GROUP_INIT_3 (group, p, x, y, z);
   mpz_init (T);
   mpz_init (P);
@@ -127,10 +179,16 @@ mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
     mpfr_log (x, x, MPFR_RNDU);
     mpfr_const_pi (y, MPFR_RNDU);
     mpfr_mul (x, x, y, MPFR_RNDN);
-    S (T, P, Q, 0, (p - 1) / 2);
-    mpz_mul_ui (T, T, 3);
+    /* If the state has more terms than N, the error is even smaller. */
+    N = (p - 1) / 2;
+    if ((*s)->n < N)
+      {
+        S (T, P, Q, (*s)->n, N, mpfr_bsplit_nthreads (N - (*s)->n));
+        mpfr_bs_state_extend (*s, T, P, Q, N);
+      }
+    mpz_mul_ui (T, (*s)->T, 3);
     mpfr_set_z (y, T, MPFR_RNDU);
-    mpfr_set_z (z, Q, MPFR_RNDD);
+    mpfr_set_z (z, (*s)->Q, MPFR_RNDD);
     mpfr_div (y, y, z, MPFR_RNDN);
     mpfr_add (x, x, y, MPFR_RNDN);
     mpfr_div_2ui (x, x, 3, MPFR_RNDN);
@@ -151,3 +209,14 @@ mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
 
   return inex;
 }
+
+int
+mpfr_const_catalan_internal (mpfr_ptr g, mpfr_rnd_t rnd_mode)
+{
+  mpfr_bs_state_t *s = NULL;
+  int inex;
+
+  inex = mpfr_const_catalan_bs (g, rnd_mode, &s);
+  mpfr_bs_state_clear (s);
+  return inex;
+}
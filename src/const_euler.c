@@ -70,10 +70,44 @@ mpfr_const_euler_bs_clear (mpfr_const_euler_bs_t s)
   mpz_clear (s->V);
 }
 
+/* arguments of mpfr_const_euler_bs_1 or mpfr_const_euler_bs_2 for
+   mpfr_bsplit_fork */
+typedef struct
+{
+  mpz_ptr P, Q, T;
+  mpfr_const_euler_bs_struct *s;
+  unsigned long n1, n2, N;
+  unsigned int nthr;
+} mpfr_const_euler_bs_args;
+
+static void mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t, unsigned long,
+                                   unsigned long, unsigned long, int,
+                                   unsigned int);
+static void mpfr_const_euler_bs_2 (mpz_t, mpz_t, mpz_t, unsigned long,
+                                   unsigned long, unsigned long, int,
+                                   unsigned int);
+
+static void
+mpfr_const_euler_bs_1_half (void *arg)
+{
+  mpfr_const_euler_bs_args *a = (mpfr_const_euler_bs_args *) arg;
+
+  mpfr_const_euler_bs_1 (a->s, a->n1, a->n2, a->N, 1, a->nthr);
+}
+
+static void
+mpfr_const_euler_bs_2_half (void *arg)
+{
+  mpfr_const_euler_bs_args *a = (mpfr_const_euler_bs_args *) arg;
+
+  mpfr_const_euler_bs_2 (a->P, a->Q, a->T, a->n1, a->n2, a->N, 1, a->nthr);
+}
+
+/* The halves are computed in parallel when nthr >= 2 (see bsplit.c). */
 static void
 mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
                        unsigned long n1, unsigned long n2, unsigned long N,
-                       int cont)
+                       int cont, unsigned int nthr)
 {
   if (n2 - n1 == 1)
     {
@@ -94,8 +128,27 @@ mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
 
       mpfr_const_euler_bs_init (L);
       mpfr_const_euler_bs_init (R);
-      mpfr_const_euler_bs_1 (L, n1, m, N, 1);
-      mpfr_const_euler_bs_1 (R, m, n2, N, 1);
+      if (nthr >= 2)
+        {
+          mpfr_const_euler_bs_args a, b;
+
+          a.s = L;
+          a.n1 = n1;
+          a.n2 = m;
+          a.N = N;
+          a.nthr = nthr - nthr / 2;
+          b.s = R;
+          b.n1 = m;
+          b.n2 = n2;
+          b.N = N;
+          b.nthr = nthr / 2;
+          mpfr_bsplit_fork (mpfr_const_euler_bs_1_half, &a, &b);
+        }
+      else
+        {
+          mpfr_const_euler_bs_1 (L, n1, m, N, 1, 1);
+          mpfr_const_euler_bs_1 (R, m, n2, N, 1, 1);
+        }
 
       mpz_init (t);
       mpz_init (u);
@@ -138,7 +191,7 @@ mpfr_const_euler_bs_1 (mpfr_const_euler_bs_t s,
 static void
 mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
                        unsigned long n1, unsigned long n2, unsigned long N,
-                       int cont)
+                       int cont, unsigned int nthr)
 {
   if (n2 - n1 == 1)
     {
@@ -165,8 +218,31 @@ mpfr_const_euler_bs_2 (mpz_t P, mpz_t Q, mpz_t T,
       mpz_init (P2);
       mpz_init (Q2);
       mpz_init (T2);
-      mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1);
-      mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1);
+      if (nthr >= 2)
+        {
+          mpfr_const_euler_bs_args a, b;
+
+          a.P = P;
+          a.Q = Q;
+          a.T = T;
+          a.n1 = n1;
+          a.n2 = m;
+          a.N = N;
+          a.nthr = nthr - nthr / 2;
+          b.P = P2;
+          b.Q = Q2;
+          b.T = T2;
+          b.n1 = m;
+          b.n2 = n2;
+          b.N = N;
+          b.nthr = nthr / 2;
+          mpfr_bsplit_fork (mpfr_const_euler_bs_2_half, &a, &b);
+        }
+      else
+        {
+          mpfr_const_euler_bs_2 (P, Q, T, n1, m, N, 1, 1);
+          mpfr_const_euler_bs_2 (P2, Q2, T2, m, n2, N, 1, 1);
+        }
       mpz_mul (T, T, Q2);
       mpz_mul (T2, T2, P);
       mpz_add (T, T, T2);
@@ -222,7 +298,7 @@ mpfr_const_euler_internal (mpfr_ptr x, mpfr_rnd_t rnd)
       /* V / ((T + Q) * D) = S / I
          where S = sum_{k=0}^{N-1} H_k n^(2k) / (k!)^2,
                I = sum_{k=0}^{N-1} n^(2k) / (k!)^2 */
-      mpfr_const_euler_bs_1 (sum, 0, N, n, 0);
+      mpfr_const_euler_bs_1 (sum, 0, N, n, 0, mpfr_bsplit_nthreads (N));
       mpz_add (sum->T, sum->T, sum->Q);
       mpz_mul (t, sum->T, sum->D);
       mpz_mul_2exp (u, sum->V, wp);
@@ -231,7 +307,8 @@ mpfr_const_euler_internal (mpfr_ptr x, mpfr_rnd_t rnd)
 
       /* C / (D * V) = U where
          U = (1/(4n)) sum_{k=0}^{2n-1} [(2k)!]^3 / ((k!)^4 8^(2k) (2n)^(2k)) */
-      mpfr_const_euler_bs_2 (sum->C, sum->D, sum->V, 0, 2*n, n, 0);
+      mpfr_const_euler_bs_2 (sum->C, sum->D, sum->V, 0, 2*n, n, 0,
+                             mpfr_bsplit_nthreads (2*n));
       mpz_mul (t, sum->Q, sum->Q);
       mpz_mul (t, t, sum->V);
       mpz_mul (u, sum->T, sum->T);
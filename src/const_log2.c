@@ -22,12 +22,17 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
+static int mpfr_const_log2_bs (mpfr_ptr, mpfr_rnd_t, mpfr_bs_state_t **);
+
 /* Declare the cache */
 #ifndef MPFR_USE_LOGGING
-MPFR_DECL_INIT_CACHE (__gmpfr_cache_const_log2, mpfr_const_log2_internal)
+MPFR_DECL_INIT_CACHE_BS (__gmpfr_cache_const_log2, mpfr_const_log2_internal,
+                         mpfr_const_log2_bs)
 #else
-MPFR_DECL_INIT_CACHE (__gmpfr_normal_log2, mpfr_const_log2_internal)
-MPFR_DECL_INIT_CACHE (__gmpfr_logging_log2, mpfr_const_log2_internal)
+MPFR_DECL_INIT_CACHE_BS (__gmpfr_normal_log2, mpfr_const_log2_internal,
+                         mpfr_const_log2_bs)
+MPFR_DECL_INIT_CACHE_BS (__gmpfr_logging_log2, mpfr_const_log2_internal,
+                         mpfr_const_log2_bs)
 MPFR_THREAD_VAR (mpfr_cache_ptr, __gmpfr_cache_const_log2, __gmpfr_normal_log2)
 #endif
 
@@ -38,14 +43,36 @@ mpfr_const_log2 (mpfr_ptr x, mpfr_rnd_t rnd_mode) {
   return mpfr_cache (x, __gmpfr_cache_const_log2, rnd_mode);
 }
 
+static void S (mpz_t *, mpz_t *, mpz_t *, unsigned long, unsigned long, int,
+               unsigned int);
+
+/* arguments of S for mpfr_bsplit_fork */
+typedef struct
+{
+  mpz_t *T, *P, *Q;
+  unsigned long n1, n2;
+  int need_P;
+  unsigned int nthr;
+} S_args;
+
+static void
+S_half (void *arg)
+{
+  S_args *a = (S_args *) arg;
+
+  S (a->T, a->P, a->Q, a->n1, a->n2, a->need_P, a->nthr);
+}
+
 /* Auxiliary function: Compute the terms from n1 to n2 (excluded)
    3/4*sum((-1)^n*n!^2/2^n/(2*n+1)!, n = n1..n2-1).
    Numerator is T[0], denominator is Q[0],
    Compute P[0] only when need_P is non-zero.
    Need 1+ceil(log(n2-n1)/log(2)) cells in T[],P[],Q[].
+   The halves are computed in parallel when nthr >= 2 (see bsplit.c).
 */
 static void
-S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P)
+S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2,
+   int need_P, unsigned int nthr)
 {
   if (n2 == n1 + 1)
     {
@@ -69,8 +96,45 @@ S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P)
       unsigned long m = (n1 / 2) + (n2 / 2) + (n1 & 1UL & n2);
       mp_bitcnt_t v, w;
 
-      S (T, P, Q, n1, m, 1);
-      S (T + 1, P + 1, Q + 1, m, n2, need_P);
+      if (nthr >= 2)
+        {
+          /* The cells from index 1 are used by both halves, thus the
+             right half gets its own cells, and its result is then moved
+             to the cells of index 1. */
+          unsigned long lg = MPFR_INT_CEIL_LOG2 (n2 - m) + 1, i;
+          mpz_t *R;
+          S_args a, b;
+
+          R = (mpz_t *) mpfr_allocate_func (3 * lg * sizeof (mpz_t));
+          for (i = 0; i < 3 * lg; i++)
+            mpz_init (R[i]);
+          a.T = T;
+          a.P = P;
+          a.Q = Q;
+          a.n1 = n1;
+          a.n2 = m;
+          a.need_P = 1;
+          a.nthr = nthr - nthr / 2;
+          b.T = R;
+          b.P = R + lg;
+          b.Q = R + 2 * lg;
+          b.n1 = m;
+          b.n2 = n2;
+          b.need_P = need_P;
+          b.nthr = nthr / 2;
+          mpfr_bsplit_fork (S_half, &a, &b);
+          mpz_swap (T[1], R[0]);
+          mpz_swap (P[1], R[lg]);
+          mpz_swap (Q[1], R[2 * lg]);
+          for (i = 0; i < 3 * lg; i++)
+            mpz_clear (R[i]);
+          mpfr_free_func (R, 3 * lg * sizeof (mpz_t));
+        }
+      else
+        {
+          S (T, P, Q, n1, m, 1, 1);
+          S (T + 1, P + 1, Q + 1, m, n2, need_P, 1);
+        }
       mpz_mul (T[0], T[0], Q[1]);
       mpz_mul (T[1], T[1], P[0]);
       mpz_add (T[0], T[0], T[1]);
@@ -103,9 +167,11 @@ S (mpz_t *T, mpz_t *P, mpz_t *Q, unsigned long n1, unsigned long n2, int need_P)
     }
 }
 
-/* Don't need to save / restore exponent range: the cache does it */
-int
-mpfr_const_log2_internal (mpfr_ptr x, mpfr_rnd_t rnd_mode)
+/* Don't need to save / restore exponent range: the cache does it.
+   The binary splitting state *s (allocated if NULL) is extended to the
+   number of terms needed for the precision of x (see bsplit.c). */
+static int
+mpfr_const_log2_bs (mpfr_ptr x, mpfr_rnd_t rnd_mode, mpfr_bs_state_t **s)
 {
   unsigned long n = MPFR_PREC (x);
   mpfr_prec_t w; /* working precision */
@@ -124,6 +190,9 @@ mpfr_const_log2_internal (mpfr_ptr x, mpfr_rnd_t rnd_mode)
 
   w = n + MPFR_INT_CEIL_LOG2 (n) + 3;
 
+  if (*s == NULL)
+    *s = mpfr_bs_state_init ();
+
   MPFR_TMP_MARK(marker);
   MPFR_GROUP_INIT_2(group, w, t, q);
 
@@ -135,30 +204,37 @@ mpfr_const_log2_internal (mpfr_ptr x, mpfr_rnd_t rnd_mode)
       /* the following are needed for error analysis (see algorithms.tex) */
       MPFR_ASSERTD(w >= 3 && N >= 2);
 
-      lgN = MPFR_INT_CEIL_LOG2 (N) + 1;
-      T  = (mpz_t *) MPFR_TMP_ALLOC (3 * lgN * sizeof (mpz_t));
-      P  = T + lgN;
-      Q  = T + 2*lgN;
-      for (i = 0; i < lgN; i++)
+      /* If the state has more terms than N, the error is even smaller. */
+      if ((*s)->n < N)
         {
-          mpz_init (T[i]);
-          mpz_init (P[i]);
-          mpz_init (Q[i]);
-        }
+          unsigned long n1 = (*s)->n;
 
-      S (T, P, Q, 0, N, 0);
+          lgN = MPFR_INT_CEIL_LOG2 (N - n1) + 1;
+          T  = (mpz_t *) MPFR_TMP_ALLOC (3 * lgN * sizeof (mpz_t));
+          P  = T + lgN;
+          Q  = T + 2*lgN;
+          for (i = 0; i < lgN; i++)
+            {
+              mpz_init (T[i]);
+              mpz_init (P[i]);
+              mpz_init (Q[i]);
+            }
 
-      mpfr_set_z (t, T[0], MPFR_RNDN);
-      mpfr_set_z (q, Q[0], MPFR_RNDN);
-      mpfr_div (t, t, q, MPFR_RNDN);
+          S (T, P, Q, n1, N, 1, mpfr_bsplit_nthreads (N - n1));
+          mpfr_bs_state_extend (*s, T[0], P[0], Q[0], N);
 
-      for (i = 0; i < lgN; i++)
-        {
-          mpz_clear (T[i]);
-          mpz_clear (P[i]);
-          mpz_clear (Q[i]);
+          for (i = 0; i < lgN; i++)
+            {
+              mpz_clear (T[i]);
+              mpz_clear (P[i]);
+              mpz_clear (Q[i]);
+            }
         }
 
+      mpfr_set_z (t, (*s)->T, MPFR_RNDN);
+      mpfr_set_z (q, (*s)->Q, MPFR_RNDN);
+      mpfr_div (t, t, q, MPFR_RNDN);
+
       if (MPFR_CAN_ROUND (t, w - 2, n, rnd_mode))
         break;
 
@@ -174,3 +250,14 @@ mpfr_const_log2_internal (mpfr_ptr x, mpfr_rnd_t rnd_mode)
 
   return inexact;
 }
+
+int
+mpfr_const_log2_internal (mpfr_ptr x, mpfr_rnd_t rnd_mode)
+{
+  mpfr_bs_state_t *s = NULL;
+  int inexact;
+
+  inexact = mpfr_const_log2_bs (x, rnd_mode, &s);
+  mpfr_bs_state_clear (s);
+  return inexact;
+}
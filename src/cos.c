@@ -58,9 +58,18 @@ mpfr_cos2_aux (mpfr_ptr f, mpfr_srcptr r)
       while (maxi * (maxi / 2) == 0);
     }
 
-  mpz_init (x);
-  mpz_init (s);
-  mpz_init (t);
+  p = mpfr_get_prec (f); /* same as r */
+  /* bound for number of iterations */
+  imax = p / (-mpfr_get_exp (r));
+  imax += (imax == 0);
+  q = 2 * MPFR_INT_CEIL_LOG2(imax) + 4; /* bound for (3l)^2 */
+
+  /* s and t have at most p + q + 1 bits, and t is multiplied by x: take
+     them large enough from the mpz_t pool, so that they do not need to be
+     reallocated */
+  mpz_init2 (x, p);
+  mpz_init2 (s, p + q + GMP_NUMB_BITS);
+  mpz_init2 (t, 2 * (p + q + GMP_NUMB_BITS));
   ex = mpfr_get_z_2exp (x, r); /* r = x*2^ex */
 
   /* Remove trailing zeros.
@@ -72,12 +81,6 @@ mpfr_cos2_aux (mpfr_ptr f, mpfr_srcptr r)
 
   /* since |r| < 1, r = x*2^ex, and x is an integer, necessarily ex < 0 */
 
-  p = mpfr_get_prec (f); /* same as r */
-  /* bound for number of iterations */
-  imax = p / (-mpfr_get_exp (r));
-  imax += (imax == 0);
-  q = 2 * MPFR_INT_CEIL_LOG2(imax) + 4; /* bound for (3l)^2 */
-
   mpz_set_ui (s, 1); /* initialize sum with 1 */
   mpz_mul_2exp (s, s, p + q); /* scale all values by 2^(p+q) */
   mpz_set (t, s); /* invariant: t is previous term */
@@ -280,8 +283,8 @@ mpfr_cos (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       MPFR_GROUP_REPREC_2 (group, m, r, s);
       if (reduce)
         {
-          mpfr_set_prec (xr, m);
-          mpfr_set_prec (c, expx + m - 1);
+          mpfr_ziv_set_prec (xr, m);
+          mpfr_ziv_set_prec (c, expx + m - 1);
         }
     }
   MPFR_ZIV_FREE (loop);
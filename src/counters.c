@@ -0,0 +1,147 @@
+/* Per-thread counters of the functions with a Ziv loop and of the memory
+   allocated by MPFR
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include "mpfr-impl.h"
+
+/* The counters of the functions with a Ziv loop are in thread-local
+   nodes declared by MPFR_ZIV_DECL, which are linked in a (thread-local)
+   list the first time the Ziv loop is entered by the current thread.
+   If the function already has a node in the list (it has several Ziv
+   loops), the new node is not linked, and its counters go to this node
+   (the owner), so that each name appears once in the list. Thus the
+   loops counter is incremented each time a Ziv loop is entered, which
+   may happen several times in a single call (e.g. mpfr_lngamma_aux),
+   while the calls counter is only incremented the first time, as given
+   by the local marker *call (see MPFR_ZIV_COUNTERS_DECL).
+   The cycles and bytes are counted from MPFR_ZIV_INIT to MPFR_ZIV_FREE,
+   thus include those of the functions called in the Ziv loop. */
+static MPFR_THREAD_ATTR mpfr_counters_node_t *counters_list = NULL;
+static MPFR_THREAD_ATTR unsigned long counters_nfuncs = 0;
+
+/* Number of bytes allocated by MPFR (reallocations included), and its
+   value at the last reset. counters_bytes is never decreased, so that the
+   difference computed by mpfr_ziv_counters_stop is non-negative even if
+   the counters have been reset during the loop. */
+static MPFR_THREAD_ATTR double counters_bytes = 0.0;
+static MPFR_THREAD_ATTR double counters_bytes0 = 0.0;
+
+size_t
+mpfr_count_alloc (size_t s)
+{
+  counters_bytes += (double) s;
+  return s;
+}
+
+size_t
+mpfr_count_realloc (size_t old_size, size_t new_size)
+{
+  if (new_size > old_size)
+    counters_bytes += (double) (new_size - old_size);
+  return new_size;
+}
+
+/* Called by MPFR_ZIV_INIT: return the number of bytes allocated so far,
+   for mpfr_ziv_counters_stop. */
+double
+mpfr_ziv_counters_start (mpfr_counters_node_t *node, const char *name,
+                         int *call)
+{
+  if (MPFR_UNLIKELY (node->owner == NULL))
+    {
+      mpfr_counters_node_t *p;
+
+      for (p = counters_list; p != NULL; p = p->next)
+        if (strcmp (p->c.name, name) == 0)
+          break;
+      if (p == NULL)
+        {
+          node->c.name = name;
+          node->next = counters_list;
+          counters_list = p = node;
+          counters_nfuncs++;
+        }
+      node->owner = p;
+    }
+  if (*call == 0)
+    {
+      *call = 1;
+      node->owner->c.calls++;
+    }
+  node->owner->c.loops++;
+  node->owner->c.iterations++;
+  return counters_bytes;
+}
+
+/* Called by MPFR_ZIV_FREE */
+void
+mpfr_ziv_counters_stop (mpfr_counters_node_t *node, mpfr_cycles_t t0,
+                        double b0)
+{
+  node->owner->c.cycles += (double) (MPFR_CYCLES () - t0);
+  node->owner->c.bytes += counters_bytes - b0;
+}
+
+unsigned long
+mpfr_counters_get (mpfr_counters_t *c, unsigned long n)
+{
+  mpfr_counters_node_t *node;
+  unsigned long i;
+
+  for (node = counters_list, i = 0; node != NULL && i < n;
+       node = node->next, i++)
+    c[i] = node->c;
+  return counters_nfuncs;
+}
+
+int
+mpfr_counters_cycles_p (void)
+{
+#ifdef MPFR_HAVE_CYCLES
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+double
+mpfr_counters_get_bytes (void)
+{
+  return counters_bytes - counters_bytes0;
+}
+
+void
+mpfr_counters_reset (void)
+{
+  mpfr_counters_node_t *node;
+
+  for (node = counters_list; node != NULL; node = node->next)
+    {
+      node->c.calls = 0;
+      node->c.loops = 0;
+      node->c.iterations = 0;
+      node->c.failures = 0;
+      node->c.bytes = 0.0;
+      node->c.cycles = 0.0;
+    }
+  counters_bytes0 = counters_bytes;
+}
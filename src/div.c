@@ -642,6 +642,25 @@ mpfr_div_2 (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
     }
 }
 
+/* Special code for 3*GMP_NUMB_BITS < PREC(q) <= 8*GMP_NUMB_BITS, generated
+   from div_fixed.h: mpfr_div_N is used when MPFR_PREC2LIMBS(PREC(q)) = N.
+   Between 2 and 3 limbs, the generic code is still used. */
+#define FUNCTION mpfr_div_4
+#define N 4
+#include "div_fixed.h"
+#define FUNCTION mpfr_div_5
+#define N 5
+#include "div_fixed.h"
+#define FUNCTION mpfr_div_6
+#define N 6
+#include "div_fixed.h"
+#define FUNCTION mpfr_div_7
+#define N 7
+#include "div_fixed.h"
+#define FUNCTION mpfr_div_8
+#define N 8
+#include "div_fixed.h"
+
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
 /* check if {ap, an} is zero */
@@ -743,7 +762,7 @@ mpfr_mpn_sub_aux (mpfr_limb_ptr ap, mpfr_limb_ptr bp, mp_size_t n,
   return cy;
 }
 
-MPFR_HOT_FUNCTION_ATTR int
+MPFR_HOT_FUNCTION_ATTR MPFR_FMV_FUNCTION_ATTR int
 mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 {
   mp_size_t q0size, usize, vsize;
@@ -844,6 +863,22 @@ mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
 
       if (MPFR_GET_PREC(q) == GMP_NUMB_BITS)
         return mpfr_div_1n (q, u, v, rnd_mode);
+
+      if (3 * GMP_NUMB_BITS < MPFR_GET_PREC(q) &&
+          MPFR_GET_PREC(q) <= 8 * GMP_NUMB_BITS)
+        switch (MPFR_PREC2LIMBS (MPFR_GET_PREC(q)))
+          {
+          case 4:
+            return mpfr_div_4 (q, u, v, rnd_mode);
+          case 5:
+            return mpfr_div_5 (q, u, v, rnd_mode);
+          case 6:
+            return mpfr_div_6 (q, u, v, rnd_mode);
+          case 7:
+            return mpfr_div_7 (q, u, v, rnd_mode);
+          case 8:
+            return mpfr_div_8 (q, u, v, rnd_mode);
+          }
     }
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
@@ -1105,16 +1140,54 @@ mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
       remainder (denoted r below) stored in place of the low qsize limbs of u1.
   */
 
-  /* if Mulders' short division failed, we revert to division with remainder */
-  qh = mpn_divrem (qp, 0, ap + k, qqsize - k, bp, qsize - k);
-  /* let u1 be the upper part of u, and v1 the upper part of v (with sticky_u
-     and sticky_v representing the lower parts), then the quotient of u1 by v1
-     is now in {qp, qsize}, with possible carry in qh, and the remainder in
-     {ap + k, qsize - k} */
-  /* warning: qh may be 1 if u1 == v1, but u < v */
+  qh = MPFR_LIMB_MAX; /* the quotient is not computed yet */
+
+#if defined(WANT_GMP_INTERNALS) && defined(HAVE___GMPN_DIV_Q)
+  /* First try mpn_div_q, which gives the same truncated quotient as
+     mpn_divrem, but is faster since it does not compute the remainder.
+     The remainder is needed below only when the bits of the quotient after
+     the target precision (except the round bit for rounding to nearest)
+     are 000...000 or 000...001: in this case, which is rare when there are
+     enough such bits, we redo the division with mpn_divrem. */
+  sh2 = (qsize == q0size) ? sh : GMP_NUMB_BITS;
+  if (sh2 > 8)
+    {
+      mpfr_limb_ptr tp, sp;
+      mp_limb_t t;
+
+      tp = MPFR_TMP_LIMBS_ALLOC (qsize + 1);
+      sp = MPFR_TMP_LIMBS_ALLOC (qqsize - k + 1);
+      __gmpn_div_q (tp, ap + k, qqsize - k, bp, qsize - k, sp);
+      t = tp[0] & MPFR_LIMB_MASK (sh2);
+      if (rnd_mode == MPFR_RNDN)
+        t &= ~(MPFR_LIMB_ONE << (sh2 - 1));
+      /* t > 1 (rather than t != 0) keeps the result correct even if the
+         quotient were one too large, as with an approximate division:
+         subtracting 1 would change neither the bits above the truncated
+         ones nor the sticky bit. */
+      if (t > 1)
+        {
+          MPN_COPY (qp, tp, qsize);
+          qh = tp[qsize];
+        }
+    }
+#endif
 
-  k = qsize;
-  sticky_u = sticky_u || mpfr_mpn_cmpzero (ap, k);
+  if (qh == MPFR_LIMB_MAX)
+    {
+      /* if Mulders' short division failed, we revert to division with
+         remainder */
+      qh = mpn_divrem (qp, 0, ap + k, qqsize - k, bp, qsize - k);
+      /* let u1 be the upper part of u, and v1 the upper part of v (with
+         sticky_u and sticky_v representing the lower parts), then the
+         quotient of u1 by v1 is now in {qp, qsize}, with possible carry in
+         qh, and the remainder in {ap + k, qsize - k} */
+      /* warning: qh may be 1 if u1 == v1, but u < v */
+
+      sticky_u = sticky_u || mpfr_mpn_cmpzero (ap, qsize);
+    }
+  /* else the remainder is not known, but it is not needed, since the
+     truncated bits of the quotient are non-zero */
 
   sticky = sticky_u | sticky_v;
 
@@ -1443,3 +1516,67 @@ mpfr_div (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
   inex *= sign_quotient;
   MPFR_RET (inex);
 }
+
+/* Vector form of mpfr_div: r[i] <- a[i] / b[i] for 0 <= i < n, with the
+   ternary value of each quotient stored in inex[i]. As for mpfr_mul_vec,
+   the kernel is selected once from the precision of r[0], among those of
+   mpfr_div (1, 2 and 4 to 8 limbs). */
+void
+mpfr_div_vec (int *inex, const mpfr_ptr *r, const mpfr_ptr *a,
+              const mpfr_ptr *b, unsigned long n, mpfr_rnd_t rnd_mode)
+{
+  unsigned long i;
+  mpfr_prec_t p;
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  p = MPFR_GET_PREC (r[0]);
+
+#if !defined(MPFR_GENERIC_ABI)
+  if (p < GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_div_1 (r[i], a[i], b[i], rnd_mode),
+                   mpfr_div (r[i], a[i], b[i], rnd_mode));
+  else if (GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_div_2 (r[i], a[i], b[i], rnd_mode),
+                   mpfr_div (r[i], a[i], b[i], rnd_mode));
+  else if (p == GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_div_1n (r[i], a[i], b[i], rnd_mode),
+                   mpfr_div (r[i], a[i], b[i], rnd_mode));
+  else if (3 * GMP_NUMB_BITS < p && p <= 8 * GMP_NUMB_BITS)
+    switch (MPFR_PREC2LIMBS (p))
+      {
+      case 4:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_div_4 (r[i], a[i], b[i], rnd_mode),
+                       mpfr_div (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 5:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_div_5 (r[i], a[i], b[i], rnd_mode),
+                       mpfr_div (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 6:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_div_6 (r[i], a[i], b[i], rnd_mode),
+                       mpfr_div (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 7:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_div_7 (r[i], a[i], b[i], rnd_mode),
+                       mpfr_div (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 8:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_div_8 (r[i], a[i], b[i], rnd_mode),
+                       mpfr_div (r[i], a[i], b[i], rnd_mode));
+        break;
+      }
+  else
+#endif
+    for (i = 0; i < n; i++)
+      inex[i] = mpfr_div (r[i], a[i], b[i], rnd_mode);
+}
@@ -0,0 +1,133 @@
+/* mpfr_div_N -- divide two floating-point numbers of N limbs
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Special code for (N-1)*GMP_NUMB_BITS < PREC(q) = PREC(u) = PREC(v)
+   <= N*GMP_NUMB_BITS. Before including this file, define FUNCTION as the
+   name of the function and N as the number of limbs (see div.c). Since N
+   is a constant, the compiler can unroll the loops on the limbs.
+
+   We compute the integer quotient of u*B^k by v with B = 2^GMP_NUMB_BITS,
+   where k = N when PREC(q) < N*GMP_NUMB_BITS, so that the round bit is in
+   the quotient, and k = N+1 otherwise. Since 1/2 < u/v < 2, the quotient
+   has k or k+1 limbs, the upper one being 0 or 1. */
+
+static int
+FUNCTION (mpfr_ptr q, mpfr_srcptr u, mpfr_srcptr v, mpfr_rnd_t rnd_mode)
+{
+  mpfr_prec_t p = MPFR_GET_PREC(q);
+  mpfr_limb_ptr qp = MPFR_MANT(q);
+  mpfr_exp_t qx = MPFR_GET_EXP(u) - MPFR_GET_EXP(v);
+  mpfr_prec_t sh = N * GMP_NUMB_BITS - p;
+  mp_limb_t np[2 * N + 1], tp[N + 2], rp[N];
+  mp_limb_t rb, sb, x, mask = MPFR_LIMB_MASK(sh);
+  int i, k = N + (sh == 0);
+
+  MPFR_ASSERTD((N - 1) * GMP_NUMB_BITS < p && p <= N * GMP_NUMB_BITS);
+
+  for (i = 0; i < k; i++)
+    np[i] = 0;
+  for (i = 0; i < N; i++)
+    np[k + i] = MPFR_MANT(u)[i];
+  mpn_tdiv_qr (tp, rp, 0, np, N + k, MPFR_MANT(v), N);
+
+  sb = rp[0];
+  for (i = 1; i < N; i++)
+    sb |= rp[i];
+
+  if (tp[k] != 0)
+    {
+      MPFR_ASSERTD(tp[k] == 1);
+      qx ++;
+      sb |= tp[0] & 1;
+      for (i = 0; i < k; i++)
+        tp[i] = (tp[i + 1] << (GMP_NUMB_BITS - 1)) | (tp[i] >> 1);
+    }
+  MPFR_ASSERTD(tp[k - 1] >= MPFR_LIMB_HIGHBIT);
+
+  if (sh == 0)
+    {
+      rb = tp[0] & MPFR_LIMB_HIGHBIT;
+      sb |= tp[0] ^ rb;
+    }
+  else
+    {
+      rb = tp[0] & (MPFR_LIMB_ONE << (sh - 1));
+      sb |= (tp[0] & mask) ^ rb;
+      tp[0] &= ~mask;
+    }
+  for (i = 0; i < N; i++)
+    qp[i] = tp[k - N + i];
+
+  MPFR_SIGN(q) = MPFR_MULT_SIGN (MPFR_SIGN (u), MPFR_SIGN (v));
+
+  /* rounding */
+  if (MPFR_UNLIKELY(qx > __gmpfr_emax))
+    return mpfr_overflow (q, rnd_mode, MPFR_SIGN(q));
+
+  /* See the comments in mpfr_div_2: the case 0.111...111*2^(emin-1) < q <
+     2^(emin-1) is not possible, and for RNDN, we have to change to RNDZ when
+     |q| <= 2^(emin-2). */
+  if (MPFR_UNLIKELY(qx < __gmpfr_emin))
+    {
+      if (rnd_mode == MPFR_RNDN)
+        {
+          /* x = 0 iff q = 1/2*2^(emin-1) and the quotient is exact */
+          x = (qp[N - 1] ^ MPFR_LIMB_HIGHBIT) | sb;
+          for (i = 0; i < N - 1; i++)
+            x |= qp[i];
+          if (qx < __gmpfr_emin - 1 || x == 0)
+            rnd_mode = MPFR_RNDZ;
+        }
+      return mpfr_underflow (q, rnd_mode, MPFR_SIGN(q));
+    }
+
+  MPFR_SET_EXP (q, qx);
+  if ((rb == 0 && sb == 0) || rnd_mode == MPFR_RNDF)
+    MPFR_RET (0);
+  else if (rnd_mode == MPFR_RNDN)
+    {
+      /* See the comment in mpfr_div_1. */
+      MPFR_ASSERTD(sb != 0);
+      if (rb == 0)
+        goto truncate;
+      else
+        goto add_one_ulp;
+    }
+  else if (MPFR_IS_LIKE_RNDZ(rnd_mode, MPFR_IS_NEG(q)))
+    {
+    truncate:
+      MPFR_RET(-MPFR_SIGN(q));
+    }
+  else /* round away from zero */
+    {
+    add_one_ulp:
+      qp[0] += MPFR_LIMB_ONE << sh;
+      for (i = 1; i < N && qp[i - 1] == 0; i++)
+        qp[i] ++;
+      /* there can be no overflow in the addition above,
+         see the analysis of mpfr_div_1 */
+      MPFR_ASSERTD(qp[N - 1] != 0);
+      MPFR_RET(MPFR_SIGN(q));
+    }
+}
+
+#undef FUNCTION
+#undef N
@@ -19,20 +19,31 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+#define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
-/* FIXME: Handle intermediate overflows and underflows. */
-/* FIXME: Extend the exponent range as usual. */
+/* The exact products a[i]*b[i] are computed one after the other in the
+   same scratch space and added to an exact accumulator (see sumacc.c),
+   so that the memory does not depend on n. The exponent of an exact
+   product, between 2*emin-1 and 2*emax, is always representable and
+   handled by the accumulator: there are no intermediate overflows or
+   underflows, and only the final result is checked against the current
+   exponent range. */
 
 /* res <- a[0]*b[0] + ... + a[n-1]*b[n-1] */
 int
 mpfr_dot (mpfr_ptr res, const mpfr_ptr *a, const mpfr_ptr *b,
           unsigned long n, mpfr_rnd_t rnd)
 {
-  mpfr_t *c;
-  size_t i;
+  mpfr_sumacc_t acc;
+  mp_limb_t *tp;
+  mp_size_t tn = 0;
+  unsigned long i;
   int inex;
-  mpfr_ptr *tab;
+  MPFR_TMP_DECL (marker);
+  MPFR_LOG_FUNC
+    (("n=%lu rnd=%d", n, rnd),
+     ("res[%Pd]=%.*Rg", mpfr_get_prec (res), mpfr_log_prec, res));
 
   if (MPFR_UNLIKELY (n == 0))
     {
@@ -41,19 +52,67 @@ mpfr_dot (mpfr_ptr res, const mpfr_ptr *a, const mpfr_ptr *b,
       MPFR_RET (0);
     }
 
-  c = (mpfr_t *) mpfr_allocate_func (n * sizeof (mpfr_t));
-  tab = (mpfr_ptr *) mpfr_allocate_func (n * sizeof (mpfr_ptr));
+  /* size of the scratch space: largest product, plus one limb for the
+     shift done by mpfr_sumacc_add_limbs */
   for (i = 0; i < n; i++)
     {
-      mpfr_init2 (c[i], mpfr_get_prec (a[i]) + mpfr_get_prec (b[i]));
-      inex = mpfr_mul (c[i], a[i], b[i], MPFR_RNDZ); /* exact except... */
-      MPFR_ASSERTN (inex == 0); /* failure in case of overflow/underflow */
-      tab[i] = c[i];
+      mp_size_t k = MPFR_LIMB_SIZE (a[i]) + MPFR_LIMB_SIZE (b[i]) + 1;
+
+      if (k > tn)
+        tn = k;
     }
-  inex = mpfr_sum (res, tab, n, rnd);
+
+  MPFR_TMP_MARK (marker);
+  tp = MPFR_TMP_LIMBS_ALLOC (tn);
+  mpfr_sumacc_init (acc);
+
   for (i = 0; i < n; i++)
-    mpfr_clear (c[i]);
-  mpfr_free_func (c, n * sizeof (mpfr_t));
-  mpfr_free_func (tab, n * sizeof (mpfr_ptr));
+    {
+      mpfr_srcptr x = a[i], y = b[i];
+
+      if (MPFR_UNLIKELY (MPFR_ARE_SINGULAR (x, y)))
+        {
+          /* Same special values as mpfr_mul: the product is NaN if x or
+             y is NaN, or for 0 * Inf, otherwise it is Inf if x or y is
+             Inf, otherwise zero; and the sign is the product of the
+             signs. Only its class and sign matter. */
+          mpfr_t z;
+          mp_limb_t zp[1];
+
+          MPFR_TMP_INIT1 (zp, z, MPFR_PREC_MIN);
+          if (MPFR_IS_NAN (x) || MPFR_IS_NAN (y) ||
+              (MPFR_IS_INF (x) && MPFR_IS_ZERO (y)) ||
+              (MPFR_IS_ZERO (x) && MPFR_IS_INF (y)))
+            MPFR_SET_NAN (z);
+          else if (MPFR_IS_INF (x) || MPFR_IS_INF (y))
+            MPFR_SET_INF (z);
+          else
+            MPFR_SET_ZERO (z);
+          MPFR_SET_SIGN (z, MPFR_MULT_SIGN (MPFR_SIGN (x), MPFR_SIGN (y)));
+          mpfr_sumacc_add (acc, z);
+        }
+      else
+        {
+          mp_size_t xn = MPFR_LIMB_SIZE (x), yn = MPFR_LIMB_SIZE (y);
+          mp_limb_t *xp = MPFR_MANT (x), *yp = MPFR_MANT (y);
+
+          if (xn == 1 && yn == 1)
+            umul_ppmm (tp[1], tp[0], xp[0], yp[0]);
+          else if (xp == yp && xn == yn)
+            mpn_sqr (tp, xp, xn);
+          else if (xn >= yn)
+            mpn_mul (tp, xp, xn, yp, yn);
+          else
+            mpn_mul (tp, yp, yn, xp, xn);
+          mpfr_sumacc_add_limbs (acc, tp, xn + yn,
+                                 MPFR_GET_EXP (x) + MPFR_GET_EXP (y),
+                                 MPFR_MULT_SIGN (MPFR_SIGN (x),
+                                                 MPFR_SIGN (y)) < 0);
+        }
+    }
+
+  inex = mpfr_sumacc_get (res, acc, rnd);
+  mpfr_sumacc_clear (acc);
+  MPFR_TMP_FREE (marker);
   return inex;
 }
@@ -366,8 +366,8 @@ mpfr_eint (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
       if (MPFR_LIKELY (MPFR_CAN_ROUND (tmp, prec - err, MPFR_PREC (y), rnd)))
         break;
       MPFR_ZIV_NEXT (loop, prec);        /* Increase used precision */
-      mpfr_set_prec (tmp, prec);
-      mpfr_set_prec (ump, prec);
+      mpfr_ziv_set_prec (tmp, prec);
+      mpfr_ziv_set_prec (ump, prec);
     }
   MPFR_ZIV_FREE (loop);                  /* Free the ZivLoop Controller */
 
@@ -263,7 +263,7 @@ mpfr_erfc (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd)
       if (MPFR_LIKELY (MPFR_CAN_ROUND (tmp, prec - err, MPFR_PREC (y), rnd)))
         break;
       MPFR_ZIV_NEXT (loop, prec);        /* Increase used precision */
-      mpfr_set_prec (tmp, prec);
+      mpfr_ziv_set_prec (tmp, prec);
     }
   MPFR_ZIV_FREE (loop);                  /* Free the ZivLoop Controller */
 
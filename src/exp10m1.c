@@ -163,7 +163,7 @@ mpfr_exp10m1 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       /* increase the precision */
       MPFR_ZIV_NEXT (loop, Nt);
-      mpfr_set_prec (t, Nt);
+      mpfr_ziv_set_prec (t, Nt);
     }
 
   inexact = mpfr_set (y, t, rnd_mode);
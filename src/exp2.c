@@ -48,6 +48,7 @@ mpfr_exp2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   int inexact;
   mpfr_eexp_t xint;  /* note: will fit in mpfr_exp_t */
   mpfr_t xfrac;
+  MPFR_GROUP_DECL (group);
   MPFR_SAVE_EXPO_DECL (expo);
 
   MPFR_LOG_FUNC
@@ -103,7 +104,7 @@ mpfr_exp2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   xint = mpfr_get_exp_t (x, MPFR_RNDZ);
   MPFR_ASSERTD (__gmpfr_emin - 2 < xint && xint < __gmpfr_emax);
 
-  mpfr_init2 (xfrac, MPFR_PREC (x));
+  MPFR_GROUP_INIT_1 (group, MPFR_PREC (x), xfrac);
   MPFR_DBGRES (inexact = mpfr_frac (xfrac, x, MPFR_RNDN));
   MPFR_ASSERTD (inexact == 0);
 
@@ -123,6 +124,7 @@ mpfr_exp2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       mpfr_prec_t Ny = MPFR_PREC(y);              /* target precision */
       mpfr_prec_t Nt;                             /* working precision */
       mpfr_exp_t err;                             /* error */
+      MPFR_GROUP_DECL (group2);
       MPFR_ZIV_DECL (loop);
 
       /* compute the precision of intermediary variable */
@@ -130,7 +132,7 @@ mpfr_exp2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       Nt = Ny + 5 + MPFR_INT_CEIL_LOG2 (Ny);
 
       /* initialize of intermediary variable */
-      mpfr_init2 (t, Nt);
+      MPFR_GROUP_INIT_1 (group2, Nt, t);
 
       /* First computation */
       MPFR_ZIV_INIT (loop, Nt);
@@ -147,16 +149,16 @@ mpfr_exp2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
           /* Actualisation of the precision */
           MPFR_ZIV_NEXT (loop, Nt);
-          mpfr_set_prec (t, Nt);
+          MPFR_GROUP_REPREC_1 (group2, Nt, t);
         }
       MPFR_ZIV_FREE (loop);
 
       inexact = mpfr_set (y, t, rnd_mode);
 
-      mpfr_clear (t);
+      MPFR_GROUP_CLEAR (group2);
     }
 
-  mpfr_clear (xfrac);
+  MPFR_GROUP_CLEAR (group);
 
   if (MPFR_UNLIKELY (rnd_mode == MPFR_RNDN && xint == __gmpfr_emin - 1 &&
                      MPFR_GET_EXP (y) == 0 && mpfr_powerof2_raw (y)))
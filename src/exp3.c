@@ -356,8 +356,8 @@ mpfr_exp_3 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       MPFR_ZIV_NEXT (ziv_loop, realprec);
       Prec = realprec + shift + 2 + shift_x;
-      mpfr_set_prec (t, Prec);
-      mpfr_set_prec (tmp, Prec);
+      mpfr_ziv_set_prec (t, Prec);
+      mpfr_ziv_set_prec (tmp, Prec);
     }
   MPFR_ZIV_FREE (ziv_loop);
 
@@ -165,7 +165,9 @@ mpfr_exp_2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
      the MPFR_GROUP_* macros here because mpfr_prec_round is only
      called in a special case. */
   MPFR_GROUP_INIT_2(group, q + error_r, r, s);
-  mpz_init (ss);
+  /* ss has about q bits, and is squared: take it large enough from the
+     mpz_t pool, so that it does not need to be reallocated */
+  mpz_init2 (ss, 2 * (q + GMP_NUMB_BITS));
 
   /* the algorithm consists in computing an upper bound of exp(x) using
      a precision of q bits, and see if we can round to MPFR_PREC(y) taking
@@ -282,8 +284,9 @@ mpfr_exp2_aux (mpz_t s, mpfr_srcptr r, mpfr_prec_t q, mpfr_exp_t *exps)
 
   expt = 0;
   *exps = 1 - (mpfr_exp_t) q;                   /* s = 2^(q-1) */
-  mpz_init (t);
-  mpz_init (rr);
+  /* t and rr have at most q bits, but t is multiplied by rr */
+  mpz_init2 (t, 2 * (q + GMP_NUMB_BITS));
+  mpz_init2 (rr, q + GMP_NUMB_BITS);
   mpz_set_ui (t, 1);
   mpz_set_ui (s, 1);
   mpz_mul_2exp (s, s, q-1);
@@ -369,12 +372,12 @@ mpfr_exp2_aux2 (mpz_t s, mpfr_srcptr r, mpfr_prec_t q, mpfr_exp_t *exps)
   expR = (mpfr_exp_t*) MPFR_TMP_ALLOC((m + 1) * sizeof (mpfr_exp_t));
   /* expR[i] is the exponent for R[i] */
   mpz_init (tmp);
-  mpz_init (rr);
-  mpz_init (t);
+  mpz_init2 (rr, q + GMP_NUMB_BITS);
+  mpz_init2 (t, 2 * (q + GMP_NUMB_BITS));
   mpz_set_ui (s, 0);
   *exps = 1 - q;                        /* 1 ulp = 2^(1-q) */
   for (i = 0 ; i <= m ; i++)
-    mpz_init (R[i]);
+    mpz_init2 (R[i], q + GMP_NUMB_BITS);
   expR[1] = mpfr_get_z_2exp (R[1], r); /* exact operation: no error */
   expR[1] = mpz_normalize2 (R[1], R[1], expR[1], 1 - q); /* error <= 1 ulp */
   mpz_mul (t, R[1], R[1]); /* err(t) <= 2 ulps */
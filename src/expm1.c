@@ -158,7 +158,7 @@ mpfr_expm1 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
         /* increase the precision */
         MPFR_ZIV_NEXT (loop, Nt);
-        mpfr_set_prec (t, Nt);
+        mpfr_ziv_set_prec (t, Nt);
       }
     MPFR_ZIV_FREE (loop);
 
@@ -95,7 +95,7 @@ mpfr_fac_ui (mpfr_ptr y, unsigned long int x, mpfr_rnd_t rnd_mode)
             rnd = (rnd == MPFR_RNDZ) ? MPFR_RNDU : MPFR_RNDZ;
         }
       MPFR_ZIV_NEXT (loop, Nt);
-      mpfr_set_prec (t, Nt);
+      mpfr_ziv_set_prec (t, Nt);
     }
   MPFR_ZIV_FREE (loop);
 
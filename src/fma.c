@@ -101,6 +101,92 @@ mpfr_fma_singular (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
     }
 }
 
+/* s <- x*y + z when x, y, z and s have the same precision p < GMP_NUMB_BITS,
+   x, y and z are regular and e = EXP(x) + EXP(y) is in the exponent range
+   (see mpfr_fma): the exact product x*y and z are added with precision 2p,
+   then rounded to s with mpfr_set_1_2. */
+static int
+mpfr_fma_1 (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
+            mpfr_rnd_t rnd_mode, mpfr_exp_t e)
+{
+  mpfr_prec_t precx = MPFR_PREC(x);
+  mp_limb_t umant[2], zmant[2];
+  mpfr_t u, zz;
+  int inex;
+
+  umul_ppmm (umant[1], umant[0], MPFR_MANT(x)[0], MPFR_MANT(y)[0]);
+  MPFR_PREC(u) = MPFR_PREC(zz) = 2 * precx;
+  MPFR_MANT(u) = umant;
+  MPFR_MANT(zz) = zmant;
+  MPFR_SIGN(u) = MPFR_MULT_SIGN(MPFR_SIGN(x), MPFR_SIGN(y));
+  MPFR_SIGN(zz) = MPFR_SIGN(z);
+  MPFR_EXP(zz) = MPFR_EXP(z);
+  if (MPFR_PREC(zz) <= GMP_NUMB_BITS) /* zz fits in one limb */
+    {
+      if ((umant[1] & MPFR_LIMB_HIGHBIT) == 0)
+        {
+          umant[0] = umant[1] << 1;
+          MPFR_EXP(u) = e - 1;
+        }
+      else
+        {
+          umant[0] = umant[1];
+          MPFR_EXP(u) = e;
+        }
+      zmant[0] = MPFR_MANT(z)[0];
+    }
+  else
+    {
+      zmant[1] = MPFR_MANT(z)[0];
+      zmant[0] = MPFR_LIMB_ZERO;
+      if ((umant[1] & MPFR_LIMB_HIGHBIT) == 0)
+        {
+          umant[1] = (umant[1] << 1) |
+            (umant[0] >> (GMP_NUMB_BITS - 1));
+          umant[0] = umant[0] << 1;
+          MPFR_EXP(u) = e - 1;
+        }
+      else
+        MPFR_EXP(u) = e;
+    }
+  inex = mpfr_add (u, u, zz, rnd_mode);
+  /* mpfr_set_1_2 requires PREC(u) = 2*PREC(s),
+     thus we need PREC(s) = PREC(x) = PREC(y) = PREC(z) */
+  return mpfr_set_1_2 (s, u, rnd_mode, inex);
+}
+
+/* s <- x*y + z when x and y have the same precision, with n limbs, x, y
+   and z are regular and e = EXP(x) + EXP(y) is in the exponent range: the
+   product x*y is computed exactly into {up, 2n}, provided by the caller,
+   then added to z. */
+static int
+mpfr_fma_n (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
+            mpfr_rnd_t rnd_mode, mpfr_exp_t e, mp_size_t n, mpfr_limb_ptr up)
+{
+  mpfr_t u;
+  mp_size_t un = n + n;
+
+  MPFR_TMP_INIT1 (up, u, un * GMP_NUMB_BITS);
+  /* multiply x*y exactly into u */
+  if (n == 1)
+    umul_ppmm (up[1], up[0], MPFR_MANT(x)[0], MPFR_MANT(y)[0]);
+  else if (x == y)
+    mpn_sqr (up, MPFR_MANT(x), n);
+  else
+    mpn_mul_n (up, MPFR_MANT(x), MPFR_MANT(y), n);
+  if (MPFR_LIMB_MSB (up[un - 1]) == 0)
+    {
+      mpn_lshift (up, up, un, 1);
+      MPFR_EXP(u) = e - 1;
+    }
+  else
+    MPFR_EXP(u) = e;
+  MPFR_SIGN(u) = MPFR_MULT_SIGN(MPFR_SIGN(x), MPFR_SIGN(y));
+  /* The above code does not generate any exception.
+     The exceptions will come only from mpfr_add. */
+  return mpfr_add (s, u, z, rnd_mode);
+}
+
 /* s <- x*y + z */
 int
 mpfr_fma (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
@@ -142,76 +228,15 @@ mpfr_fma (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
       if (precx < GMP_NUMB_BITS &&
           MPFR_PREC(z) == precx &&
           MPFR_PREC(s) == precx)
-        {
-          mp_limb_t umant[2], zmant[2];
-          mpfr_t zz;
-          int inex;
-
-          umul_ppmm (umant[1], umant[0], MPFR_MANT(x)[0], MPFR_MANT(y)[0]);
-          MPFR_PREC(u) = MPFR_PREC(zz) = 2 * precx;
-          MPFR_MANT(u) = umant;
-          MPFR_MANT(zz) = zmant;
-          MPFR_SIGN(u) = MPFR_MULT_SIGN(MPFR_SIGN(x), MPFR_SIGN(y));
-          MPFR_SIGN(zz) = MPFR_SIGN(z);
-          MPFR_EXP(zz) = MPFR_EXP(z);
-          if (MPFR_PREC(zz) <= GMP_NUMB_BITS) /* zz fits in one limb */
-            {
-              if ((umant[1] & MPFR_LIMB_HIGHBIT) == 0)
-                {
-                  umant[0] = umant[1] << 1;
-                  MPFR_EXP(u) = e - 1;
-                }
-              else
-                {
-                  umant[0] = umant[1];
-                  MPFR_EXP(u) = e;
-                }
-              zmant[0] = MPFR_MANT(z)[0];
-            }
-          else
-            {
-              zmant[1] = MPFR_MANT(z)[0];
-              zmant[0] = MPFR_LIMB_ZERO;
-              if ((umant[1] & MPFR_LIMB_HIGHBIT) == 0)
-                {
-                  umant[1] = (umant[1] << 1) |
-                    (umant[0] >> (GMP_NUMB_BITS - 1));
-                  umant[0] = umant[0] << 1;
-                  MPFR_EXP(u) = e - 1;
-                }
-              else
-                MPFR_EXP(u) = e;
-            }
-          inex = mpfr_add (u, u, zz, rnd_mode);
-          /* mpfr_set_1_2 requires PREC(u) = 2*PREC(s),
-             thus we need PREC(s) = PREC(x) = PREC(y) = PREC(z) */
-          return mpfr_set_1_2 (s, u, rnd_mode, inex);
-        }
+        return mpfr_fma_1 (s, x, y, z, rnd_mode, e);
       else if ((n = MPFR_LIMB_SIZE(x)) <= 4 * MPFR_MUL_THRESHOLD)
         {
           mpfr_limb_ptr up;
-          mp_size_t un = n + n;
           MPFR_TMP_DECL(marker);
 
           MPFR_TMP_MARK(marker);
-          MPFR_TMP_INIT (up, u, un * GMP_NUMB_BITS, un);
-          up = MPFR_MANT(u);
-          /* multiply x*y exactly into u */
-          if (x == y)
-            mpn_sqr (up, MPFR_MANT(x), n);
-          else
-            mpn_mul_n (up, MPFR_MANT(x), MPFR_MANT(y), n);
-          if (MPFR_LIMB_MSB (up[un - 1]) == 0)
-            {
-              mpn_lshift (up, up, un, 1);
-              MPFR_EXP(u) = e - 1;
-            }
-          else
-            MPFR_EXP(u) = e;
-          MPFR_SIGN(u) = MPFR_MULT_SIGN(MPFR_SIGN(x), MPFR_SIGN(y));
-          /* The above code does not generate any exception.
-             The exceptions will come only from mpfr_add. */
-          inexact = mpfr_add (s, u, z, rnd_mode);
+          up = MPFR_TMP_LIMBS_ALLOC (n + n);
+          inexact = mpfr_fma_n (s, x, y, z, rnd_mode, e, n, up);
           MPFR_TMP_FREE(marker);
           return inexact;
         }
@@ -304,3 +329,58 @@ mpfr_fma (mpfr_ptr s, mpfr_srcptr x, mpfr_srcptr y, mpfr_srcptr z,
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (s, inexact, rnd_mode);
 }
+
+/* Vector form of mpfr_fma: r[i] <- a[i] * b[i] + c[i] for 0 <= i < n, with
+   the ternary value of each result stored in inex[i]. When all the
+   operands of an element have the precision p of r[0], are regular, the
+   exponent of the product is in the current exponent range and p is not
+   too large (as in mpfr_fma), the element goes directly to mpfr_fma_1
+   (p < GMP_NUMB_BITS) or mpfr_fma_n, with the same scratch space for the
+   exact products of all the elements (on the stack up to 3 limbs, in which
+   case the number of limbs is a constant in the calls to mpfr_fma_n); the
+   other ones are handled by mpfr_fma. */
+void
+mpfr_fma_vec (int *inex, const mpfr_ptr *r, const mpfr_ptr *a,
+              const mpfr_ptr *b, const mpfr_ptr *c, unsigned long n,
+              mpfr_rnd_t rnd_mode)
+{
+  unsigned long i;
+  mpfr_prec_t p;
+  mp_size_t ln;
+  mp_limb_t buf[6];
+  mpfr_limb_ptr up;
+  MPFR_TMP_DECL(marker);
+  MPFR_LOG_FUNC (("n=%lu rnd=%d", n, rnd_mode), ("", 0));
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  p = MPFR_GET_PREC (r[0]);
+  ln = MPFR_PREC2LIMBS (p);
+  MPFR_TMP_MARK(marker);
+  up = ln <= 3 || ln > 4 * MPFR_MUL_THRESHOLD ? buf
+    : MPFR_TMP_LIMBS_ALLOC (ln + ln);
+
+  for (i = 0; i < n; i++)
+    {
+      mpfr_srcptr x = a[i], y = b[i], z = c[i];
+      mpfr_exp_t e;
+
+      if (MPFR_LIKELY (MPFR_PREC (r[i]) == p && MPFR_PREC (x) == p &&
+                       MPFR_PREC (y) == p && MPFR_PREC (z) == p &&
+                       ln <= 4 * MPFR_MUL_THRESHOLD &&
+                       ! MPFR_ARE_SINGULAR (x, y) && ! MPFR_IS_SINGULAR (z) &&
+                       (e = MPFR_GET_EXP (x) + MPFR_GET_EXP (y),
+                        e <= __gmpfr_emax && e > __gmpfr_emin)))
+        inex[i] = p < GMP_NUMB_BITS ?
+          mpfr_fma_1 (r[i], x, y, z, rnd_mode, e) :
+          ln == 1 ? mpfr_fma_n (r[i], x, y, z, rnd_mode, e, 1, up) :
+          ln == 2 ? mpfr_fma_n (r[i], x, y, z, rnd_mode, e, 2, up) :
+          ln == 3 ? mpfr_fma_n (r[i], x, y, z, rnd_mode, e, 3, up) :
+          mpfr_fma_n (r[i], x, y, z, rnd_mode, e, ln, up);
+      else
+        inex[i] = mpfr_fma (r[i], x, y, z, rnd_mode);
+    }
+
+  MPFR_TMP_FREE(marker);
+}
@@ -19,43 +19,50 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+#define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
-/* compute a*b+c*d if neg=0 (fmma), a*b-c*d otherwise (fmms) */
+/* compute a*b+c*d if neg=0 (fmma), a*b-c*d otherwise (fmms), where the
+   exact products are computed into {up, un} and {vp, vn}, with
+   un = LIMB_SIZE(a) + LIMB_SIZE(b) and vn = LIMB_SIZE(c) + LIMB_SIZE(d),
+   and {zp, un} is used when all the precisions are the same */
 static int
-mpfr_fmma_aux (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
-               mpfr_srcptr d, mpfr_rnd_t rnd, int neg)
+mpfr_fmma_core (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
+                mpfr_srcptr d, mpfr_rnd_t rnd, int neg, mpfr_limb_ptr up,
+                mpfr_limb_ptr vp, mpfr_limb_ptr zp)
 {
   mpfr_ubf_t u, v;
   mpfr_t zz;
   mpfr_prec_t prec_z = MPFR_PREC(z);
   mp_size_t un, vn;
-  mpfr_limb_ptr up, vp, zp;
   int inex;
-  MPFR_TMP_DECL(marker);
-
-  MPFR_LOG_FUNC
-    (("a[%Pd]=%.*Rg b[%Pd]=%.*Rg c[%Pd]=%.*Rg d[%Pd]=%.*Rg rnd=%d neg=%d",
-      mpfr_get_prec (a), mpfr_log_prec, a,
-      mpfr_get_prec (b), mpfr_log_prec, b,
-      mpfr_get_prec (c), mpfr_log_prec, c,
-      mpfr_get_prec (d), mpfr_log_prec, d, rnd, neg),
-     ("z[%Pd]=%.*Rg", mpfr_get_prec (z), mpfr_log_prec, z));
-
-  MPFR_TMP_MARK (marker);
 
   un = MPFR_LIMB_SIZE (a) + MPFR_LIMB_SIZE (b);
   vn = MPFR_LIMB_SIZE (c) + MPFR_LIMB_SIZE (d);
-  MPFR_TMP_INIT (up, u, (mpfr_prec_t) un * GMP_NUMB_BITS, un);
-  MPFR_TMP_INIT (vp, v, (mpfr_prec_t) vn * GMP_NUMB_BITS, vn);
+  MPFR_TMP_INIT1 (up, u, (mpfr_prec_t) un * GMP_NUMB_BITS);
+  MPFR_TMP_INIT1 (vp, v, (mpfr_prec_t) vn * GMP_NUMB_BITS);
 
   mpfr_ubf_mul_exact (u, a, b);
   mpfr_ubf_mul_exact (v, c, d);
-  if (prec_z == MPFR_PREC(a) && prec_z == MPFR_PREC(b) &&
+  /* If one product is zero, mpfr_add and mpfr_sub would just copy the other
+     one, which is wrong if it is an UBF: round it with mpfr_mul instead,
+     so that the overflow and underflow are handled. */
+  if (MPFR_IS_UBF (v) && MPFR_IS_ZERO (u))
+    {
+      inex = mpfr_mul (z, c, d, neg == 0 ? rnd : MPFR_INVERT_RND (rnd));
+      if (neg != 0)
+        {
+          MPFR_CHANGE_SIGN (z);
+          inex = -inex;
+        }
+    }
+  else if (MPFR_IS_UBF (u) && MPFR_IS_ZERO (v))
+    inex = mpfr_mul (z, a, b, rnd);
+  else if (prec_z == MPFR_PREC(a) && prec_z == MPFR_PREC(b) &&
       prec_z == MPFR_PREC(c) && prec_z == MPFR_PREC(d) &&
       un == MPFR_PREC2LIMBS(2 * prec_z))
     {
-      MPFR_TMP_INIT (zp, zz, 2 * prec_z, un);
+      MPFR_TMP_INIT1 (zp, zz, 2 * prec_z);
       MPFR_PREC(u) = MPFR_PREC(v) = 2 * prec_z;
       inex = (neg == 0) ? mpfr_add (zz, (mpfr_srcptr) u, (mpfr_srcptr) v, rnd)
         : mpfr_sub (zz, (mpfr_srcptr) u, (mpfr_srcptr) v, rnd);
@@ -68,6 +75,90 @@ mpfr_fmma_aux (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
   MPFR_UBF_CLEAR_EXP (u);
   MPFR_UBF_CLEAR_EXP (v);
 
+  return inex;
+}
+
+/* u <- x*y exactly into {up, 2n}, when x and y have the same precision p,
+   with n limbs, are regular and e = EXP(x) + EXP(y) is in the exponent
+   range. The precision of u is 2p: when MPFR_PREC2LIMBS(2p) = 2n - 1, the
+   least significant limb of the product is zero, and the significand of
+   u starts at the next limb. */
+static void
+mpfr_fmma_mul_n (mpfr_ptr u, mpfr_srcptr x, mpfr_srcptr y, mpfr_exp_t e,
+                 mp_size_t n, mpfr_limb_ptr up)
+{
+  mp_size_t un = n + n;
+
+  if (n == 1)
+    umul_ppmm (up[1], up[0], MPFR_MANT(x)[0], MPFR_MANT(y)[0]);
+  else if (x == y)
+    mpn_sqr (up, MPFR_MANT(x), n);
+  else
+    mpn_mul_n (up, MPFR_MANT(x), MPFR_MANT(y), n);
+  if (MPFR_LIMB_MSB (up[un - 1]) == 0)
+    {
+      mpn_lshift (up, up, un, 1);
+      MPFR_EXP(u) = e - 1;
+    }
+  else
+    MPFR_EXP(u) = e;
+  MPFR_PREC(u) = 2 * MPFR_PREC(x);
+  MPFR_MANT(u) = up + (un - MPFR_PREC2LIMBS (MPFR_PREC(u)));
+  MPFR_SIGN(u) = MPFR_MULT_SIGN(MPFR_SIGN(x), MPFR_SIGN(y));
+}
+
+/* z <- a*b + c*d when a, b, c, d and z have the same precision p, with
+   n limbs, a, b, c and d are regular, and e = EXP(a) + EXP(b) and
+   f = EXP(c) + EXP(d) are in the exponent range: as in the same-precision
+   case of mpfr_fmma_core, the exact products are added with precision 2p,
+   then rounded to z with mpfr_set_1_2, but the products are regular
+   numbers computed into {up, 2n} and {up + 2n, 2n}, without UBF, and the
+   sum goes into {up + 4n, 2n}. */
+static int
+mpfr_fmma_n (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
+             mpfr_srcptr d, mpfr_rnd_t rnd, mpfr_exp_t e, mpfr_exp_t f,
+             mp_size_t n, mpfr_limb_ptr up)
+{
+  mpfr_t u, v, zz;
+  int inex;
+
+  mpfr_fmma_mul_n (u, a, b, e, n, up);
+  mpfr_fmma_mul_n (v, c, d, f, n, up + 2 * n);
+  MPFR_TMP_INIT1 (up + 4 * n, zz, 2 * MPFR_PREC(z));
+  /* The above code does not generate any exception.
+     The exceptions will come only from mpfr_add and mpfr_set_1_2. */
+  inex = mpfr_add (zz, u, v, rnd);
+  return mpfr_set_1_2 (z, zz, rnd, inex);
+}
+
+/* compute a*b+c*d if neg=0 (fmma), a*b-c*d otherwise (fmms) */
+static int
+mpfr_fmma_aux (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
+               mpfr_srcptr d, mpfr_rnd_t rnd, int neg)
+{
+  mp_size_t un, vn;
+  mpfr_limb_ptr up, vp, zp;
+  int inex;
+  MPFR_TMP_DECL(marker);
+
+  MPFR_LOG_FUNC
+    (("a[%Pd]=%.*Rg b[%Pd]=%.*Rg c[%Pd]=%.*Rg d[%Pd]=%.*Rg rnd=%d neg=%d",
+      mpfr_get_prec (a), mpfr_log_prec, a,
+      mpfr_get_prec (b), mpfr_log_prec, b,
+      mpfr_get_prec (c), mpfr_log_prec, c,
+      mpfr_get_prec (d), mpfr_log_prec, d, rnd, neg),
+     ("z[%Pd]=%.*Rg", mpfr_get_prec (z), mpfr_log_prec, z));
+
+  MPFR_TMP_MARK (marker);
+
+  un = MPFR_LIMB_SIZE (a) + MPFR_LIMB_SIZE (b);
+  vn = MPFR_LIMB_SIZE (c) + MPFR_LIMB_SIZE (d);
+  up = MPFR_TMP_LIMBS_ALLOC (un);
+  vp = MPFR_TMP_LIMBS_ALLOC (vn);
+  zp = MPFR_TMP_LIMBS_ALLOC (un);
+
+  inex = mpfr_fmma_core (z, a, b, c, d, rnd, neg, up, vp, zp);
+
   MPFR_TMP_FREE (marker);
 
   return inex;
@@ -88,3 +179,63 @@ mpfr_fmms (mpfr_ptr z, mpfr_srcptr a, mpfr_srcptr b, mpfr_srcptr c,
 {
   return mpfr_fmma_aux (z, a, b, c, d, rnd, 1);
 }
+
+/* Vector form of mpfr_fmma: r[i] <- a[i] * b[i] + c[i] * d[i] for
+   0 <= i < n, with the ternary value of each result stored in inex[i].
+   The elements whose operands all have the precision p of r[0] go directly
+   to mpfr_fmma_core, with the same scratch space for all of them (on the
+   stack up to 3 limbs). Up to 3 limbs, when moreover the operands are
+   regular and the exponents of both products are in the current exponent
+   range, they go to mpfr_fmma_n instead, with the number of limbs as a
+   constant. The other elements are handled by mpfr_fmma. */
+void
+mpfr_fmma_vec (int *inex, const mpfr_ptr *r, const mpfr_ptr *a,
+               const mpfr_ptr *b, const mpfr_ptr *c, const mpfr_ptr *d,
+               unsigned long n, mpfr_rnd_t rnd)
+{
+  unsigned long i;
+  mpfr_prec_t p;
+  mp_size_t ln;
+  mp_limb_t buf[18];
+  mpfr_limb_ptr up;
+  MPFR_TMP_DECL(marker);
+  MPFR_LOG_FUNC (("n=%lu rnd=%d", n, rnd), ("", 0));
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  p = MPFR_GET_PREC (r[0]);
+  ln = MPFR_PREC2LIMBS (p);
+  MPFR_TMP_MARK (marker);
+  /* {up, 2ln}, {up + 2ln, 2ln} and {up + 4ln, 2ln} for the exact products
+     and their sum */
+  up = ln <= 3 ? buf : MPFR_TMP_LIMBS_ALLOC (6 * ln);
+
+  for (i = 0; i < n; i++)
+    {
+      mpfr_exp_t e, f;
+
+      if (MPFR_UNLIKELY (MPFR_PREC (r[i]) != p ||
+                         MPFR_PREC (a[i]) != p || MPFR_PREC (b[i]) != p ||
+                         MPFR_PREC (c[i]) != p || MPFR_PREC (d[i]) != p))
+        inex[i] = mpfr_fmma (r[i], a[i], b[i], c[i], d[i], rnd);
+      else if (ln <= 3 &&
+               ! MPFR_ARE_SINGULAR (a[i], b[i]) &&
+               ! MPFR_ARE_SINGULAR (c[i], d[i]) &&
+               (e = MPFR_GET_EXP (a[i]) + MPFR_GET_EXP (b[i]),
+                e <= __gmpfr_emax && e > __gmpfr_emin) &&
+               (f = MPFR_GET_EXP (c[i]) + MPFR_GET_EXP (d[i]),
+                f <= __gmpfr_emax && f > __gmpfr_emin))
+        inex[i] =
+          ln == 1 ? mpfr_fmma_n (r[i], a[i], b[i], c[i], d[i], rnd, e, f,
+                                 1, up) :
+          ln == 2 ? mpfr_fmma_n (r[i], a[i], b[i], c[i], d[i], rnd, e, f,
+                                 2, up) :
+          mpfr_fmma_n (r[i], a[i], b[i], c[i], d[i], rnd, e, f, 3, up);
+      else
+        inex[i] = mpfr_fmma_core (r[i], a[i], b[i], c[i], d[i], rnd, 0,
+                                  up, up + 2 * ln, up + 4 * ln);
+    }
+
+  MPFR_TMP_FREE (marker);
+}
@@ -776,3 +776,246 @@ mpfr_fpif_export_mem (unsigned char *buffer, size_t buffer_size, mpfr_srcptr x)
 
   return mpfr_fpif_export_aux((ext_data_ptr) &ext, x);
 }
+
+/* Contents of the caches of the constants.
+
+   The file starts with the MPFR_CACHE_MAGIC bytes. Then each non-empty
+   cache is stored as an entry consisting of:
+     * one byte with the identifier of the constant (see cache_of_id);
+     * one byte with the ternary value of the cached value (0 for an
+       exact value, 1 for a positive value, 2 for a negative value);
+     * the precision of the cached value on 8 bytes;
+     * the cached value in the above format;
+   followed by the checksum of these bytes on 4 bytes (the 32-bit FNV-1a
+   hash, which is sufficient to detect an accidental corruption). The
+   file ends with a null byte. Multi-byte numbers are encoded in little
+   endian, as above.
+
+   The values are checked before they are loaded into the caches: the
+   checksum must match, the precision must be the one of the header and
+   the value must be an approximation of the constant. Nothing is loaded
+   if an error occurs. */
+
+static const unsigned char mpfr_cache_magic[6] =
+  { 'M', 'P', 'F', 'R', 'c', 1 };
+
+#define MPFR_CACHE_NB_CONST 4
+
+#define FNV_OFFSET 0x811c9dc5UL
+#define FNV_PRIME  0x01000193UL
+
+struct ext_data_sum {
+  struct ext_data base;
+  FILE *fh;
+  unsigned long sum;
+};
+typedef struct ext_data_sum *ext_data_sum_ptr;
+
+static void
+update_sum (ext_data_sum_ptr ext, const unsigned char *buffer, size_t size)
+{
+  unsigned long h = ext->sum;
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    h = ((h ^ buffer[i]) * FNV_PRIME) & 0xffffffffUL;
+  ext->sum = h;
+}
+
+static int
+read_from_file_sum (ext_data_ptr h, unsigned char *buffer, size_t size)
+{
+  ext_data_sum_ptr ext = (ext_data_sum_ptr) h;
+
+  if (fread (buffer, size, 1, ext->fh) != 1)
+    return 0;
+  update_sum (ext, buffer, size);
+  return 1;
+}
+
+static int
+write_to_file_sum (ext_data_ptr h, unsigned char *buffer, size_t size)
+{
+  ext_data_sum_ptr ext = (ext_data_sum_ptr) h;
+
+  update_sum (ext, buffer, size);
+  return fwrite (buffer, size, 1, ext->fh);
+}
+
+/* id is from 1 to MPFR_CACHE_NB_CONST */
+static mpfr_cache_ptr
+cache_of_id (int id)
+{
+  switch (id)
+    {
+    case 1:
+      return __gmpfr_cache_const_pi;
+    case 2:
+      return __gmpfr_cache_const_log2;
+    case 3:
+      return __gmpfr_cache_const_euler;
+    default:
+      MPFR_ASSERTD (id == 4);
+      return __gmpfr_cache_const_catalan;
+    }
+}
+
+/* Return non-zero if x is at distance less than 2 ulps from the constant
+   of the cache, in precision min(PREC(x),64). */
+static int
+cache_check_value (mpfr_cache_ptr cache, mpfr_srcptr x)
+{
+  mpfr_t t, d;
+  mpfr_prec_t p;
+  int ok;
+  MPFR_SAVE_EXPO_DECL (expo);
+
+  p = MPFR_PREC (x) < 64 ? MPFR_PREC (x) : 64;
+  MPFR_SAVE_EXPO_MARK (expo);
+  mpfr_init2 (t, p);
+  mpfr_init2 (d, 64);
+  (*cache->func) (t, MPFR_RNDN);
+  mpfr_sub (d, x, t, MPFR_RNDN);
+  ok = MPFR_IS_ZERO (d) || MPFR_GET_EXP (d) <= MPFR_GET_EXP (t) - p + 1;
+  mpfr_clear (t);
+  mpfr_clear (d);
+  MPFR_SAVE_EXPO_FREE (expo);
+  return ok;
+}
+
+/*
+ * fh : IN : file handler
+ * Store the contents of the caches of the constants in the file.
+ * return 0 if successful
+ */
+int
+mpfr_fpif_export_cache (FILE *fh)
+{
+  struct ext_data_sum ext = { 0 };
+  unsigned char buf[10];
+  mpfr_t x;
+  int id, inex, i, ret = 0;
+
+  if (fh == NULL)
+    return -1;
+
+  ext.base._mpfr_io_fn = write_to_file_sum;
+  ext.fh = fh;
+
+  if (fwrite (mpfr_cache_magic, sizeof (mpfr_cache_magic), 1, fh) != 1)
+    return -1;
+
+  mpfr_init2 (x, MPFR_PREC_MIN);
+  for (id = 1; id <= MPFR_CACHE_NB_CONST && ret == 0; id++)
+    {
+      mpfr_prec_t p;
+
+      inex = mpfr_cache_get_value (x, cache_of_id (id));
+      if (inex == 2)  /* empty cache */
+        continue;
+      ext.sum = FNV_OFFSET;
+      buf[0] = id;
+      buf[1] = inex > 0 ? 1 : inex < 0 ? 2 : 0;
+      for (i = 0, p = MPFR_PREC (x); i < 8; i++, p >>= 8)
+        buf[2 + i] = p & 0xff;
+      if (write_to_file_sum ((ext_data_ptr) &ext, buf, 10) != 1 ||
+          mpfr_fpif_export_aux ((ext_data_ptr) &ext, x) != 0)
+        ret = -1;
+      else
+        {
+          for (i = 0; i < 4; i++)
+            buf[i] = (ext.sum >> (8 * i)) & 0xff;
+          if (fwrite (buf, 4, 1, fh) != 1)
+            ret = -1;
+        }
+    }
+  mpfr_clear (x);
+
+  buf[0] = 0;
+  if (ret == 0 && fwrite (buf, 1, 1, fh) != 1)
+    ret = -1;
+  return ret;
+}
+
+/*
+ * fh : IN : file handler
+ * Load the contents of the caches of the constants from the file (written
+ * by mpfr_fpif_export_cache). A cache is not modified if it already has a
+ * value with at least the same precision.
+ * return 0 if successful; if an error occurs, the caches are unchanged.
+ */
+int
+mpfr_fpif_import_cache (FILE *fh)
+{
+  struct ext_data_sum ext = { 0 };
+  unsigned char buf[10];
+  mpfr_t x[MPFR_CACHE_NB_CONST];
+  int inex[MPFR_CACHE_NB_CONST];
+  int id, i, ret = 0;
+
+  if (fh == NULL)
+    return -1;
+
+  ext.base._mpfr_io_fn = read_from_file_sum;
+  ext.fh = fh;
+
+  if (fread (buf, sizeof (mpfr_cache_magic), 1, fh) != 1 ||
+      memcmp (buf, mpfr_cache_magic, sizeof (mpfr_cache_magic)) != 0)
+    return -1;
+
+  for (id = 0; id < MPFR_CACHE_NB_CONST; id++)
+    inex[id] = 2;  /* not read yet */
+
+  for (;;)
+    {
+      unsigned long sum;
+      mpfr_uprec_t p;
+      mpfr_ptr y;
+
+      ext.sum = FNV_OFFSET;
+      if (read_from_file_sum ((ext_data_ptr) &ext, buf, 1) != 1)
+        {
+          ret = -1;
+          break;
+        }
+      id = buf[0];
+      if (id == 0)  /* end of the file */
+        break;
+      if (id > MPFR_CACHE_NB_CONST || inex[id - 1] != 2 ||
+          read_from_file_sum ((ext_data_ptr) &ext, buf, 9) != 1 ||
+          buf[0] > 2)
+        {
+          ret = -1;
+          break;
+        }
+      for (i = 7, p = 0; i >= 0; i--)
+        p = (p << 8) | buf[1 + i];
+      y = x[id - 1];
+      mpfr_init2 (y, MPFR_PREC_MIN);
+      inex[id - 1] = buf[0] == 1 ? 1 : buf[0] == 2 ? -1 : 0;
+      if (mpfr_fpif_import_aux (y, (ext_data_ptr) &ext) != 0 ||
+          (mpfr_uprec_t) MPFR_PREC (y) != p || ! MPFR_IS_PURE_FP (y) ||
+          MPFR_IS_NEG (y) || fread (buf, 4, 1, fh) != 1)
+        {
+          ret = -1;
+          break;
+        }
+      for (i = 3, sum = 0; i >= 0; i--)
+        sum = (sum << 8) | buf[i];
+      if (sum != ext.sum || ! cache_check_value (cache_of_id (id), y))
+        {
+          ret = -1;
+          break;
+        }
+    }
+
+  for (id = 0; id < MPFR_CACHE_NB_CONST; id++)
+    if (inex[id] != 2)
+      {
+        if (ret == 0)
+          mpfr_cache_set_value (cache_of_id (id + 1), x[id], inex[id]);
+        mpfr_clear (x[id]);
+      }
+
+  return ret;
+}
@@ -47,6 +47,7 @@ mpfr_free_local_cache (void)
      the mpz_t pool. */
   mpfr_bernoulli_freecache ();
   mpfr_free_pool ();
+  mpfr_free_arena ();
 }
 
 void
@@ -66,6 +67,8 @@ mpfr_free_cache2 (mpfr_free_cache_t way)
       mpfr_free_const_caches ();
 #endif
     }
+  else if ((unsigned int) way & MPFR_TRIM_POOL)
+    mpfr_trim_pool ();
   if ((unsigned int) way & MPFR_FREE_GLOBAL_CACHE)
     {
 #if defined(MPFR_WANT_SHARED_CACHE)
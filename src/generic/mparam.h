@@ -31,6 +31,17 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_DIVHIGH_TAB 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0
 #endif
 
+/* above these sizes, mpfr_mulhigh_n and mpfr_sqrhigh_n compute the full
+   product; by default, from the FFT thresholds of GMP (the values tuned
+   by GMP when gmp-impl.h is used, otherwise those of mpfr-gmp.h) */
+#ifndef MPFR_MULHIGH_FULL_THRESHOLD
+# define MPFR_MULHIGH_FULL_THRESHOLD MUL_FFT_THRESHOLD /* limbs */
+#endif
+
+#ifndef MPFR_SQRHIGH_FULL_THRESHOLD
+# define MPFR_SQRHIGH_FULL_THRESHOLD SQR_FFT_THRESHOLD /* limbs */
+#endif
+
 #ifndef MPFR_MUL_THRESHOLD
 # define MPFR_MUL_THRESHOLD 20 /* limbs */
 #endif
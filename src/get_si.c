@@ -27,6 +27,7 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
   mpfr_prec_t prec;
   long s;
   mpfr_t x;
+  MPFR_GROUP_DECL (group);
   MPFR_SAVE_EXPO_DECL (expo);
 
   if (MPFR_UNLIKELY (!mpfr_fits_slong_p (f, rnd)))
@@ -48,7 +49,7 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* first round to prec bits */
-  mpfr_init2 (x, prec);
+  MPFR_GROUP_INIT_1 (group, prec, x);
   mpfr_rint (x, f, rnd);
 
   /* The flags from mpfr_rint are the wanted ones. In particular,
@@ -83,7 +84,7 @@ mpfr_get_si (mpfr_srcptr f, mpfr_rnd_t rnd)
       s = MPFR_IS_POS (f) ? u : u <= LONG_MAX ? - (long) u : LONG_MIN;
     }
 
-  mpfr_clear (x);
+  MPFR_GROUP_CLEAR (group);
 
   MPFR_SAVE_EXPO_FREE (expo);
 
@@ -27,6 +27,7 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
   mpfr_prec_t prec;
   unsigned long s;
   mpfr_t x;
+  MPFR_GROUP_DECL (group);
   mp_size_t n;
   mpfr_exp_t exp;
   MPFR_SAVE_EXPO_DECL (expo);
@@ -47,7 +48,7 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
   MPFR_SAVE_EXPO_MARK (expo);
 
   /* first round to prec bits */
-  mpfr_init2 (x, prec);
+  MPFR_GROUP_INIT_1 (group, prec, x);
   mpfr_rint (x, f, rnd);
 
   /* The flags from mpfr_rint are the wanted ones. In particular,
@@ -75,7 +76,7 @@ mpfr_get_ui (mpfr_srcptr f, mpfr_rnd_t rnd)
       s += MPFR_MANT(x)[n - 1] >> (GMP_NUMB_BITS - exp);
     }
 
-  mpfr_clear (x);
+  MPFR_GROUP_CLEAR (group);
 
   MPFR_SAVE_EXPO_FREE (expo);
 
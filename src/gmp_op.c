@@ -27,19 +27,26 @@ If not, see <https://www.gnu.org/licenses/>. */
    one now has mpz_t -> long -> unsigned long -> mpfr_t then mpfr_add
    instead of mpz_t -> mpfr_t then mpfr_add. */
 
-/* Init and set a mpfr_t with enough precision to store a mpz.
-   This function should be called in the extended exponent range. */
-static void
-init_set_z (mpfr_ptr t, mpz_srcptr z)
+/* Return a precision large enough to store z exactly. */
+static mpfr_prec_t
+prec_z (mpz_srcptr z)
 {
   mpfr_prec_t p;
-  int i;
 
   if (mpz_size (z) <= 1)
     p = GMP_NUMB_BITS;
   else
     MPFR_MPZ_SIZEINBASE2 (p, z);
-  mpfr_init2 (t, p);
+  return p;
+}
+
+/* Set a mpfr_t of precision at least prec_z(z) to z.
+   This function should be called in the extended exponent range. */
+static void
+set_z_exact (mpfr_ptr t, mpz_srcptr z)
+{
+  int i;
+
   i = mpfr_set_z (t, z, MPFR_RNDN);
   /* Possible assertion failure in case of overflow. Such cases,
      which imply that z is huge (if the function is called in
@@ -48,21 +55,24 @@ init_set_z (mpfr_ptr t, mpz_srcptr z)
   MPFR_ASSERTN (i == 0);  (void) i; /* use i to avoid a warning */
 }
 
-/* Init, set a mpfr_t with enough precision to store a mpz_t without round,
-   call the function, and clear the allocated mpfr_t  */
+/* Set a temporary mpfr_t with enough precision to store a mpz_t without
+   round, and call the function. The mpfr_t is taken in a group, so that
+   no memory is allocated in general. */
 static int
 foo (mpfr_ptr x, mpfr_srcptr y, mpz_srcptr z, mpfr_rnd_t r,
      int (*f)(mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t))
 {
   mpfr_t t;
   int i;
+  MPFR_GROUP_DECL (group);
   MPFR_SAVE_EXPO_DECL (expo);
 
   MPFR_SAVE_EXPO_MARK (expo);
-  init_set_z (t, z);  /* There should be no exceptions. */
+  MPFR_GROUP_INIT_1 (group, prec_z (z), t);
+  set_z_exact (t, z);  /* There should be no exceptions. */
   i = (*f) (x, y, t, r);
   MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
-  mpfr_clear (t);
+  MPFR_GROUP_CLEAR (group);
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (x, i, r);
 }
@@ -73,13 +83,15 @@ foo2 (mpfr_ptr x, mpz_srcptr y, mpfr_srcptr z, mpfr_rnd_t r,
 {
   mpfr_t t;
   int i;
+  MPFR_GROUP_DECL (group);
   MPFR_SAVE_EXPO_DECL (expo);
 
   MPFR_SAVE_EXPO_MARK (expo);
-  init_set_z (t, y);  /* There should be no exceptions. */
+  MPFR_GROUP_INIT_1 (group, prec_z (y), t);
+  set_z_exact (t, y);  /* There should be no exceptions. */
   i = (*f) (x, t, z, r);
   MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
-  mpfr_clear (t);
+  MPFR_GROUP_CLEAR (group);
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (x, i, r);
 }
@@ -344,8 +356,8 @@ mpfr_add_q (mpfr_ptr y, mpfr_srcptr x, mpq_srcptr z, mpfr_rnd_t rnd_mode)
             }
         }
       MPFR_ZIV_NEXT (loop, p);
-      mpfr_set_prec (t, p);
-      mpfr_set_prec (q, p);
+      mpfr_ziv_set_prec (t, p);
+      mpfr_ziv_set_prec (q, p);
     }
   MPFR_ZIV_FREE (loop);
   mpfr_clear (t);
@@ -440,8 +452,8 @@ mpfr_sub_q (mpfr_ptr y, mpfr_srcptr x, mpq_srcptr z,mpfr_rnd_t rnd_mode)
             }
         }
       MPFR_ZIV_NEXT (loop, p);
-      mpfr_set_prec (t, p);
-      mpfr_set_prec (q, p);
+      mpfr_ziv_set_prec (t, p);
+      mpfr_ziv_set_prec (q, p);
     }
   MPFR_ZIV_FREE (loop);
   mpfr_clear (t);
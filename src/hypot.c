@@ -185,9 +185,9 @@ mpfr_hypot (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
         break;
 
       MPFR_ZIV_NEXT (loop, Nt);
-      mpfr_set_prec (t, Nt);
-      mpfr_set_prec (te, Nt);
-      mpfr_set_prec (ti, Nt);
+      mpfr_ziv_set_prec (t, Nt);
+      mpfr_ziv_set_prec (te, Nt);
+      mpfr_ziv_set_prec (ti, Nt);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -91,10 +91,10 @@ li2_series (mpfr_ptr sum, mpfr_srcptr z, mpfr_rnd_t rnd_mode)
         break;
 
       MPFR_ZIV_NEXT (loop, p);
-      mpfr_set_prec (s, p);
-      mpfr_set_prec (u, p);
-      mpfr_set_prec (v, p);
-      mpfr_set_prec (w, p);
+      mpfr_ziv_set_prec (s, p);
+      mpfr_ziv_set_prec (u, p);
+      mpfr_ziv_set_prec (v, p);
+      mpfr_ziv_set_prec (w, p);
     }
   MPFR_ZIV_FREE (loop);
   mpfr_set (sum, s, rnd_mode);
@@ -294,8 +294,8 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
         next_m:
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (s, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (s, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, s, rnd_mode);
@@ -323,7 +323,7 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (u, m);
+          mpfr_ziv_set_prec (u, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, u, rnd_mode);
@@ -389,9 +389,9 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (s, m);
-          mpfr_set_prec (xx, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (s, m);
+          mpfr_ziv_set_prec (xx, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, s, rnd_mode);
@@ -441,10 +441,10 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (s, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (v, m);
-          mpfr_set_prec (xx, m);
+          mpfr_ziv_set_prec (s, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (v, m);
+          mpfr_ziv_set_prec (xx, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, s, rnd_mode);
@@ -497,10 +497,10 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (s, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (v, m);
-          mpfr_set_prec (xx, m);
+          mpfr_ziv_set_prec (s, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (v, m);
+          mpfr_ziv_set_prec (xx, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, s, rnd_mode);
@@ -538,9 +538,9 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (s, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (xx, m);
+          mpfr_ziv_set_prec (s, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (xx, m);
         }
       MPFR_ZIV_FREE (loop);
       inexact = mpfr_set (y, s, rnd_mode);
@@ -610,10 +610,10 @@ mpfr_li2 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
 
           MPFR_ZIV_NEXT (loop, m);
-          mpfr_set_prec (s, m);
-          mpfr_set_prec (u, m);
-          mpfr_set_prec (v, m);
-          mpfr_set_prec (w, m);
+          mpfr_ziv_set_prec (s, m);
+          mpfr_ziv_set_prec (u, m);
+          mpfr_ziv_set_prec (v, m);
+          mpfr_ziv_set_prec (w, m);
           mpfr_set_prec (xx, m);
         }
       MPFR_ZIV_FREE (loop);
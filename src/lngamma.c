@@ -174,6 +174,7 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
   int compared, inexact;
   mpfr_exp_t err_s, err_t;
   double d;
+  MPFR_GROUP_DECL (group);
   MPFR_SAVE_EXPO_DECL (expo);
   MPFR_ZIV_DECL (loop);
 
@@ -242,9 +243,11 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
       mpfr_t l, h, g;
       int ok, inex1, inex2;
       mpfr_prec_t prec = MPFR_PREC(y) + 14;
-      MPFR_ZIV_DECL (loop);
+      MPFR_ZIV_DECL (loop2);
 
-      MPFR_ZIV_INIT (loop, prec);
+      /* if this loop fails, the loop below is entered in the same call */
+      MPFR_ZIV_SAME_CALL (loop2, loop);
+      MPFR_ZIV_INIT (loop2, prec);
       do
         {
           mpfr_init2 (l, prec);
@@ -290,7 +293,7 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
           mpfr_clear (g);
           if (ok)
             {
-              MPFR_ZIV_FREE (loop);
+              MPFR_ZIV_FREE (loop2);
               MPFR_SAVE_EXPO_FREE (expo);
               return mpfr_check_range (y, inex1, rnd);
             }
@@ -300,20 +303,17 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
              especially when n >> PREC(y).
              Otherwise we would use the reflection formula evaluating x-1,
              which would need precision n. */
-          MPFR_ZIV_NEXT (loop, prec);
+          MPFR_ZIV_NEXT (loop2, prec);
         }
       while (prec <= - MPFR_GET_EXP (z0));
-      MPFR_ZIV_FREE (loop);
+      MPFR_ZIV_FREE (loop2);
     }
 #endif
 
   precy = MPFR_PREC(y);
 
-  mpfr_init2 (s, MPFR_PREC_MIN);
-  mpfr_init2 (t, MPFR_PREC_MIN);
-  mpfr_init2 (u, MPFR_PREC_MIN);
-  mpfr_init2 (v, MPFR_PREC_MIN);
-  mpfr_init2 (z, MPFR_PREC_MIN);
+  /* s, t, u, v, z are set to the working precision w in the loops */
+  MPFR_GROUP_INIT_5 (group, MPFR_PREC_MIN, s, t, u, v, z);
 
   inexact = 0; /* 0 means: result y not set yet */
 
@@ -331,10 +331,7 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
       while (1)
         {
           MPFR_ASSERTD(w >= 3);
-          mpfr_set_prec (s, w);
-          mpfr_set_prec (t, w);
-          mpfr_set_prec (u, w);
-          mpfr_set_prec (v, w);
+          MPFR_GROUP_REPREC_5 (group, w, s, t, u, v, z);
           /* In the following, we write r for a real of absolute value
              at most 2^(-w). Different instances of r may represent different
              values. */
@@ -444,25 +441,24 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
          caching of Bernoulli numbers).
          For only one computation of gamma with large precision, it is better
          to set k to a larger value, say k ~ w. */
-      mpfr_set_prec (s, 53);
-      mpfr_gamma_alpha (s, w);
-      mpfr_set_ui_2exp (s, 4, -4, MPFR_RNDU);
-      mpfr_mul_ui (s, s, w, MPFR_RNDU);
-      if (mpfr_cmp (z0, s) < 0)
-        {
-          mpfr_sub (s, s, z0, MPFR_RNDU);
-          k = mpfr_get_ui (s, MPFR_RNDU);
-          if (k < 3)
-            k = 3;
-        }
-      else
-        k = 3;
+      {
+        MPFR_DECL_INIT (a, 53);
 
-      mpfr_set_prec (s, w);
-      mpfr_set_prec (t, w);
-      mpfr_set_prec (u, w);
-      mpfr_set_prec (v, w);
-      mpfr_set_prec (z, w);
+        mpfr_gamma_alpha (a, w);
+        mpfr_set_ui_2exp (a, 4, -4, MPFR_RNDU);
+        mpfr_mul_ui (a, a, w, MPFR_RNDU);
+        if (mpfr_cmp (z0, a) < 0)
+          {
+            mpfr_sub (a, a, z0, MPFR_RNDU);
+            k = mpfr_get_ui (a, MPFR_RNDU);
+            if (k < 3)
+              k = 3;
+          }
+        else
+          k = 3;
+      }
+
+      MPFR_GROUP_REPREC_5 (group, w, s, t, u, v, z);
 
       mpfr_add_ui (z, z0, k, MPFR_RNDN);
       /* z = (z0+k)*(1+t1) with |t1| <= 2^(-w) */
@@ -568,20 +564,30 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
         unsigned long j, i, p;
         mpfr_t *Z;
         mpz_t *c;
+        mp_size_t wn = MPFR_PREC2LIMBS (w);
+        MPFR_GROUP_DECL (zgroup);
+        MPFR_TMP_DECL (marker);
         for (j = 2; (j + 1) * (j + 1) < k; j++);
-        /* Z[i] stores z0^i for i <= j */
-        Z = (mpfr_t *) mpfr_allocate_func ((j + 1) * sizeof (mpfr_t));
+        /* Z[i] stores z0^i for i <= j; their significands are taken in
+           a single block zgroup (from the arena if possible), which is
+           cleared before any reallocation of the outer group */
+        MPFR_TMP_MARK (marker);
+        Z = (mpfr_t *) MPFR_TMP_ALLOC ((j + 1) * sizeof (mpfr_t));
+        MPFR_GROUP_ALLOC (zgroup, (j - 1) * wn);
         for (i = 2; i <= j; i++)
-          mpfr_init2 (Z[i], w);
+          MPFR_TMP_INIT1 (zgroup.mant + (i - 2) * wn, Z[i], w);
         mpfr_sqr (Z[2], z0, MPFR_RNDN);
         for (i = 3; i <= j; i++)
           if ((i & 1) == 0)
             mpfr_sqr (Z[i], Z[i >> 1], MPFR_RNDN);
           else
             mpfr_mul (Z[i], Z[i-1], z0, MPFR_RNDN);
-        c = (mpz_t *) mpfr_allocate_func ((j + 1) * sizeof (mpz_t));
+        c = (mpz_t *) MPFR_TMP_ALLOC ((j + 1) * sizeof (mpz_t));
+        /* the c[i] are at most (k+1)^j: take them large enough from the
+           mpz_t pool (with one more limb, needed by mpz_add and mpz_mul_ui),
+           so that they do not need to be reallocated */
         for (i = 0; i <= j; i++)
-          mpz_init (c[i]);
+          mpz_init2 (c[i], j * MPFR_INT_CEIL_LOG2 (k + 1) + GMP_NUMB_BITS);
         for (; l + j <= k; l += j)
           {
             /* c[i] is the coefficient of x^i in (x+l)*...*(x+l+j-1) */
@@ -611,10 +617,8 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
           }
         for (i = 0; i <= j; i++)
           mpz_clear (c[i]);
-        mpfr_free_func (c, (j + 1) * sizeof (mpz_t));
-        for (i = 2; i <= j; i++)
-          mpfr_clear (Z[i]);
-        mpfr_free_func (Z, (j + 1) * sizeof (mpfr_t));
+        MPFR_GROUP_CLEAR (zgroup);
+        MPFR_TMP_FREE (marker);
       }
 #endif /* end of fast argument reconstruction */
 
@@ -703,11 +707,7 @@ GAMMA_FUNC (mpfr_ptr y, mpfr_srcptr z0, mpfr_rnd_t rnd)
     inexact = mpfr_set (y, s, rnd);
   MPFR_ZIV_FREE (loop);
 
-  mpfr_clear (s);
-  mpfr_clear (t);
-  mpfr_clear (u);
-  mpfr_clear (v);
-  mpfr_clear (z);
+  MPFR_GROUP_CLEAR (group);
 
   MPFR_SAVE_EXPO_FREE (expo);
   return mpfr_check_range (y, inexact, rnd);
@@ -132,8 +132,8 @@ mpfr_log10 (mpfr_ptr r, mpfr_srcptr a, mpfr_rnd_t rnd_mode)
 
         /* actualization of the precision */
         MPFR_ZIV_NEXT (loop, Nt);
-        mpfr_set_prec (t, Nt);
-        mpfr_set_prec (tt, Nt);
+        mpfr_ziv_set_prec (t, Nt);
+        mpfr_ziv_set_prec (tt, Nt);
       }
     MPFR_ZIV_FREE (loop);
 
@@ -189,8 +189,8 @@ mpfr_log10p1 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
         goto end;
 
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (t, prec);
-      mpfr_set_prec (lg10, prec);
+      mpfr_ziv_set_prec (t, prec);
+      mpfr_ziv_set_prec (lg10, prec);
     }
   inexact = mpfr_set (y, t, rnd_mode);
 
@@ -151,8 +151,8 @@ mpfr_log2p1 (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
         }
 
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (t, prec);
-      mpfr_set_prec (lg2, prec);
+      mpfr_ziv_set_prec (t, prec);
+      mpfr_ziv_set_prec (lg2, prec);
     }
   inexact = mpfr_set (y, t, rnd_mode);
 
@@ -313,7 +313,7 @@ mpfr_allocate_func (size_t alloc_size)
   MPFR_ASSERTD (alloc_size > 0);
   /* Always calling with the 3 arguments smooths branch prediction. */
   mp_get_memory_functions (&allocate_func, &reallocate_func, &free_func);
-  return (*allocate_func) (alloc_size);
+  return (*allocate_func) (mpfr_count_alloc (alloc_size));
 }
 
 MPFR_HOT_FUNCTION_ATTR void *
@@ -326,7 +326,8 @@ mpfr_reallocate_func (void * ptr, size_t old_size, size_t new_size)
   MPFR_ASSERTD (new_size > 0);
   /* Always calling with the 3 arguments smooths branch prediction. */
   mp_get_memory_functions (&allocate_func, &reallocate_func, &free_func);
-  return (*reallocate_func) (ptr, old_size, new_size);
+  return (*reallocate_func) (ptr, old_size,
+                             mpfr_count_realloc (old_size, new_size));
 }
 
 MPFR_HOT_FUNCTION_ATTR void
@@ -91,8 +91,9 @@ extern "C" {
 
 #ifdef MPFR_HAVE_GMP_IMPL  /* with gmp build */
 
-#define mpfr_allocate_func   (*__gmp_allocate_func)
-#define mpfr_reallocate_func (*__gmp_reallocate_func)
+#define mpfr_allocate_func(s) (*__gmp_allocate_func) (mpfr_count_alloc (s))
+#define mpfr_reallocate_func(p,o,n) \
+  (*__gmp_reallocate_func) (p, o, mpfr_count_realloc (o, n))
 #define mpfr_free_func       (*__gmp_free_func)
 
 #else  /* without gmp build (gmp-impl.h replacement) */
@@ -165,6 +166,10 @@ extern "C" {
 #define MUL_FFT_THRESHOLD 8448
 #endif
 
+#ifndef SQR_FFT_THRESHOLD
+#define SQR_FFT_THRESHOLD MUL_FFT_THRESHOLD
+#endif
+
 /* If mul_basecase or mpn_sqr_basecase are not exported, used mpn_mul instead */
 #ifndef mpn_mul_basecase
 # define mpn_mul_basecase(dst,s1,n1,s2,n2) mpn_mul((dst),(s1),(n1),(s2),(n2))
@@ -270,6 +275,13 @@ __MPFR_DECLSPEC mp_limb_t __gmpn_rsblsh1_n (mp_limb_t*, mp_limb_t*, mp_limb_t*,
 #endif
 #endif
 
+#if defined(WANT_GMP_INTERNALS) && defined(HAVE___GMPN_DIV_Q)
+#ifndef __gmpn_div_q
+__MPFR_DECLSPEC void __gmpn_div_q (mp_limb_t*, const mp_limb_t*, mp_size_t,
+                                   const mp_limb_t*, mp_size_t, mp_limb_t*);
+#endif
+#endif
+
 /* Definitions related to temporary memory allocation */
 
 struct tmp_marker
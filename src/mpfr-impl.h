@@ -87,7 +87,7 @@ If not, see <https://www.gnu.org/licenses/>. */
    no longer used, as they sometimes gave incorrect information about
    the support of thread-local variables. A configure check is now done.
    Also defines macros related to thread locking. */
-#if defined(MPFR_WANT_SHARED_CACHE)
+#if defined(MPFR_WANT_SHARED_CACHE) || defined(MPFR_WANT_PARALLEL)
 # define MPFR_NEED_THREAD_LOCK 1
 #endif
 #include "mpfr-thread.h"
@@ -145,6 +145,29 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #endif
 
+/* With --enable-fmv, use the compiler builtins instead of the asm code of
+   longlong.h, which would be the same in all the variants, so that mulx,
+   lzcnt and tzcnt can be used in the variants for the processors that
+   support them. */
+#if defined(MPFR_WANT_FMV) && defined(umul_ppmm) && GMP_NUMB_BITS == 64
+# undef umul_ppmm
+# define umul_ppmm(w1, w0, u, v)                                        \
+  do {                                                                  \
+    __extension__ unsigned __int128 __p =                               \
+      (unsigned __int128) (mp_limb_t) (u) * (mp_limb_t) (v);            \
+    (w0) = (mp_limb_t) __p;                                             \
+    (w1) = (mp_limb_t) (__p >> 64);                                     \
+  } while (0)
+# undef count_leading_zeros
+# undef COUNT_LEADING_ZEROS_0
+# define count_leading_zeros(count, x)                                  \
+  ((count) = __builtin_clzll ((unsigned long long) (x)))
+# undef count_trailing_zeros
+# undef COUNT_TRAILING_ZEROS_0
+# define count_trailing_zeros(count, x)                                 \
+  ((count) = __builtin_ctzll ((unsigned long long) (x)))
+#endif
+
 #undef MPFR_NEED_LONGLONG_H
 
 
@@ -192,6 +215,17 @@ If not, see <https://www.gnu.org/licenses/>. */
 # define MPFR_HOT_FUNCTION_ATTR
 #endif
 
+/* With --enable-fmv, the functions with this attribute are compiled for
+   several levels of the x86-64 psABI, the variant being selected when the
+   library is loaded, according to the processor. The list of levels must
+   be kept in sync with mpfr_buildopt_fmv_variant. */
+#ifdef MPFR_WANT_FMV
+# define MPFR_FMV_FUNCTION_ATTR \
+  __attribute__ ((target_clones ("arch=x86-64-v3", "arch=x86-64-v2", "default")))
+#else
+# define MPFR_FMV_FUNCTION_ATTR
+#endif
+
 /* The cold attribute on functions is used to inform the compiler
    that the function is unlikely to be executed. */
 #if __MPFR_GNUC(4,3)
@@ -235,16 +269,57 @@ extern "C" {
 # define MPFR_CACHE_ATTR MPFR_THREAD_ATTR
 #endif
 
+/* With a shared cache, the value of a cache is read without any lock if
+   the __atomic builtins (GCC 4.7+ and compatible compilers) are available,
+   and the memory of an old value is reclaimed once all the readers that
+   may use it are done; the readers are counted in MPFR_CACHE_SLOTS slots
+   per epoch parity, each one in its own cache line, to avoid contention:
+   the padding gives each slot the size of a cache line, and the alignment
+   (thus also of the array of slots in the cache) ensures that two slots
+   never share a line. See cache.c for the details. */
+#if defined(MPFR_WANT_SHARED_CACHE) && defined(__ATOMIC_SEQ_CST)
+# define MPFR_CACHE_LOCK_FREE 1
+# define MPFR_CACHE_SLOTS 16
+# define MPFR_CACHE_LINE_SIZE 64
+typedef struct {
+  unsigned long n;
+  char pad[MPFR_CACHE_LINE_SIZE - sizeof (unsigned long)];
+} __attribute__ ((aligned (MPFR_CACHE_LINE_SIZE))) mpfr_cache_readers_t;
+#endif
+
+/* A value of a cache, which is never modified once it has been published
+   in the cache: a new value is allocated for each recomputation. */
+typedef struct {
+  mpfr_t x;
+  int inexact;
+} mpfr_cache_val_t;
+
+/* State of a binary splitting for the terms of index 0 to n-1 of a series,
+   which can be extended to more terms (see bsplit.c). */
+typedef struct {
+  unsigned long n;
+  mpz_t T, P, Q;
+} mpfr_bs_state_t;
+
 /* Note: The following structure and types depend on the MPFR build options
    (including compiler options), due to the various locking methods affecting
    MPFR_DEFERRED_INIT_SLAVE_DECL and MPFR_LOCK_DECL. But since this is only
    internal, that's OK. */
 struct __gmpfr_cache_s {
-  mpfr_t x;
-  int inexact;
+  mpfr_cache_val_t *val;  /* NULL if there is no value yet */
   int (*func)(mpfr_ptr, mpfr_rnd_t);
+  /* For a constant computed by a binary splitting, the function used to
+     compute the values of the cache, which extends the state bs of the
+     binary splitting (NULL if not computed yet) instead of starting from
+     scratch when more precision is needed; func_bs is NULL otherwise. */
+  int (*func_bs)(mpfr_ptr, mpfr_rnd_t, mpfr_bs_state_t **);
+  mpfr_bs_state_t *bs;
   MPFR_DEFERRED_INIT_SLAVE_DECL()
   MPFR_LOCK_DECL(lock)
+#ifdef MPFR_CACHE_LOCK_FREE
+  unsigned int epoch;
+  mpfr_cache_readers_t readers[2][MPFR_CACHE_SLOTS];
+#endif
 };
 typedef struct __gmpfr_cache_s mpfr_cache_t[1];
 typedef struct __gmpfr_cache_s *mpfr_cache_ptr;
@@ -1211,6 +1286,24 @@ typedef uintmax_t mpfr_ueexp_t;
 #define VSIGN(I) (((I) > 0) - ((I) < 0))
 #define SAME_SIGN(I1,I2) (VSIGN (I1) == VSIGN (I2))
 
+/* Loop of the vector forms of the basic operations (mpfr_add_vec, etc.):
+   for each I from 0 to N-1, store in INEX[I] the ternary value of KERNEL
+   when R[I], A[I] and B[I] all have precision P and A[I] and B[I] are
+   regular numbers, and of FALLBACK otherwise. KERNEL and FALLBACK are
+   expressions depending on I. */
+#define MPFR_VEC_LOOP(I,N,INEX,R,A,B,P,KERNEL,FALLBACK)                 \
+  do                                                                    \
+    {                                                                   \
+      for ((I) = 0; (I) < (N); (I)++)                                   \
+        (INEX)[I] =                                                     \
+          MPFR_LIKELY (MPFR_PREC ((R)[I]) == (P) &&                     \
+                       MPFR_PREC ((A)[I]) == (P) &&                     \
+                       MPFR_PREC ((B)[I]) == (P) &&                     \
+                       ! MPFR_ARE_SINGULAR ((A)[I], (B)[I])) ?          \
+          (KERNEL) : (FALLBACK);                                        \
+    }                                                                   \
+  while (0)
+
 
 /******************************************************
  ***************  Rounding mode macros  ***************
@@ -1436,11 +1529,16 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
    expanded and one cannot put a pragma in the contents of a #define.
 */
 #define MPFR_DECL_INIT_CACHE(_cache,_func)                           \
+  MPFR_DECL_INIT_CACHE_BS(_cache,_func,0)
+
+/* For a constant computed by a binary splitting, see struct
+   __gmpfr_cache_s. */
+#define MPFR_DECL_INIT_CACHE_BS(_cache,_func,_func_bs)               \
   MPFR_DEFERRED_INIT_MASTER_DECL(_func,                              \
                                  MPFR_LOCK_INIT( (_cache)->lock),    \
                                  MPFR_LOCK_CLEAR((_cache)->lock))    \
   MPFR_CACHE_ATTR mpfr_cache_t _cache = {{                           \
-      {{ 0, MPFR_SIGN_POS, 0, (mp_limb_t *) 0 }}, 0, _func           \
+      (mpfr_cache_val_t *) 0, _func, _func_bs, (mpfr_bs_state_t *) 0 \
       MPFR_DEFERRED_INIT_SLAVE_VALUE(_func)                          \
     }};                                                              \
   MPFR_MAKE_VARFCT (mpfr_cache_t,_cache)
@@ -1451,6 +1549,62 @@ typedef union { mp_size_t s; mp_limb_t l; } mpfr_size_limb_t;
 
 #include "mparam.h"
 
+/* The above values are only the default values of the tuning parameters,
+   which can be changed at run time (see thresholds.c). Unless
+   MPFR_TUNE_DONT_REDEFINE is defined (in thresholds.c itself, and in the
+   tuning programs, which redefine some of them), the macros are redefined
+   to the current values, and mulders.c uses the current tables. */
+
+/* maximum size of the tables for mpfr_mulhigh_n, mpfr_sqrhigh_n and
+   mpfr_divhigh_n */
+#define MPFR_TUNE_TAB_SIZE_MAX 1024
+
+typedef struct {
+  mp_size_t size;
+  short k[MPFR_TUNE_TAB_SIZE_MAX];
+} mpfr_tune_tab_t;
+
+typedef struct {
+  mpfr_prec_t mul, sqr, div;       /* in limbs */
+  mpfr_prec_t mulhigh_full, sqrhigh_full; /* in limbs */
+  mpfr_prec_t exp_2, exp, sincos;  /* in bits */
+  long ai1, ai2, ai3;
+  mpfr_tune_tab_t mulhigh, sqrhigh, divhigh;
+} mpfr_tune_t;
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+__MPFR_DECLSPEC extern mpfr_tune_t __gmpfr_tune;
+#if defined (__cplusplus)
+}
+#endif
+
+#ifndef MPFR_TUNE_DONT_REDEFINE
+# undef MPFR_MUL_THRESHOLD
+# undef MPFR_SQR_THRESHOLD
+# undef MPFR_DIV_THRESHOLD
+# undef MPFR_MULHIGH_FULL_THRESHOLD
+# undef MPFR_SQRHIGH_FULL_THRESHOLD
+# undef MPFR_EXP_2_THRESHOLD
+# undef MPFR_EXP_THRESHOLD
+# undef MPFR_SINCOS_THRESHOLD
+# undef MPFR_AI_THRESHOLD1
+# undef MPFR_AI_THRESHOLD2
+# undef MPFR_AI_THRESHOLD3
+# define MPFR_MUL_THRESHOLD    (__gmpfr_tune.mul)
+# define MPFR_SQR_THRESHOLD    (__gmpfr_tune.sqr)
+# define MPFR_DIV_THRESHOLD    (__gmpfr_tune.div)
+# define MPFR_MULHIGH_FULL_THRESHOLD (__gmpfr_tune.mulhigh_full)
+# define MPFR_SQRHIGH_FULL_THRESHOLD (__gmpfr_tune.sqrhigh_full)
+# define MPFR_EXP_2_THRESHOLD  (__gmpfr_tune.exp_2)
+# define MPFR_EXP_THRESHOLD    (__gmpfr_tune.exp)
+# define MPFR_SINCOS_THRESHOLD (__gmpfr_tune.sincos)
+# define MPFR_AI_THRESHOLD1    (__gmpfr_tune.ai1)
+# define MPFR_AI_THRESHOLD2    (__gmpfr_tune.ai2)
+# define MPFR_AI_THRESHOLD3    (__gmpfr_tune.ai3)
+#endif
+
 
 /******************************************************
  ******************  Useful macros  *******************
@@ -1761,6 +1915,60 @@ do {                                                                  \
 /* Addition with carry (detected by GCC and other good compilers). */
 #define ADD_LIMB(u,v,c) ((u) += (v), (c) = (u) < (v))
 
+/* MPFR_ADDC(s,co,a,b,ci) sets s to a + b + ci and co to the carry out,
+   MPFR_SUBB(d,bo,a,b,bi) sets d to a - b - bi and bo to the borrow out,
+   where ci, co, bi, bo are 0 or 1, so that they can be chained on the
+   limbs of a number. Compilers do not always recognize the carry chains
+   in the portable versions MPFR_ADDC_GENERIC and MPFR_SUBB_GENERIC, thus
+   the intrinsics detected by configure are used when limbs have 64 bits.
+   The arguments may be evaluated several times. */
+#define MPFR_ADDC_GENERIC(s,co,a,b,ci)                  \
+  do {                                                  \
+    mp_limb_t _t = (a) + (b);                           \
+    mp_limb_t _c = _t < (b);                            \
+    (s) = _t + (ci);                                    \
+    (co) = _c | ((s) < _t);                             \
+  } while (0)
+#define MPFR_SUBB_GENERIC(d,bo,a,b,bi)                  \
+  do {                                                  \
+    mp_limb_t _a = (a), _t = _a - (b);                  \
+    mp_limb_t _c = _t > _a;                             \
+    (d) = _t - (bi);                                    \
+    (bo) = _c | (_t < (mp_limb_t) (bi));                \
+  } while (0)
+
+#if GMP_NUMB_BITS == 64 && defined(MPFR_HAVE_BUILTIN_ADDCLL)
+# define MPFR_ADDC(s,co,a,b,ci)                                 \
+  do {                                                          \
+    unsigned long long _co;                                     \
+    (s) = __builtin_addcll ((a), (b), (ci), &_co);              \
+    (co) = _co;                                                 \
+  } while (0)
+# define MPFR_SUBB(d,bo,a,b,bi)                                 \
+  do {                                                          \
+    unsigned long long _bo;                                     \
+    (d) = __builtin_subcll ((a), (b), (bi), &_bo);              \
+    (bo) = _bo;                                                 \
+  } while (0)
+#elif GMP_NUMB_BITS == 64 && defined(MPFR_HAVE_ADDCARRY_U64)
+# include <x86intrin.h>
+# define MPFR_ADDC(s,co,a,b,ci)                                 \
+  do {                                                          \
+    unsigned long long _s;                                      \
+    (co) = _addcarry_u64 ((unsigned char) (ci), (a), (b), &_s); \
+    (s) = _s;                                                   \
+  } while (0)
+# define MPFR_SUBB(d,bo,a,b,bi)                                 \
+  do {                                                          \
+    unsigned long long _d;                                      \
+    (bo) = _subborrow_u64 ((unsigned char) (bi), (a), (b), &_d); \
+    (d) = _d;                                                   \
+  } while (0)
+#else
+# define MPFR_ADDC(s,co,a,b,ci) MPFR_ADDC_GENERIC(s,co,a,b,ci)
+# define MPFR_SUBB(d,bo,a,b,bi) MPFR_SUBB_GENERIC(d,bo,a,b,bi)
+#endif
+
 /* umul_hi(h, x, y) puts in h the high part of x*y */
 /* MPFR_NEED_LONGLONG_H needs to be defined to use it. */
 #define umul_hi(h, x, y)                        \
@@ -2114,12 +2322,93 @@ typedef struct {
 #define MPFR_INC_PREC(P,X) \
   (MPFR_ASSERTN ((X) <= MPFR_PREC_MAX - (P)), (P) += (X))
 
+/* Per-thread counters of the Ziv loops (see counters.c), always enabled:
+   MPFR_ZIV_DECL declares a thread-local node for the loop, MPFR_ZIV_INIT
+   counts a loop entered and its first iteration, MPFR_ZIV_NEXT a failure
+   and the next iteration, and MPFR_ZIV_FREE adds the cycles and the bytes
+   since MPFR_ZIV_INIT. The cycles are only counted if MPFR_HAVE_CYCLES is
+   defined. The counters are in the node of the first loop of the function
+   that has been entered (owner), so that a function with several Ziv loops
+   has a single entry.
+   A call is counted by the first MPFR_ZIV_INIT of the loop variable, which
+   sets the local marker _x ## _call; a loop variable that may be entered
+   in the same call as another one _y of the same function must share its
+   marker with MPFR_ZIV_SAME_CALL (_x, _y), before entering the loop. */
+typedef struct mpfr_counters_node {
+  mpfr_counters_t c;
+  struct mpfr_counters_node *next;
+  struct mpfr_counters_node *owner;  /* NULL until the loop is entered */
+} mpfr_counters_node_t;
+
+#if __MPFR_GNUC(4,5) && (defined (__i386__) || defined (__x86_64__))
+# define MPFR_HAVE_CYCLES 1
+typedef unsigned long long mpfr_cycles_t;
+# define MPFR_CYCLES() ((mpfr_cycles_t) __builtin_ia32_rdtsc ())
+#elif defined (__GNUC__) && defined (__aarch64__)
+/* The cycle counter PMCCNTR_EL0 is usually not readable at EL0, thus use
+   the virtual counter, which ticks at a fixed frequency (CNTFRQ_EL0). */
+# define MPFR_HAVE_CYCLES 1
+typedef unsigned long long mpfr_cycles_t;
+# define MPFR_CYCLES()                                                  \
+  (__extension__ ({ mpfr_cycles_t _t;                                   \
+      __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (_t)); _t; }))
+#elif defined (_MSC_VER) && (defined (_M_IX86) || defined (_M_X64))
+# include <intrin.h>
+# define MPFR_HAVE_CYCLES 1
+typedef unsigned __int64 mpfr_cycles_t;
+# define MPFR_CYCLES() ((mpfr_cycles_t) __rdtsc ())
+#else
+typedef unsigned long mpfr_cycles_t;
+# define MPFR_CYCLES() ((mpfr_cycles_t) 0)
+#endif
+
+#if __MPFR_STDC (199901L) || defined (__GNUC__)
+# define MPFR_FUNC_NAME __func__
+#else
+# define MPFR_FUNC_NAME __FILE__
+#endif
+
+#define MPFR_ZIV_COUNTERS_DECL(_x)                                      \
+  static MPFR_THREAD_ATTR mpfr_counters_node_t _x ## _node;             \
+  mpfr_cycles_t _x ## _t0 = 0;                                          \
+  double _x ## _b0 = -1.0;                                              \
+  int _x ## _call = 0, *_x ## _callp = &_x ## _call
+#define MPFR_ZIV_COUNTERS_INIT(_x)                                      \
+  (_x ## _b0 = mpfr_ziv_counters_start (&_x ## _node, MPFR_FUNC_NAME,   \
+                                        _x ## _callp),                  \
+   _x ## _t0 = MPFR_CYCLES ())
+#define MPFR_ZIV_COUNTERS_NEXT(_x)                                      \
+  (_x ## _node.owner->c.iterations ++, _x ## _node.owner->c.failures ++)
+#define MPFR_ZIV_COUNTERS_FREE(_x)                                      \
+  do                                                                    \
+    if (_x ## _b0 >= 0)                                                 \
+      mpfr_ziv_counters_stop (&_x ## _node, _x ## _t0, _x ## _b0);      \
+  while (0)
+#define MPFR_ZIV_SAME_CALL(_x, _y) ((void) (_x ## _callp = _y ## _callp))
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+__MPFR_DECLSPEC double mpfr_ziv_counters_start (mpfr_counters_node_t *,
+                                                const char *, int *);
+__MPFR_DECLSPEC void mpfr_ziv_counters_stop (mpfr_counters_node_t *,
+                                             mpfr_cycles_t, double);
+__MPFR_DECLSPEC size_t mpfr_count_alloc (size_t);
+__MPFR_DECLSPEC size_t mpfr_count_realloc (size_t, size_t);
+
+#if defined(__cplusplus)
+}
+#endif
+
 #ifndef MPFR_USE_LOGGING
 
-#define MPFR_ZIV_DECL(_x) mpfr_prec_t _x
-#define MPFR_ZIV_INIT(_x, _p) (_x) = GMP_NUMB_BITS
-#define MPFR_ZIV_NEXT(_x, _p) (MPFR_INC_PREC (_p, _x), (_x) = (_p)/2)
-#define MPFR_ZIV_FREE(x)
+#define MPFR_ZIV_DECL(_x) mpfr_prec_t _x; MPFR_ZIV_COUNTERS_DECL (_x)
+#define MPFR_ZIV_INIT(_x, _p)                                           \
+  ((_x) = GMP_NUMB_BITS, MPFR_ZIV_COUNTERS_INIT (_x))
+#define MPFR_ZIV_NEXT(_x, _p)                                           \
+  (MPFR_INC_PREC (_p, _x), (_x) = (_p)/2, MPFR_ZIV_COUNTERS_NEXT (_x))
+#define MPFR_ZIV_FREE(_x) MPFR_ZIV_COUNTERS_FREE (_x)
 
 #else
 
@@ -2140,6 +2429,7 @@ typedef struct {
 #define MPFR_ZIV_DECL(_x)                                               \
   mpfr_prec_t _x;                                                       \
   int _x ## _cpt = 1;                                                   \
+  MPFR_ZIV_COUNTERS_DECL (_x);                                          \
   static unsigned long  _x ## _loop = 0, _x ## _bad = 0;                \
   static const char *_x ## _fname = __func__;                           \
   auto void __attribute__ ((destructor)) x ## _f  (void);               \
@@ -2158,6 +2448,7 @@ typedef struct {
   do                                                                    \
     {                                                                   \
       (_x) = GMP_NUMB_BITS;                                             \
+      MPFR_ZIV_COUNTERS_INIT (_x);                                      \
       if (mpfr_log_level >= 0)                                          \
         _x ## _loop ++;                                                 \
       LOG_PRINT (MPFR_LOG_ZIV_F, "%s:ZIV 1st prec=%Pd\n",               \
@@ -2170,6 +2461,7 @@ typedef struct {
     {                                                                   \
       MPFR_INC_PREC (_p, _x);                                           \
       (_x) = (_p) / 2;                                                  \
+      MPFR_ZIV_COUNTERS_NEXT (_x);                                      \
       if (mpfr_log_level >= 0)                                          \
         _x ## _bad += (_x ## _cpt == 1);                                \
       _x ## _cpt ++;                                                    \
@@ -2180,9 +2472,12 @@ typedef struct {
 
 #define MPFR_ZIV_FREE(_x)                                               \
   do                                                                    \
-    if (_x ## _cpt > 1)                                                 \
-      LOG_PRINT (MPFR_LOG_ZIV_F, "%s:ZIV %d loops\n",                   \
-                 __func__, _x ## _cpt);                                 \
+    {                                                                   \
+      MPFR_ZIV_COUNTERS_FREE (_x);                                      \
+      if (_x ## _cpt > 1)                                               \
+        LOG_PRINT (MPFR_LOG_ZIV_F, "%s:ZIV %d loops\n",                 \
+                   __func__, _x ## _cpt);                               \
+    }                                                                   \
   while (0)
 
 #endif
@@ -2317,9 +2612,28 @@ __MPFR_DECLSPEC extern unsigned int mpfr_log_type;
 # define MPFR_GROUP_STATIC_SIZE 16
 #endif
 
+/* The groups that do not fit in tab are taken from a limb arena local to
+   the thread (see arena.c), of at most MPFR_ARENA_MAX_SIZE limbs, and from
+   the heap otherwise. The arena is disabled when MPFR_ARENA_MAX_SIZE is 0,
+   in particular by default when MPFR_GROUP_STATIC_SIZE is 0 (see below).
+   The groups that are taken from the arena must be cleared in the reverse
+   order of their initialization, and only the last one can be reallocated
+   with MPFR_GROUP_REPREC_*. This is always the case for groups local to a
+   function. */
+#ifndef MPFR_ARENA_MAX_SIZE
+# if MPFR_GROUP_STATIC_SIZE != 0
+#  define MPFR_ARENA_MAX_SIZE 16384
+# else
+#  define MPFR_ARENA_MAX_SIZE 0
+# endif
+#endif
+
 struct mpfr_group_t {
   size_t     alloc;
   mp_limb_t *mant;
+#if MPFR_ARENA_MAX_SIZE != 0
+  mp_size_t  mark;
+#endif
 #if MPFR_GROUP_STATIC_SIZE != 0
   mp_limb_t  tab[MPFR_GROUP_STATIC_SIZE];
 #else
@@ -2337,6 +2651,29 @@ struct mpfr_group_t {
 #endif
 };
 
+/* Set (g).mant to n limbs from the arena if possible (then (g).alloc = 0),
+   from the heap otherwise (then (g).alloc is the size in bytes). */
+#if MPFR_ARENA_MAX_SIZE != 0
+# define MPFR_GROUP_ALLOC(g, n) do {                                    \
+ (g).mark = mpfr_arena_mark ();                                         \
+ (g).mant = mpfr_arena_alloc (n);                                       \
+ if ((g).mant != NULL)                                                  \
+   (g).alloc = 0;                                                       \
+ else                                                                   \
+   {                                                                    \
+     (g).alloc = (n) * sizeof (mp_limb_t);                              \
+     (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);           \
+   }                                                                    \
+ } while (0)
+# define MPFR_GROUP_IN_ARENA(g) ((g).alloc == 0 && (g).mant != (g).tab)
+#else
+# define MPFR_GROUP_ALLOC(g, n) do {                                    \
+ (g).alloc = (n) * sizeof (mp_limb_t);                                  \
+ (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);               \
+ } while (0)
+# define MPFR_GROUP_IN_ARENA(g) 0
+#endif
+
 #define MPFR_GROUP_DECL(g) struct mpfr_group_t g
 #define MPFR_GROUP_CLEAR(g) do {                                 \
  MPFR_LOG_MSG (("GROUP_CLEAR: ptr = 0x%lX, size = %lu\n",        \
@@ -2345,7 +2682,10 @@ struct mpfr_group_t {
  if ((g).alloc != 0) {                                           \
    MPFR_ASSERTD ((g).mant != (g).tab);                           \
    mpfr_free_func ((g).mant, (g).alloc);                         \
- }} while (0)
+ }                                                               \
+ else if (MPFR_GROUP_IN_ARENA (g))                               \
+   mpfr_arena_release ((g).mark);                                \
+ } while (0)
 
 #define MPFR_GROUP_INIT_TEMPLATE(g, prec, num, handler) do {            \
  mpfr_prec_t _prec = (prec);                                            \
@@ -2355,10 +2695,7 @@ struct mpfr_group_t {
    mpfr_abort_prec_max ();                                              \
  _size = MPFR_PREC2LIMBS (_prec);                                       \
  if (_size * (num) > MPFR_GROUP_STATIC_SIZE)                            \
-   {                                                                    \
-     (g).alloc = (num) * _size * sizeof (mp_limb_t);                    \
-     (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);           \
-   }                                                                    \
+   MPFR_GROUP_ALLOC (g, (num) * _size);                                 \
  else                                                                   \
    {                                                                    \
      (g).alloc = 0;                                                     \
@@ -2405,12 +2742,20 @@ struct mpfr_group_t {
  if (MPFR_UNLIKELY (_prec > MPFR_PREC_MAX))                             \
    mpfr_abort_prec_max ();                                              \
  _size = MPFR_PREC2LIMBS (_prec);                                       \
- (g).alloc = (num) * _size * sizeof (mp_limb_t);                        \
- if (_oalloc == 0)                                                      \
-   (g).mant = (mp_limb_t *) mpfr_allocate_func ((g).alloc);             \
+ if (_oalloc != 0)                                                      \
+   {                                                                    \
+     (g).alloc = (num) * _size * sizeof (mp_limb_t);                    \
+     (g).mant = (mp_limb_t *)                                           \
+       mpfr_reallocate_func ((g).mant, _oalloc, (g).alloc);             \
+   }                                                                    \
  else                                                                   \
-   (g).mant = (mp_limb_t *)                                             \
-     mpfr_reallocate_func ((g).mant, _oalloc, (g).alloc);               \
+   {                                                                    \
+     /* The old limbs are the last ones of the arena (if any): the new  \
+        ones are taken from the same place when they fit. */            \
+     if (MPFR_GROUP_IN_ARENA (g))                                       \
+       mpfr_arena_release ((g).mark);                                   \
+     MPFR_GROUP_ALLOC (g, (num) * _size);                               \
+   }                                                                    \
  MPFR_LOG_MSG (("GROUP_REPREC: newptr = 0x%lX, newsize = %lu\n",        \
                 (unsigned long) (g).mant, (unsigned long) (g).alloc));  \
  handler;                                                               \
@@ -2456,6 +2801,8 @@ MPFR_COLD_FUNCTION_ATTR __MPFR_DECLSPEC int
 
 __MPFR_DECLSPEC int mpfr_add1 (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sub1 (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_add1_inplace (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
+                                       int, int, mpfr_rnd_t, int *);
 __MPFR_DECLSPEC int mpfr_add1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
                                  mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sub1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr,
@@ -2530,6 +2877,15 @@ __MPFR_DECLSPEC void mpfr_init_cache (mpfr_cache_t,
 #endif
 __MPFR_DECLSPEC void mpfr_clear_cache (mpfr_cache_t);
 __MPFR_DECLSPEC int  mpfr_cache (mpfr_ptr, mpfr_cache_t, mpfr_rnd_t);
+__MPFR_DECLSPEC int  mpfr_cache_get_value (mpfr_ptr, mpfr_cache_t);
+__MPFR_DECLSPEC void mpfr_cache_set_value (mpfr_cache_t, mpfr_srcptr, int);
+
+__MPFR_DECLSPEC unsigned int mpfr_bsplit_nthreads (unsigned long);
+__MPFR_DECLSPEC void mpfr_bsplit_fork (void (*) (void *), void *, void *);
+__MPFR_DECLSPEC mpfr_bs_state_t * mpfr_bs_state_init (void);
+__MPFR_DECLSPEC void mpfr_bs_state_clear (mpfr_bs_state_t *);
+__MPFR_DECLSPEC void mpfr_bs_state_extend (mpfr_bs_state_t *, mpz_t, mpz_t,
+                                           mpz_t, unsigned long);
 
 __MPFR_DECLSPEC void mpfr_mulhigh_n (mpfr_limb_ptr, mpfr_limb_srcptr,
                                      mpfr_limb_srcptr, mp_size_t);
@@ -2565,9 +2921,19 @@ __MPFR_DECLSPEC void mpfr_div_ui2 (mpfr_ptr, mpfr_srcptr, unsigned long,
 __MPFR_DECLSPEC void mpfr_gamma_one_and_two_third (mpfr_ptr, mpfr_ptr,
                                                    mpfr_prec_t);
 
+#if MPFR_ARENA_MAX_SIZE != 0
+__MPFR_DECLSPEC mp_size_t mpfr_arena_mark (void);
+__MPFR_DECLSPEC mpfr_limb_ptr mpfr_arena_alloc (mp_size_t);
+__MPFR_DECLSPEC void mpfr_arena_release (mp_size_t);
+#endif
+__MPFR_DECLSPEC void mpfr_free_arena (void);
+
+__MPFR_DECLSPEC void mpfr_ziv_set_prec (mpfr_ptr, mpfr_prec_t);
+
 __MPFR_DECLSPEC void mpfr_mpz_init (mpz_ptr);
 __MPFR_DECLSPEC void mpfr_mpz_init2 (mpz_ptr, mp_bitcnt_t);
 __MPFR_DECLSPEC void mpfr_mpz_clear (mpz_ptr);
+__MPFR_DECLSPEC void mpfr_trim_pool (void);
 
 __MPFR_DECLSPEC int mpfr_odd_p (mpfr_srcptr);
 
@@ -2601,7 +2967,7 @@ __MPFR_DECLSPEC void flags_fout (FILE *, mpfr_flags_t);
 #endif
 
 #ifndef MPFR_POOL_NENTRIES
-# define MPFR_POOL_NENTRIES 32  /* default number of entries of the pool */
+# define MPFR_POOL_NENTRIES 32  /* maximal number of entries per size class */
 #endif
 
 #if MPFR_POOL_NENTRIES && !defined(MPFR_POOL_DONT_REDEFINE)
@@ -2864,4 +3230,45 @@ __MPFR_DECLSPEC mpfr_exp_t mpfr_ubf_diff_exp (mpfr_srcptr, mpfr_srcptr);
   (MPFR_IS_UBF (x) ? mpfr_ubf_zexp2exp (MPFR_ZEXP (x)) :        \
    MPFR_GET_EXP ((mpfr_ptr) (x)))
 
+/******************************************************
+ ***************  Exact sum accumulator  **************
+ ******************************************************/
+
+/* An accumulator (mpfr_sumacc_t) holds the exact sum of the regular terms
+   added so far, as a few fixed-point numbers in two's complement
+   representation (called blocks), plus flags for the singular terms. The
+   value of a block is d[0..size-1] * 2^(lo*GMP_NUMB_BITS), where lo is a
+   limb index; its most significant limb is always a sign extension limb,
+   so that a term whose bits are at least one limb below it can be added
+   without any risk of overflow. A new block is created when a term is too
+   far from the existing ones, so that the memory does not depend on the
+   exponent range of the terms, only on the length of the segments they
+   cover. See sumacc.c for the details. */
+
+typedef struct __mpfr_sumacc_block {
+  mp_limb_t *d;      /* two's complement significand */
+  mp_size_t size;    /* number of limbs, at least 2 */
+  mp_size_t alloc;   /* number of allocated limbs */
+  mpfr_exp_t lo;     /* limb index of d[0] */
+} mpfr_sumacc_block_t;
+
+#define MPFR_SUMACC_NAN   1   /* NaN, or +Inf and -Inf */
+#define MPFR_SUMACC_PINF  2   /* +Inf */
+#define MPFR_SUMACC_NINF  4   /* -Inf */
+#define MPFR_SUMACC_PZERO 8   /* +0 */
+#define MPFR_SUMACC_NZERO 16  /* -0 */
+#define MPFR_SUMACC_REG   32  /* a regular term */
+
+#if defined (__cplusplus)
+extern "C" {
+#endif
+
+__MPFR_DECLSPEC void mpfr_sumacc_add_limbs (mpfr_sumacc_ptr, mp_limb_t *,
+                                            mp_size_t, mpfr_exp_t, int);
+__MPFR_DECLSPEC void mpfr_sumacc_merge (mpfr_sumacc_ptr, mpfr_sumacc_srcptr);
+
+#if defined (__cplusplus)
+}
+#endif
+
 #endif /* __MPFR_IMPL_H__ */
@@ -66,7 +66,10 @@ If not, see <https://www.gnu.org/licenses/>. */
    rounded value to the destination. So even if a simple mutex is used,
    the wasted time should not be critical. Moreover, since a mutex is
    simpler to implement, this may also be slightly faster in some cases
-   (but no tests have been done yet). */
+   (but no tests have been done yet). Moreover, when the compiler has
+   the __atomic builtins, the read path of the shared cache does not take
+   the lock at all (see cache.c), so that only the recomputations are
+   serialized. */
 #ifdef MPFR_NEED_THREAD_LOCK
 
 /* TODO: Prefer the POSIX rwlock method as it allows several readers?
@@ -98,6 +101,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #define MPFR_LOCK_INIT(_lock)    MPFR_LOCK_C(mtx_init(&(_lock), mtx_plain))
 #define MPFR_LOCK_CLEAR(_lock)   do { mtx_destroy(&(_lock)); } while (0)
+#define MPFR_LOCK_YIELD()        do { thrd_yield(); } while (0)
 #define MPFR_LOCK_READ(_lock)    MPFR_LOCK_C(mtx_lock(&(_lock)))
 #define MPFR_UNLOCK_READ(_lock)  MPFR_LOCK_C(mtx_unlock(&(_lock)))
 #define MPFR_LOCK_WRITE(_lock)   MPFR_LOCK_C(mtx_lock(&(_lock)))
@@ -130,6 +134,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_THREAD_LOCK_METHOD "pthread"
 
 #include <pthread.h>
+#include <sched.h>
 
 #define MPFR_LOCK_DECL(_lock)                           \
   pthread_rwlock_t _lock;
@@ -149,6 +154,8 @@ If not, see <https://www.gnu.org/licenses/>. */
     pthread_rwlock_destroy(&(_lock));                   \
   } while (0)
 
+#define MPFR_LOCK_YIELD() do { sched_yield(); } while (0)
+
 #define MPFR_LOCK_READ(_lock)    MPFR_LOCK_C(pthread_rwlock_rdlock(&(_lock)))
 #define MPFR_UNLOCK_READ(_lock)  MPFR_LOCK_C(pthread_rwlock_unlock(&(_lock)))
 #define MPFR_LOCK_WRITE(_lock)   MPFR_LOCK_C(pthread_rwlock_wrlock(&(_lock)))
@@ -195,6 +202,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_LOCK_DECL(_lock)
 #define MPFR_LOCK_INIT(_lock)       do {} while (0)
 #define MPFR_LOCK_CLEAR(_lock)      do {} while (0)
+#define MPFR_LOCK_YIELD()           do {} while (0)
 #define MPFR_LOCK_READ(_lock)       do {} while (0)
 #define MPFR_UNLOCK_READ(_lock)     do {} while (0)
 #define MPFR_LOCK_WRITE(_lock)      do {} while (0)
@@ -212,6 +220,71 @@ If not, see <https://www.gnu.org/licenses/>. */
 /**************************************************************************/
 /**************************************************************************/
 
+/**************************************************************************/
+/**************************************************************************/
+/*                   Start of code for thread creation                    */
+/**************************************************************************/
+
+/* If MPFR may split some computations between several threads (only
+   when configured with --enable-parallel, which requires the thread-safe
+   support so that each thread has its own flags and exponent range).
+   MPFR_THREAD_T is the thread type. A thread function is declared with
+   MPFR_THREAD_FUNC and must end with MPFR_THREAD_RETURN. The expression
+   MPFR_THREAD_CREATE is non-zero on success, so that the caller can do
+   the work itself if the thread could not be created. */
+#ifdef MPFR_WANT_PARALLEL
+
+#if defined (MPFR_HAVE_C11_LOCK)
+
+#include <threads.h>
+
+#define MPFR_THREAD_T         thrd_t
+#define MPFR_THREAD_FUNC(_f, _arg) static int _f (void *_arg)
+#define MPFR_THREAD_RETURN    return 0
+#define MPFR_THREAD_CREATE(_t, _f, _arg)                \
+  (thrd_create (&(_t), (_f), (_arg)) == thrd_success)
+#define MPFR_THREAD_JOIN(_t)                            \
+  do {                                                  \
+    if (thrd_join ((_t), NULL) != thrd_success)         \
+      {                                                 \
+        fprintf (stderr, "MPFR thread join failure\n"); \
+        abort ();                                       \
+      }                                                 \
+  } while (0)
+
+#elif defined (HAVE_PTHREAD)
+
+#include <pthread.h>
+
+#define MPFR_THREAD_T         pthread_t
+#define MPFR_THREAD_FUNC(_f, _arg) static void *_f (void *_arg)
+#define MPFR_THREAD_RETURN    return NULL
+#define MPFR_THREAD_CREATE(_t, _f, _arg)                \
+  (pthread_create (&(_t), NULL, (_f), (_arg)) == 0)
+#define MPFR_THREAD_JOIN(_t)                            \
+  do {                                                  \
+    if (pthread_join ((_t), NULL) != 0)                 \
+      {                                                 \
+        fprintf (stderr, "MPFR thread join failure\n"); \
+        abort ();                                       \
+      }                                                 \
+  } while (0)
+
+#else
+
+# error "No thread creation / unsupported OS."
+
+#endif
+
+#define MPFR_HAVE_THREADS 1
+
+#endif  /* MPFR_WANT_PARALLEL */
+
+/**************************************************************************/
+/*                    End of code for thread creation                     */
+/**************************************************************************/
+/**************************************************************************/
+
 /**************************************************************************/
 /**************************************************************************/
 /*                    Start of code for deferred init                     */
@@ -275,6 +275,39 @@ typedef __mpfr_struct mpfr_t[1];
 typedef __mpfr_struct *mpfr_ptr;
 typedef const __mpfr_struct *mpfr_srcptr;
 
+/* Vector of numbers of the same precision, with contiguous storage:
+   the elements (headers) are stored in one array, followed by an array
+   of pointers to them (for the functions taking an array of mpfr_ptr),
+   and their significands are stored in a single block. The elements
+   must be accessed with mpfr_vec_get. */
+typedef struct {
+  mpfr_prec_t    _mpfr_vec_prec;
+  unsigned long  _mpfr_vec_size;
+  __mpfr_struct *_mpfr_vec_x;
+  mpfr_ptr      *_mpfr_vec_p;
+  mp_limb_t     *_mpfr_vec_d;
+} __mpfr_vec_struct;
+
+typedef __mpfr_vec_struct mpfr_vec_t[1];
+typedef __mpfr_vec_struct *mpfr_vec_ptr;
+typedef const __mpfr_vec_struct *mpfr_vec_srcptr;
+
+/* Accumulator for the exact sum of a sequence of numbers, whose memory
+   does not depend on the number of terms. The fields are internal. */
+struct __mpfr_sumacc_block;
+typedef struct {
+  struct __mpfr_sumacc_block *_mpfr_blk;
+  int            _mpfr_nblk;
+  int            _mpfr_ablk;
+  mp_limb_t     *_mpfr_tmp;
+  mp_size_t      _mpfr_tmp_alloc;
+  int            _mpfr_flags;
+} __mpfr_sumacc_struct;
+
+typedef __mpfr_sumacc_struct mpfr_sumacc_t[1];
+typedef __mpfr_sumacc_struct *mpfr_sumacc_ptr;
+typedef const __mpfr_sumacc_struct *mpfr_sumacc_srcptr;
+
 /* For those who need a direct and fast access to the sign field.
    However, it is not in the API, thus use it at your own risk: it
    might not be supported, or change name, in further versions!
@@ -294,9 +327,22 @@ typedef enum {
 /* Free cache policy */
 typedef enum {
   MPFR_FREE_LOCAL_CACHE  = 1,  /* 1 << 0 */
-  MPFR_FREE_GLOBAL_CACHE = 2   /* 1 << 1 */
+  MPFR_FREE_GLOBAL_CACHE = 2,  /* 1 << 1 */
+  MPFR_TRIM_POOL         = 4   /* 1 << 2 */
 } mpfr_free_cache_t;
 
+/* Counters of a function with a Ziv loop, for the current thread
+   (see mpfr_counters_get). */
+typedef struct {
+  const char    *name;
+  unsigned long  calls;
+  unsigned long  loops;
+  unsigned long  iterations;
+  unsigned long  failures;
+  double         bytes;
+  double         cycles;
+} mpfr_counters_t;
+
 /* GMP defines:
     + size_t:                Standard size_t
     + __GMP_NOTHROW          For C++: can't throw .
@@ -413,8 +459,16 @@ __MPFR_DECLSPEC int mpfr_buildopt_float128_p     (void);
 __MPFR_DECLSPEC int mpfr_buildopt_decimal_p      (void);
 __MPFR_DECLSPEC int mpfr_buildopt_gmpinternals_p (void);
 __MPFR_DECLSPEC int mpfr_buildopt_sharedcache_p  (void);
+__MPFR_DECLSPEC int mpfr_buildopt_parallel_p     (void);
 __MPFR_DECLSPEC MPFR_RETURNS_NONNULL const char *
   mpfr_buildopt_tune_case (void);
+__MPFR_DECLSPEC MPFR_RETURNS_NONNULL const char *
+  mpfr_buildopt_fmv_variant (void);
+
+__MPFR_DECLSPEC int  mpfr_tune_set   (const char *, unsigned long, long);
+__MPFR_DECLSPEC int  mpfr_tune_get   (const char *, unsigned long, long *);
+__MPFR_DECLSPEC int  mpfr_tune_load  (const char *);
+__MPFR_DECLSPEC void mpfr_tune_reset (void);
 
 __MPFR_DECLSPEC mpfr_exp_t mpfr_get_emin     (void);
 __MPFR_DECLSPEC int        mpfr_set_emin     (mpfr_exp_t);
@@ -472,6 +526,7 @@ __MPFR_DECLSPEC void
   mpfr_clears (mpfr_ptr, ...) __MPFR_SENTINEL_ATTR;
 
 __MPFR_DECLSPEC int mpfr_prec_round (mpfr_ptr, mpfr_prec_t, mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_reserve_prec (mpfr_ptr, mpfr_prec_t);
 __MPFR_DECLSPEC int mpfr_can_round (mpfr_srcptr, mpfr_exp_t, mpfr_rnd_t,
                                     mpfr_rnd_t, mpfr_prec_t);
 __MPFR_DECLSPEC mpfr_prec_t mpfr_min_prec (mpfr_srcptr);
@@ -664,6 +719,8 @@ __MPFR_DECLSPEC int mpfr_const_pi (mpfr_ptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_const_log2 (mpfr_ptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_const_euler (mpfr_ptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_const_catalan (mpfr_ptr, mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_set_const_nthreads (unsigned int);
+__MPFR_DECLSPEC unsigned int mpfr_get_const_nthreads (void);
 
 __MPFR_DECLSPEC int mpfr_agm (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
 
@@ -854,12 +911,51 @@ __MPFR_DECLSPEC int mpfr_fmms (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_srcptr,
                                mpfr_srcptr, mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_sum (mpfr_ptr, const mpfr_ptr *, unsigned long,
                               mpfr_rnd_t);
+__MPFR_DECLSPEC int mpfr_sum_parallel (mpfr_ptr, const mpfr_ptr *,
+                                       unsigned long, unsigned int,
+                                       mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_sumacc_init (mpfr_sumacc_ptr);
+__MPFR_DECLSPEC void mpfr_sumacc_clear (mpfr_sumacc_ptr);
+__MPFR_DECLSPEC void mpfr_sumacc_add (mpfr_sumacc_ptr, mpfr_srcptr);
+__MPFR_DECLSPEC void mpfr_sumacc_add_array (mpfr_sumacc_ptr,
+                                            const mpfr_ptr *, unsigned long);
+__MPFR_DECLSPEC int mpfr_sumacc_get (mpfr_ptr, mpfr_sumacc_srcptr,
+                                     mpfr_rnd_t);
 __MPFR_DECLSPEC int mpfr_dot (mpfr_ptr, const mpfr_ptr *, const mpfr_ptr *,
                               unsigned long, mpfr_rnd_t);
 
+__MPFR_DECLSPEC void mpfr_add_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                   const mpfr_ptr *, unsigned long,
+                                   mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_sub_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                   const mpfr_ptr *, unsigned long,
+                                   mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_mul_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                   const mpfr_ptr *, unsigned long,
+                                   mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_div_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                   const mpfr_ptr *, unsigned long,
+                                   mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_fma_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                   const mpfr_ptr *, const mpfr_ptr *,
+                                   unsigned long, mpfr_rnd_t);
+__MPFR_DECLSPEC void mpfr_fmma_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                                    const mpfr_ptr *, const mpfr_ptr *,
+                                    const mpfr_ptr *, unsigned long,
+                                    mpfr_rnd_t);
+
 __MPFR_DECLSPEC void mpfr_free_cache (void);
 __MPFR_DECLSPEC void mpfr_free_cache2 (mpfr_free_cache_t);
 __MPFR_DECLSPEC void mpfr_free_pool (void);
+__MPFR_DECLSPEC int mpfr_pool_set_limits (unsigned int, mp_bitcnt_t);
+__MPFR_DECLSPEC void mpfr_pool_get_limits (unsigned int *, mp_bitcnt_t *);
+__MPFR_DECLSPEC void mpfr_pool_get_stats (unsigned long *, unsigned long *);
+__MPFR_DECLSPEC void mpfr_pool_reset_stats (void);
+__MPFR_DECLSPEC unsigned long mpfr_counters_get (mpfr_counters_t *,
+                                                 unsigned long);
+__MPFR_DECLSPEC int mpfr_counters_cycles_p (void);
+__MPFR_DECLSPEC double mpfr_counters_get_bytes (void);
+__MPFR_DECLSPEC void mpfr_counters_reset (void);
 __MPFR_DECLSPEC int mpfr_mp_memory_cleanup (void);
 
 __MPFR_DECLSPEC int mpfr_subnormalize (mpfr_ptr, int, mpfr_rnd_t);
@@ -880,6 +976,18 @@ __MPFR_DECLSPEC void mpfr_custom_init_set (mpfr_ptr, int, mpfr_exp_t,
                                            mpfr_prec_t, void *);
 __MPFR_DECLSPEC int mpfr_custom_get_kind (mpfr_srcptr);
 
+__MPFR_DECLSPEC void mpfr_vec_init2 (mpfr_vec_ptr, unsigned long,
+                                     mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_vec_clear (mpfr_vec_ptr);
+__MPFR_DECLSPEC void mpfr_init_array2 (mpfr_ptr, unsigned long,
+                                       mpfr_prec_t);
+__MPFR_DECLSPEC void mpfr_clear_array (mpfr_ptr, unsigned long);
+__MPFR_DECLSPEC MPFR_RETURNS_NONNULL mpfr_ptr
+  mpfr_vec_get (mpfr_vec_srcptr, unsigned long);
+__MPFR_DECLSPEC const mpfr_ptr * mpfr_vec_ptrs (mpfr_vec_srcptr);
+__MPFR_DECLSPEC unsigned long mpfr_vec_size (mpfr_vec_srcptr);
+__MPFR_DECLSPEC mpfr_prec_t mpfr_vec_get_prec (mpfr_vec_srcptr);
+
 __MPFR_DECLSPEC int mpfr_total_order_p (mpfr_srcptr, mpfr_srcptr);
 
 __MPFR_DECLSPEC int mpfr_legendre (mpfr_ptr, long, mpfr_srcptr, mpfr_rnd_t);
@@ -1129,6 +1237,14 @@ __MPFR_DECLSPEC int mpfr_fpif_import_mem (mpfr_ptr, unsigned char *, size_t);
 
 /* End of the macro versions of the custom interface. */
 
+/* Macro versions of the vector accessors. */
+#define mpfr_vec_get(v,i) \
+  ((mpfr_ptr) MPFR_VALUE_OF((v)->_mpfr_vec_x + (i)))
+#define mpfr_vec_ptrs(v) \
+  ((const mpfr_ptr *) MPFR_VALUE_OF((v)->_mpfr_vec_p))
+#define mpfr_vec_size(v) MPFR_VALUE_OF((v)->_mpfr_vec_size)
+#define mpfr_vec_get_prec(v) MPFR_VALUE_OF((v)->_mpfr_vec_prec)
+
 #endif /* MPFR_USE_NO_MACRO */
 
 /* These are defined to be macros */
@@ -1260,6 +1376,10 @@ __MPFR_DECLSPEC int mpfr_fprintf (FILE*, const char*, ...);
 #define mpfr_fpif_import __gmpfr_fpif_import
 __MPFR_DECLSPEC int mpfr_fpif_export (FILE*, mpfr_srcptr);
 __MPFR_DECLSPEC int mpfr_fpif_import (mpfr_ptr, FILE*);
+#define mpfr_fpif_export_cache __gmpfr_fpif_export_cache
+#define mpfr_fpif_import_cache __gmpfr_fpif_import_cache
+__MPFR_DECLSPEC int mpfr_fpif_export_cache (FILE*);
+__MPFR_DECLSPEC int mpfr_fpif_import_cache (FILE*);
 
 #if defined (__cplusplus)
 }
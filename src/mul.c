@@ -725,6 +725,24 @@ mpfr_mul_3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
     }
 }
 
+/* Special code for 3*GMP_NUMB_BITS < p <= 8*GMP_NUMB_BITS, generated from
+   mul_fixed.h: mpfr_mul_N is used when MPFR_PREC2LIMBS(p) = N. */
+#define FUNCTION mpfr_mul_4
+#define N 4
+#include "mul_fixed.h"
+#define FUNCTION mpfr_mul_5
+#define N 5
+#include "mul_fixed.h"
+#define FUNCTION mpfr_mul_6
+#define N 6
+#include "mul_fixed.h"
+#define FUNCTION mpfr_mul_7
+#define N 7
+#include "mul_fixed.h"
+#define FUNCTION mpfr_mul_8
+#define N 8
+#include "mul_fixed.h"
+
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
 /* Note: mpfr_sqr will call mpfr_mul if bn > MPFR_SQR_THRESHOLD,
@@ -733,7 +751,7 @@ mpfr_mul_3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
    to the additional tests, but slowdown should not be noticeable
    as this code is not executed in very small precisions. */
 
-MPFR_HOT_FUNCTION_ATTR int
+MPFR_HOT_FUNCTION_ATTR MPFR_FMV_FUNCTION_ATTR int
 mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   int sign, inexact;
@@ -814,6 +832,21 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
       if (2 * GMP_NUMB_BITS < aq && aq < 3 * GMP_NUMB_BITS)
         return mpfr_mul_3 (a, b, c, rnd_mode, aq);
+
+      if (3 * GMP_NUMB_BITS < aq && aq <= 8 * GMP_NUMB_BITS)
+        switch (MPFR_PREC2LIMBS (aq))
+          {
+          case 4:
+            return mpfr_mul_4 (a, b, c, rnd_mode, aq);
+          case 5:
+            return mpfr_mul_5 (a, b, c, rnd_mode, aq);
+          case 6:
+            return mpfr_mul_6 (a, b, c, rnd_mode, aq);
+          case 7:
+            return mpfr_mul_7 (a, b, c, rnd_mode, aq);
+          case 8:
+            return mpfr_mul_8 (a, b, c, rnd_mode, aq);
+          }
     }
 #endif
 
@@ -910,8 +943,8 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
            exact values are a nightmare for the short product trick */
         bp = MPFR_MANT (b);
         cp = MPFR_MANT (c);
-        MPFR_STAT_STATIC_ASSERT (MPFR_MUL_THRESHOLD >= 1 &&
-                                 MPFR_SQR_THRESHOLD >= 1);
+        /* checked by mpfr_tune_set */
+        MPFR_ASSERTD (MPFR_MUL_THRESHOLD >= 1 && MPFR_SQR_THRESHOLD >= 1);
         if (MPFR_UNLIKELY ((bp[0] == 0 && bp[1] == 0) ||
                            (cp[0] == 0 && cp[1] == 0)))
           {
@@ -1071,7 +1104,26 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       {
       full_multiply:
         MPFR_LOG_MSG (("Use mpn_mul\n", 0));
-        b1 = mpn_mul (tmp, MPFR_MANT (b), bn, MPFR_MANT (c), cn);
+        {
+          mp_limb_t *bp = MPFR_MANT (b), *cp = MPFR_MANT (c);
+          mp_size_t bz = 0, cz = 0;
+
+          /* Skip the low zero limbs of b and c, so that the product of
+             values with few significant bits (small integers, dyadic
+             constants) stored in a large precision costs O(bn) instead
+             of O(bn*cn). The loops end since the most significant limbs
+             are non-zero. If b = c, this also gives bz = cz, so that
+             mpn_mul still detects a square. */
+          while (bp[bz] == 0)
+            bz++;
+          while (cp[cz] == 0)
+            cz++;
+          MPN_ZERO (tmp, bz + cz);
+          if (bn - bz >= cn - cz)
+            b1 = mpn_mul (tmp + bz + cz, bp + bz, bn - bz, cp + cz, cn - cz);
+          else
+            b1 = mpn_mul (tmp + bz + cz, cp + cz, cn - cz, bp + bz, bn - bz);
+        }
 
         /* now tmp[0]..tmp[k-1] contains the product of both mantissa,
            with tmp[k-1]>=2^(GMP_NUMB_BITS-2) */
@@ -1107,3 +1159,73 @@ mpfr_mul (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
     }
   MPFR_RET (inexact);
 }
+
+/* Vector form of mpfr_mul: r[i] <- a[i] * b[i] for 0 <= i < n, with the
+   ternary value of each product stored in inex[i]. The kernel is selected
+   once from the precision of r[0], which is the expected common precision
+   of all the operands, among the same-precision kernels as in mpfr_mul
+   (1 to 8 limbs); the elements not satisfying this condition or with a
+   singular input are handled by mpfr_mul. */
+void
+mpfr_mul_vec (int *inex, const mpfr_ptr *r, const mpfr_ptr *a,
+              const mpfr_ptr *b, unsigned long n, mpfr_rnd_t rnd_mode)
+{
+  unsigned long i;
+  mpfr_prec_t p;
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  p = MPFR_GET_PREC (r[0]);
+
+#if !defined(MPFR_GENERIC_ABI)
+  if (p < GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_mul_1 (r[i], a[i], b[i], rnd_mode, p),
+                   mpfr_mul (r[i], a[i], b[i], rnd_mode));
+  else if (GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_mul_2 (r[i], a[i], b[i], rnd_mode, p),
+                   mpfr_mul (r[i], a[i], b[i], rnd_mode));
+  else if (p == GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_mul_1n (r[i], a[i], b[i], rnd_mode),
+                   mpfr_mul (r[i], a[i], b[i], rnd_mode));
+  else if (2 * GMP_NUMB_BITS < p && p < 3 * GMP_NUMB_BITS)
+    MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                   mpfr_mul_3 (r[i], a[i], b[i], rnd_mode, p),
+                   mpfr_mul (r[i], a[i], b[i], rnd_mode));
+  else if (3 * GMP_NUMB_BITS < p && p <= 8 * GMP_NUMB_BITS)
+    switch (MPFR_PREC2LIMBS (p))
+      {
+      case 4:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_mul_4 (r[i], a[i], b[i], rnd_mode, p),
+                       mpfr_mul (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 5:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_mul_5 (r[i], a[i], b[i], rnd_mode, p),
+                       mpfr_mul (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 6:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_mul_6 (r[i], a[i], b[i], rnd_mode, p),
+                       mpfr_mul (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 7:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_mul_7 (r[i], a[i], b[i], rnd_mode, p),
+                       mpfr_mul (r[i], a[i], b[i], rnd_mode));
+        break;
+      case 8:
+        MPFR_VEC_LOOP (i, n, inex, r, a, b, p,
+                       mpfr_mul_8 (r[i], a[i], b[i], rnd_mode, p),
+                       mpfr_mul (r[i], a[i], b[i], rnd_mode));
+        break;
+      }
+  else
+#endif
+    for (i = 0; i < n; i++)
+      inex[i] = mpfr_mul (r[i], a[i], b[i], rnd_mode);
+}
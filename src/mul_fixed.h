@@ -0,0 +1,149 @@
+/* mpfr_mul_N -- multiply two floating-point numbers of N limbs
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Special code for (N-1)*GMP_NUMB_BITS < prec(a) = prec(b) = prec(c)
+   <= N*GMP_NUMB_BITS. Before including this file, define FUNCTION as the
+   name of the function and N as the number of limbs (see mul.c). Since N
+   is a constant, the compiler can unroll the loops on the limbs.
+   The full product is computed in a buffer on the stack. */
+
+static int
+FUNCTION (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
+          mpfr_prec_t p)
+{
+  mp_limb_t t[2 * N];
+  mpfr_limb_ptr ap = MPFR_MANT(a);
+  mpfr_exp_t ax = MPFR_GET_EXP(b) + MPFR_GET_EXP(c);
+  mpfr_prec_t sh = N * GMP_NUMB_BITS - p;
+  mp_limb_t rb, sb, x, mask = MPFR_LIMB_MASK(sh);
+  int i;
+
+  MPFR_ASSERTD((N - 1) * GMP_NUMB_BITS < p && p <= N * GMP_NUMB_BITS);
+
+  if (b == c)
+    mpn_sqr (t, MPFR_MANT(b), N);
+  else
+    mpn_mul_n (t, MPFR_MANT(b), MPFR_MANT(c), N);
+
+  /* The product is in [1/4, 1). If t[2N-1] < MPFR_LIMB_HIGHBIT, shift the
+     upper N+1 limbs by 1 bit; the lower ones only contribute to the sticky
+     bit, thus the bit lost from t[N-2] does not matter. */
+  if (t[2 * N - 1] < MPFR_LIMB_HIGHBIT)
+    {
+      ax --;
+      for (i = 2 * N - 1; i >= N; i--)
+        t[i] = (t[i] << 1) | (t[i - 1] >> (GMP_NUMB_BITS - 1));
+      t[N - 1] <<= 1;
+    }
+
+  if (sh == 0)
+    {
+      rb = t[N - 1] & MPFR_LIMB_HIGHBIT;
+      sb = t[N - 1] ^ rb;
+    }
+  else
+    {
+      rb = t[N] & (MPFR_LIMB_ONE << (sh - 1));
+      sb = ((t[N] & mask) ^ rb) | t[N - 1];
+      t[N] &= ~mask;
+    }
+  for (i = 0; i < N - 1; i++)
+    sb |= t[i];
+  for (i = 0; i < N; i++)
+    ap[i] = t[N + i];
+
+  MPFR_SIGN(a) = MPFR_MULT_SIGN (MPFR_SIGN (b), MPFR_SIGN (c));
+
+  /* rounding */
+  if (MPFR_UNLIKELY(ax > __gmpfr_emax))
+    return mpfr_overflow (a, rnd_mode, MPFR_SIGN(a));
+
+  /* Warning: underflow should be checked *after* rounding, thus when rounding
+     away and when a > 0.111...111*2^(emin-1), or when rounding to nearest and
+     a >= 0.111...111[1]*2^(emin-1), there is no underflow. */
+  if (MPFR_UNLIKELY(ax < __gmpfr_emin))
+    {
+      if (ax == __gmpfr_emin - 1 &&
+          ((rnd_mode == MPFR_RNDN && rb) ||
+           (MPFR_IS_LIKE_RNDA(rnd_mode, MPFR_IS_NEG (a)) && (rb | sb))))
+        {
+          /* x = MPFR_LIMB_MAX iff a = 0.111...111*2^(emin-1) */
+          x = ap[0] | mask;
+          for (i = 1; i < N; i++)
+            x &= ap[i];
+          if (x == MPFR_LIMB_MAX)
+            goto rounding; /* no underflow */
+        }
+      /* for RNDN, mpfr_underflow always rounds away, thus for |a| <= 2^(emin-2)
+         we have to change to RNDZ */
+      if (rnd_mode == MPFR_RNDN)
+        {
+          /* x = 0 iff a = 1/2*2^(emin-1) and the product is exact */
+          x = (ap[N - 1] ^ MPFR_LIMB_HIGHBIT) | rb | sb;
+          for (i = 0; i < N - 1; i++)
+            x |= ap[i];
+          if (ax < __gmpfr_emin - 1 || x == 0)
+            rnd_mode = MPFR_RNDZ;
+        }
+      return mpfr_underflow (a, rnd_mode, MPFR_SIGN(a));
+    }
+
+ rounding:
+  MPFR_EXP (a) = ax; /* Don't use MPFR_SET_EXP since ax might be < __gmpfr_emin
+                        in the cases "goto rounding" above. */
+  if ((rb == 0 && sb == 0) || rnd_mode == MPFR_RNDF)
+    {
+      MPFR_ASSERTD(ax >= __gmpfr_emin);
+      MPFR_RET (0);
+    }
+  else if (rnd_mode == MPFR_RNDN)
+    {
+      if (rb == 0 || (sb == 0 && (ap[0] & (MPFR_LIMB_ONE << sh)) == 0))
+        goto truncate;
+      else
+        goto add_one_ulp;
+    }
+  else if (MPFR_IS_LIKE_RNDZ(rnd_mode, MPFR_IS_NEG(a)))
+    {
+    truncate:
+      MPFR_ASSERTD(ax >= __gmpfr_emin);
+      MPFR_RET(-MPFR_SIGN(a));
+    }
+  else /* round away from zero */
+    {
+    add_one_ulp:
+      ap[0] += MPFR_LIMB_ONE << sh;
+      for (i = 1; i < N && ap[i - 1] == 0; i++)
+        ap[i] ++;
+      if (ap[N - 1] == 0)
+        {
+          ap[N - 1] = MPFR_LIMB_HIGHBIT;
+          if (MPFR_UNLIKELY(ax + 1 > __gmpfr_emax))
+            return mpfr_overflow (a, rnd_mode, MPFR_SIGN(a));
+          MPFR_ASSERTD(ax + 1 >= __gmpfr_emin);
+          MPFR_SET_EXP (a, ax + 1);
+        }
+      MPFR_RET(MPFR_SIGN(a));
+    }
+}
+
+#undef FUNCTION
+#undef N
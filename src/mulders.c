@@ -30,12 +30,14 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define MPFR_NEED_LONGLONG_H
 #include "mpfr-impl.h"
 
-/* Don't use MPFR_MULHIGH_SIZE since it is handled by tuneup */
+/* Don't use MPFR_MULHIGH_SIZE since it is handled by tuneup. Otherwise
+   the tables are the current ones, which can be changed at run time (see
+   thresholds.c), with at least the sizes checked below. */
 #ifdef MPFR_MULHIGH_TAB_SIZE
 static short mulhigh_ktab[MPFR_MULHIGH_TAB_SIZE];
 #else
-static short mulhigh_ktab[] = {MPFR_MULHIGH_TAB};
-#define MPFR_MULHIGH_TAB_SIZE (numberof_const (mulhigh_ktab))
+#define mulhigh_ktab (__gmpfr_tune.mulhigh.k)
+#define MPFR_MULHIGH_TAB_SIZE (__gmpfr_tune.mulhigh.size)
 #endif
 
 /* Put in  rp[n..2n-1] an approximation of the n high limbs
@@ -64,15 +66,24 @@ mpfr_mulhigh_n_basecase (mpfr_limb_ptr rp, mpfr_limb_srcptr up,
    of {np, n} * {mp, n}. The error is less than n ulps of rp[n] (and the
    approximation is always less or equal to the truncated full product).
 
-   Implements Algorithm ShortMul from [1].
+   Implements Algorithm ShortMul from [1]. Above MPFR_MULHIGH_FULL_THRESHOLD
+   limbs, the full product is computed instead: for large sizes, the FFT
+   multiplication of GMP makes it faster than the recursion, which only
+   saves a constant factor.
 */
-void
+MPFR_FMV_FUNCTION_ATTR void
 mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
                 mp_size_t n)
 {
   mp_size_t k;
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_MULHIGH_TAB_SIZE >= 8); /* so that 3*(n/4) > n/2 */
+  if (n > MPFR_MULHIGH_FULL_THRESHOLD)
+    {
+      mpn_mul_n (rp, np, mp, n); /* result is exact, no error */
+      return;
+    }
+
+  MPFR_ASSERTD (MPFR_MULHIGH_TAB_SIZE >= 8); /* so that 3*(n/4) > n/2 */
   k = MPFR_LIKELY (n < MPFR_MULHIGH_TAB_SIZE) ? mulhigh_ktab[n] : 3*(n/4);
   /* Algorithm ShortMul from [1] requires k >= (n+3)/2, which translates
      into k >= (n+4)/2 in the C language. */
@@ -81,8 +92,6 @@ mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
     mpn_mul_basecase (rp, np, n, mp, n); /* result is exact, no error */
   else if (k == 0)
     mpfr_mulhigh_n_basecase (rp, np, mp, n); /* basecase error < n ulps */
-  else if (n > MUL_FFT_THRESHOLD)
-    mpn_mul_n (rp, np, mp, n); /* result is exact, no error */
   else
     {
       mp_size_t l = n - k;
@@ -100,18 +109,26 @@ mpfr_mulhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mpfr_limb_srcptr mp,
 #ifdef MPFR_SQRHIGH_TAB_SIZE
 static short sqrhigh_ktab[MPFR_SQRHIGH_TAB_SIZE];
 #else
-static short sqrhigh_ktab[] = {MPFR_SQRHIGH_TAB};
-#define MPFR_SQRHIGH_TAB_SIZE (numberof_const (sqrhigh_ktab))
+#define sqrhigh_ktab (__gmpfr_tune.sqrhigh.k)
+#define MPFR_SQRHIGH_TAB_SIZE (__gmpfr_tune.sqrhigh.size)
 #endif
 
 /* Put in  rp[n..2n-1] an approximation of the n high limbs
-   of {np, n}^2. The error is less than n ulps of rp[n]. */
-void
+   of {np, n}^2. The error is less than n ulps of rp[n].
+   Above MPFR_SQRHIGH_FULL_THRESHOLD limbs, the full square is computed
+   (see mpfr_mulhigh_n). */
+MPFR_FMV_FUNCTION_ATTR void
 mpfr_sqrhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mp_size_t n)
 {
   mp_size_t k;
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_SQRHIGH_TAB_SIZE > 2); /* ensures k < n */
+  if (n > MPFR_SQRHIGH_FULL_THRESHOLD)
+    {
+      mpn_sqr (rp, np, n); /* result is exact, no error */
+      return;
+    }
+
+  MPFR_ASSERTD (MPFR_SQRHIGH_TAB_SIZE > 2); /* ensures k < n */
   k = MPFR_LIKELY (n < MPFR_SQRHIGH_TAB_SIZE) ? sqrhigh_ktab[n]
     : (n+4)/2; /* ensures that k >= (n+3)/2 */
   MPFR_ASSERTD (k == -1 || k == 0 || (k >= (n+4)/2 && k < n));
@@ -139,8 +156,8 @@ mpfr_sqrhigh_n (mpfr_limb_ptr rp, mpfr_limb_srcptr np, mp_size_t n)
 #ifdef MPFR_DIVHIGH_TAB_SIZE
 static short divhigh_ktab[MPFR_DIVHIGH_TAB_SIZE];
 #else
-static short divhigh_ktab[] = {MPFR_DIVHIGH_TAB};
-#define MPFR_DIVHIGH_TAB_SIZE (numberof_const (divhigh_ktab))
+#define divhigh_ktab (__gmpfr_tune.divhigh.k)
+#define MPFR_DIVHIGH_TAB_SIZE (__gmpfr_tune.divhigh.size)
 #endif
 
 /* Put in Q={qp, n} an approximation of N={np, 2*n} divided by D={dp, n},
@@ -234,7 +251,7 @@ mpfr_divhigh_n_basecase (mpfr_limb_ptr qp, mpfr_limb_ptr np,
 
    Assumes n >= 2 (which should be fulfilled also in the recursive calls).
 */
-mp_limb_t
+MPFR_FMV_FUNCTION_ATTR mp_limb_t
 mpfr_divhigh_n (mpfr_limb_ptr qp, mpfr_limb_ptr np, mpfr_limb_ptr dp,
                 mp_size_t n)
 {
@@ -247,7 +264,7 @@ mpfr_divhigh_n (mpfr_limb_ptr qp, mpfr_limb_ptr np, mpfr_limb_ptr dp,
     (("n=%Pd", (mpfr_prec_t) n),
      ("k=%Pd qh=%Mu", (mpfr_prec_t) k, k == 0 ? MPFR_LIMB_ZERO : qh));
 
-  MPFR_STAT_STATIC_ASSERT (MPFR_DIVHIGH_TAB_SIZE >= 15); /* so that 2*(n/3) >= (n+4)/2 */
+  MPFR_ASSERTD (MPFR_DIVHIGH_TAB_SIZE >= 15); /* so that 2*(n/3) >= (n+4)/2 */
   MPFR_ASSERTD(n >= 2);
   k = MPFR_LIKELY (n < MPFR_DIVHIGH_TAB_SIZE) ? divhigh_ktab[n] : 2*(n/3);
 
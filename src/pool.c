@@ -19,35 +19,132 @@ You should have received a copy of the GNU Lesser General Public License
 along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
+#define MPFR_NEED_LONGLONG_H
 #define MPFR_POOL_DONT_REDEFINE
 #include "mpfr-impl.h"
 
+/* The pool consists of MPFR_POOL_NCLASSES stacks of mpz_t, local to the
+   thread: the stack of index c (size class c) contains mpz_t whose number
+   of allocated limbs is in [2^c, 2^(c+1)), so that mpfr_mpz_init2 can
+   directly take a mpz_t that is large enough (the binary splittings use
+   mpz_t of various sizes, which would otherwise be reallocated).
+
+   The number of entries of each stack (at most MPFR_POOL_NENTRIES) and
+   the maximal size of the entries (at most 2^MPFR_POOL_NCLASSES - 1 limbs)
+   can be changed with mpfr_pool_set_limits; the default maximal size is
+   MPFR_POOL_MAX_SIZE limbs. */
+
+#ifndef MPFR_POOL_NCLASSES
+# define MPFR_POOL_NCLASSES 16 /* number of size classes */
+#endif
+
 #ifndef MPFR_POOL_MAX_SIZE
-# define MPFR_POOL_MAX_SIZE 32 /* maximal size (in limbs) for each entry */
+# define MPFR_POOL_MAX_SIZE 256 /* default maximal size (in limbs) */
 #endif
 
+/* largest value of the maximal size (in limbs) */
+#define MPFR_POOL_SIZE_LIMIT \
+  ((mp_size_t) (((unsigned long) 1 << MPFR_POOL_NCLASSES) - 1))
+
+#if (MPFR_POOL_MAX_SIZE >> MPFR_POOL_NCLASSES) != 0
+# error "MPFR_POOL_MAX_SIZE is too large for MPFR_POOL_NCLASSES"
+#endif
+
+static MPFR_THREAD_ATTR unsigned long pool_hits = 0;
+static MPFR_THREAD_ATTR unsigned long pool_misses = 0;
+
 /* If the number of entries of the mpz_t pool is not zero */
 #if MPFR_POOL_NENTRIES
 
-/* Index in the stack table of mpz_t and stack table of mpz_t */
-static MPFR_THREAD_ATTR int n_alloc = 0;
-static MPFR_THREAD_ATTR __mpz_struct mpz_tab[MPFR_POOL_NENTRIES];
+/* Run-time limits: number of entries per class and maximal size */
+static MPFR_THREAD_ATTR int pool_nentries = MPFR_POOL_NENTRIES;
+static MPFR_THREAD_ATTR mp_size_t pool_max_size = MPFR_POOL_MAX_SIZE;
 
-MPFR_HOT_FUNCTION_ATTR void
-mpfr_mpz_init (mpz_ptr z)
+/* Stack tables of mpz_t and their numbers of entries. Bit c of pool_mask
+   is set if and only if the stack of class c is not empty. pool_low[c] is
+   the smallest number of entries of the stack of class c since the last
+   trim, i.e. the entries of index < pool_low[c] have not been used since
+   then (see mpfr_trim_pool). */
+static MPFR_THREAD_ATTR __mpz_struct
+  pool_tab[MPFR_POOL_NCLASSES][MPFR_POOL_NENTRIES];
+static MPFR_THREAD_ATTR int pool_n[MPFR_POOL_NCLASSES];
+static MPFR_THREAD_ATTR int pool_low[MPFR_POOL_NCLASSES];
+static MPFR_THREAD_ATTR unsigned long pool_mask = 0;
+
+/* If the stack of class c has an entry of at least s limbs, move it to
+   the top and return 1, otherwise return 0. */
+static int
+pool_get_fit (int c, mp_size_t s)
+{
+  int i = pool_n[c];
+
+  while (i-- > 0)
+    if (ALLOC (&pool_tab[c][i]) >= s)
+      {
+        int top = pool_n[c] - 1;
+
+        if (i != top)
+          {
+            __mpz_struct tmp = pool_tab[c][i];
+
+            pool_tab[c][i] = pool_tab[c][top];
+            pool_tab[c][top] = tmp;
+            /* the entry moved to index i is no longer unused */
+            if (i < pool_low[c])
+              pool_low[c] = i;
+          }
+        return 1;
+      }
+  return 0;
+}
+
+/* Get an entry of at least s limbs in z and return 1,
+   or return 0 if there is none. */
+MPFR_HOT_FUNCTION_ATTR static int
+pool_get (mpz_ptr z, mp_size_t s)
 {
-  if (MPFR_LIKELY (n_alloc > 0))
+  int c = s <= 1 ? 0 : MPFR_INT_CEIL_LOG2 (s);
+
+  /* The entries of class c have at least 2^c >= s limbs. But an entry
+     of class c-1 may also be large enough, in particular when the same
+     size is used again: it is moved to the top of its stack. */
+  if (c > 0 && pool_get_fit (c - 1, s))
+    c--;
+  else
     {
-      /* Get a mpz_t from the MPFR stack of previously used mpz_t.
-         It reduces memory pressure, and it allows to reuse
-         a mpz_t that should be sufficiently big. */
-      MPFR_ASSERTD (n_alloc <= numberof (mpz_tab));
-      memcpy (z, &mpz_tab[--n_alloc], sizeof (mpz_t));
-      SIZ(z) = 0;
+      unsigned long m = pool_mask >> c;
+
+      if (m == 0)
+        return 0;
+      while ((m & 1) == 0)
+        {
+          m >>= 1;
+          c++;
+        }
     }
-  else
+  MPFR_ASSERTD (c < MPFR_POOL_NCLASSES);
+  MPFR_ASSERTD (pool_n[c] > 0 && pool_n[c] <= MPFR_POOL_NENTRIES);
+  /* Get a mpz_t from the MPFR stack of previously used mpz_t.
+     It reduces memory pressure, and it allows to reuse
+     a mpz_t that should be sufficiently big. */
+  memcpy (z, &pool_tab[c][--pool_n[c]], sizeof (mpz_t));
+  SIZ(z) = 0;
+  if (pool_n[c] == 0)
+    pool_mask &= ~(1UL << c);
+  if (pool_n[c] < pool_low[c])
+    pool_low[c] = pool_n[c];
+  pool_hits++;
+  return 1;
+}
+
+MPFR_HOT_FUNCTION_ATTR void
+mpfr_mpz_init (mpz_ptr z)
+{
+  /* The final size is not known: take the smallest entry. */
+  if (! pool_get (z, 1))
     {
       /* Call the real GMP function */
+      pool_misses++;
       mpz_init (z);
     }
 }
@@ -55,62 +152,130 @@ mpfr_mpz_init (mpz_ptr z)
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_mpz_init2 (mpz_ptr z, mp_bitcnt_t n)
 {
-  /* The condition on n is used below as the argument n will be ignored if
-     the mpz_t is obtained from the MPFR stack of previously used mpz_t.
-     Said otherwise, it z is expected to have a large size at the end, then
-     it is better to allocate this size directly than to get a mpz_t of
-     small size, with possibly several realloc's on it. But if n satisfies
-     the condition and is larger than the stacked mpz_t, this may still
-     yield useless realloc's. This is not ideal. We might consider to use
-     mpz_init2 with the maximum size in mpfr_mpz_init to solve this issue. */
-  if (MPFR_LIKELY (n_alloc > 0 && n <= MPFR_POOL_MAX_SIZE * GMP_NUMB_BITS))
-    {
-      /* Get a mpz_t from the MPFR stack of previously used mpz_t.
-         It reduces memory pressure, and it allows to reuse
-         a mpz_t that should be sufficiently big. */
-      MPFR_ASSERTD (n_alloc <= numberof (mpz_tab));
-      memcpy (z, &mpz_tab[--n_alloc], sizeof (mpz_t));
-      SIZ(z) = 0;
-    }
-  else
+  /* If z is expected to be larger than the entries that may be stored
+     in the pool, it is better to allocate its size directly. */
+  if (n > (mp_bitcnt_t) pool_max_size * GMP_NUMB_BITS ||
+      ! pool_get (z, n == 0 ? 1 : (n - 1) / GMP_NUMB_BITS + 1))
     {
       /* Call the real GMP function */
+      pool_misses++;
       mpz_init2 (z, n);
     }
 }
 
-
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_mpz_clear (mpz_ptr z)
 {
-  /* We only put objects with at most MPFR_POOL_MAX_SIZE in the mpz_t pool,
-     to avoid it takes too much memory (and anyway the speedup is mainly
-     for small precision). */
-  if (MPFR_LIKELY (n_alloc < numberof (mpz_tab) &&
-                   ALLOC (z) <= MPFR_POOL_MAX_SIZE))
+  mp_size_t a = ALLOC (z);
+
+  /* We only put objects with at most pool_max_size limbs in the mpz_t
+     pool, to avoid it takes too much memory. Since GMP 6.2, a mpz_t may
+     have no allocated limbs: there is no point in storing it. */
+  if (MPFR_LIKELY (a > 0 && a <= pool_max_size))
     {
-      /* Push back the mpz_t inside the stack of the used mpz_t */
-      MPFR_ASSERTD (n_alloc >= 0);
-      memcpy (&mpz_tab[n_alloc++], z, sizeof (mpz_t));
+      int c = MPFR_INT_CEIL_LOG2 (a + 1) - 1;  /* floor(log2(a)) */
+
+      MPFR_ASSERTD (c >= 0 && c < MPFR_POOL_NCLASSES);
+      if (MPFR_LIKELY (pool_n[c] < pool_nentries))
+        {
+          /* Push back the mpz_t inside the stack of the used mpz_t */
+          memcpy (&pool_tab[c][pool_n[c]++], z, sizeof (mpz_t));
+          pool_mask |= 1UL << c;
+          return;
+        }
     }
-  else
+  /* Call the real GMP function */
+  mpz_clear (z);
+}
+
+/* Free the entries with more than s limbs, and the oldest entries (at the
+   bottom) of each stack so that at most n entries remain. If trim is
+   non-zero, n is ignored and the entries that have not been used since
+   the last trim are freed instead. */
+static void
+pool_free (int n, mp_size_t s, int trim)
+{
+  int c, i, j;
+
+  for (c = 0; c < MPFR_POOL_NCLASSES; c++)
     {
-      /* Call the real GMP function */
-      mpz_clear (z);
+      int k = trim ? pool_low[c] : pool_n[c] - n;
+
+      MPFR_ASSERTD (pool_low[c] >= 0 && pool_low[c] <= pool_n[c]);
+      MPFR_ASSERTD (pool_n[c] <= MPFR_POOL_NENTRIES);
+      for (i = j = 0; i < pool_n[c]; i++)
+        if (i < k || ALLOC (&pool_tab[c][i]) > s)
+          mpz_clear (&pool_tab[c][i]);
+        else
+          memmove (&pool_tab[c][j++], &pool_tab[c][i], sizeof (mpz_t));
+      pool_n[c] = pool_low[c] = j;
+      if (j == 0)
+        pool_mask &= ~(1UL << c);
     }
 }
 
 #endif
 
+/* Set the number of entries of each size class of the pool to n and the
+   maximal size of the entries to s bits, freeing the entries that do not
+   satisfy these limits. Return a non-zero value, without changing the
+   limits, if they are too large (with n = 0, the pool is disabled). */
+int
+mpfr_pool_set_limits (unsigned int n, mp_bitcnt_t s)
+{
+  if (n > MPFR_POOL_NENTRIES || s / GMP_NUMB_BITS > MPFR_POOL_SIZE_LIMIT)
+    return 1;
+#if MPFR_POOL_NENTRIES
+  pool_nentries = n;
+  pool_max_size = s / GMP_NUMB_BITS;
+  /* keep the n most recent entries of each stack */
+  pool_free (n, pool_max_size, 0);
+#endif
+  return 0;
+}
+
 void
-mpfr_free_pool (void)
+mpfr_pool_get_limits (unsigned int *n, mp_bitcnt_t *s)
+{
+#if MPFR_POOL_NENTRIES
+  *n = pool_nentries;
+  *s = (mp_bitcnt_t) pool_max_size * GMP_NUMB_BITS;
+#else
+  *n = 0;
+  *s = 0;
+#endif
+}
+
+/* Get the number of calls to mpfr_mpz_init and mpfr_mpz_init2 that have
+   been served from the pool (hits) and by GMP (misses). */
+void
+mpfr_pool_get_stats (unsigned long *hits, unsigned long *misses)
+{
+  *hits = pool_hits;
+  *misses = pool_misses;
+}
+
+void
+mpfr_pool_reset_stats (void)
+{
+  pool_hits = 0;
+  pool_misses = 0;
+}
+
+/* Free the entries that have not been used since the last trim (or since
+   the pool was freed), i.e. that have stayed in the pool in the meantime. */
+void
+mpfr_trim_pool (void)
 {
 #if MPFR_POOL_NENTRIES
-  int i;
+  pool_free (0, pool_max_size, 1);
+#endif
+}
 
-  MPFR_ASSERTD (n_alloc >= 0 && n_alloc <= numberof (mpz_tab));
-  for (i = 0; i < n_alloc; i++)
-    mpz_clear (&mpz_tab[i]);
-  n_alloc = 0;
+void
+mpfr_free_pool (void)
+{
+#if MPFR_POOL_NENTRIES
+  pool_free (0, 0, 0);
 #endif
 }
@@ -97,14 +97,15 @@ mpfr_pow_is_exact (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
   {
     mpfr_t tmp;
     mpfr_prec_t p;
+    MPFR_GROUP_DECL (group);
     MPFR_MPZ_SIZEINBASE2 (p, a);
-    mpfr_init2 (tmp, p); /* prec = 1 should not be possible */
+    MPFR_GROUP_INIT_1 (group, p, tmp); /* prec = 1 should not be possible */
     res = mpfr_set_z (tmp, a, MPFR_RNDN);
     MPFR_ASSERTD (res == 0);
     res = mpfr_mul_2si (tmp, tmp, b, MPFR_RNDN);
     MPFR_ASSERTD (res == 0);
     *inexact = mpfr_pow_z (z, tmp, c, rnd_mode);
-    mpfr_clear (tmp);
+    MPFR_GROUP_CLEAR (group);
     res = 1;
   }
  end:
@@ -130,6 +131,7 @@ mpfr_pow_general (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
   /* Declaration of the size variable */
   mpfr_prec_t Nz = MPFR_PREC(z);               /* target precision */
   mpfr_prec_t Nt;                              /* working precision */
+  MPFR_GROUP_DECL (group);
   MPFR_ZIV_DECL (ziv_loop);
 
   MPFR_LOG_FUNC
@@ -162,8 +164,9 @@ mpfr_pow_general (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
      mfv5 -p113 -e1 mpfr_pow: 10913 / 11989.46 / 12321 */
   Nt = Nz + 9 + MPFR_INT_CEIL_LOG2 (Nz);
 
-  /* initialize of intermediary variable */
-  mpfr_init2 (t, Nt);
+  /* initialize of intermediary variable (u and k are only needed in the
+     rare case k_non_zero, they are allocated separately) */
+  MPFR_GROUP_INIT_1 (group, Nt, t);
 
   MPFR_ZIV_INIT (ziv_loop, Nt);
   for (;;)
@@ -257,7 +260,7 @@ mpfr_pow_general (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
           if (Ntmin > Nt)
             {
               Nt = Ntmin;
-              mpfr_set_prec (t, Nt);
+              MPFR_GROUP_REPREC_1 (group, Nt, t);
             }
           mpfr_init2 (u, Nt);
           mpfr_init2 (k, Ntmin);
@@ -285,9 +288,9 @@ mpfr_pow_general (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
 
       /* reactualisation of the precision */
       MPFR_ZIV_NEXT (ziv_loop, Nt);
-      mpfr_set_prec (t, Nt);
+      MPFR_GROUP_REPREC_1 (group, Nt, t);
       if (k_non_zero)
-        mpfr_set_prec (u, Nt);
+        mpfr_ziv_set_prec (u, Nt);
     }
   MPFR_ZIV_FREE (ziv_loop);
 
@@ -355,7 +358,7 @@ mpfr_pow_general (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y,
         }
       mpfr_clears (u, k, (mpfr_ptr) 0);
     }
-  mpfr_clear (t);
+  MPFR_GROUP_CLEAR (group);
 
   /* update the sign of the result if x was negative */
   if (neg_result)
@@ -545,18 +548,19 @@ mpfr_pow (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
     {
       mpfr_t t, x_abs;
       int negative, overflow;
+      MPFR_GROUP_DECL (group);
 
       /* FIXME: since we round y*log2|x| toward zero, we could also do early
          underflow detection */
       MPFR_SAVE_EXPO_MARK (expo);
-      mpfr_init2 (t, sizeof (mpfr_exp_t) * CHAR_BIT);
+      MPFR_GROUP_INIT_1 (group, sizeof (mpfr_exp_t) * CHAR_BIT, t);
       /* we want a lower bound on y*log2|x| */
       MPFR_TMP_INIT_ABS (x_abs, x);
       mpfr_log2 (t, x_abs, MPFR_RNDZ);
       mpfr_mul (t, t, y, MPFR_RNDZ);
       overflow = mpfr_cmp_si (t, __gmpfr_emax) >= 0;
       /* if t >= emax, then |z| >= 2^t >= 2^emax and we have overflow */
-      mpfr_clear (t);
+      MPFR_GROUP_CLEAR (group);
       MPFR_SAVE_EXPO_FREE (expo);
       if (overflow)
         {
@@ -637,6 +641,7 @@ mpfr_pow (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
     {
       mpfr_exp_t b = ex - 1;
       mpfr_t tmp;
+      MPFR_GROUP_DECL (group);
 
       MPFR_STAT_STATIC_ASSERT (MPFR_POW_EXP_THRESHOLD >=
                                sizeof(mpfr_exp_t) * CHAR_BIT);
@@ -662,7 +667,8 @@ mpfr_pow (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
       /* now x = +/-2^b, so x^y = (+/-1)^y*2^(b*y) is exact whenever b*y is
          an integer */
       MPFR_SAVE_EXPO_MARK (expo);
-      mpfr_init2 (tmp, MPFR_PREC (y) + sizeof (long) * CHAR_BIT);
+      MPFR_GROUP_INIT_1 (group, MPFR_PREC (y) + sizeof (long) * CHAR_BIT,
+                         tmp);
       inexact = mpfr_mul_si (tmp, y, b, MPFR_RNDN); /* exact */
       MPFR_ASSERTN (inexact == 0);
       /* Note: as the exponent range has been extended, an overflow is not
@@ -671,7 +677,7 @@ mpfr_pow (mpfr_ptr z, mpfr_srcptr x, mpfr_srcptr y, mpfr_rnd_t rnd_mode)
          because b is an integer (thus either 0 or >= 1). */
       MPFR_CLEAR_FLAGS ();
       inexact = mpfr_exp2 (z, tmp, rnd_mode);
-      mpfr_clear (tmp);
+      MPFR_GROUP_CLEAR (group);
       /* Without the following, the overflows3 test in tpow.c fails. */
       MPFR_SAVE_EXPO_UPDATE_FLAGS (expo, __gmpfr_flags);
       MPFR_SAVE_EXPO_FREE (expo);
@@ -263,7 +263,7 @@ POW_S (mpfr_ptr y, mpfr_srcptr x, TYPE n, mpfr_rnd_t rnd)
 
             /* actualization of the precision */
             MPFR_ZIV_NEXT (loop, Nt);
-            mpfr_set_prec (t, Nt);
+            mpfr_ziv_set_prec (t, Nt);
           }
         MPFR_ZIV_FREE (loop);
 
@@ -140,7 +140,7 @@ POW_U (mpfr_ptr y, mpfr_srcptr x, UTYPE n, mpfr_rnd_t rnd)
         break;
       /* Actualisation of the precision */
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (res, prec);
+      mpfr_ziv_set_prec (res, prec);
     }
   MPFR_ZIV_FREE (loop);
 
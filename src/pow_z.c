@@ -96,7 +96,7 @@ mpfr_pow_pos_z (mpfr_ptr y, mpfr_srcptr x, mpz_srcptr z, mpfr_rnd_t rnd, int cr)
         break;
       /* Can't decide correct rounding, increase the precision */
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (res, prec);
+      mpfr_ziv_set_prec (res, prec);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -356,7 +356,7 @@ mpfr_pow_z (mpfr_ptr y, mpfr_srcptr x, mpz_srcptr z, mpfr_rnd_t rnd)
             break;
           /* actualization of the precision */
           MPFR_ZIV_NEXT (loop, Nt);
-          mpfr_set_prec (t, Nt);
+          mpfr_ziv_set_prec (t, Nt);
         }
       MPFR_ZIV_FREE (loop);
 
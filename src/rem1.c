@@ -83,9 +83,11 @@ mpfr_rem1 (mpfr_ptr rem, long *quo, mpfr_rnd_t rnd_q,
 
   /* now neither x nor y is NaN, Inf or zero */
 
-  mpz_init (mx);
-  mpz_init (my);
-  mpz_init (r);
+  /* take the integers from the mpz_t pool large enough for the usual
+     cases (small ex - ey), so that they do not need to be reallocated */
+  mpz_init2 (mx, MPFR_PREC (x) + GMP_NUMB_BITS);
+  mpz_init2 (my, MPFR_PREC (y) + 2 * GMP_NUMB_BITS);
+  mpz_init2 (r, MPFR_PREC (x) + MPFR_PREC (y) + 2 * GMP_NUMB_BITS);
 
   ex = mpfr_get_z_2exp (mx, x);  /* x = mx*2^ex */
   ey = mpfr_get_z_2exp (my, y);  /* y = my*2^ey */
@@ -421,7 +421,7 @@ mpfr_rootn_si (mpfr_ptr y, mpfr_srcptr x, long k, mpfr_rnd_t rnd_mode)
           break;
 
         MPFR_ZIV_NEXT (loop, Nt);
-        mpfr_set_prec (t, Nt);
+        mpfr_ziv_set_prec (t, Nt);
       }
     MPFR_ZIV_FREE (loop);
 
@@ -21,10 +21,25 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-impl.h"
 
+/* Enlarge the significand of x to n limbs, keeping its contents. */
+static void
+mpfr_realloc_mant (mpfr_ptr x, mp_size_t n)
+{
+  mpfr_size_limb_t *tmp;
+
+  MPFR_ASSERTD (n > MPFR_GET_ALLOC_SIZE (x));
+  tmp = (mpfr_size_limb_t *) mpfr_reallocate_func
+    (MPFR_GET_REAL_PTR(x),
+     MPFR_MALLOC_SIZE(MPFR_GET_ALLOC_SIZE (x)),
+     MPFR_MALLOC_SIZE(n));
+  MPFR_SET_MANT_PTR(x, tmp);
+  MPFR_SET_ALLOC_SIZE(x, n);
+}
+
 MPFR_HOT_FUNCTION_ATTR void
 mpfr_set_prec (mpfr_ptr x, mpfr_prec_t p)
 {
-  mp_size_t xsize, xoldsize;
+  mp_size_t xsize;
 
   MPFR_LOG_MSG (("prec=%Pd\n", p));
 
@@ -35,20 +50,41 @@ mpfr_set_prec (mpfr_ptr x, mpfr_prec_t p)
   xsize = MPFR_PREC2LIMBS (p);
 
   /* Realloc only if the new size is greater than the old */
-  xoldsize = MPFR_GET_ALLOC_SIZE (x);
-  if (xsize > xoldsize)
+  if (xsize > MPFR_GET_ALLOC_SIZE (x))
+    mpfr_realloc_mant (x, xsize);
+  MPFR_PREC (x) = p;
+  MPFR_SET_NAN (x); /* initializes to NaN */
+}
+
+/* Same as mpfr_set_prec, for the variables whose precision is increased
+   by MPFR_ZIV_NEXT in a Ziv loop: if the significand must be enlarged,
+   room is reserved for the precision of the next iteration, so that only
+   every other failure needs a reallocation. */
+void
+mpfr_ziv_set_prec (mpfr_ptr x, mpfr_prec_t p)
+{
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  if (MPFR_PREC2LIMBS (p) > MPFR_GET_ALLOC_SIZE (x))
     {
-      mpfr_size_limb_t *tmp;
-
-      tmp = (mpfr_size_limb_t *) mpfr_reallocate_func
-        (MPFR_GET_REAL_PTR(x),
-         MPFR_MALLOC_SIZE(xoldsize),
-         MPFR_MALLOC_SIZE(xsize));
-      MPFR_SET_MANT_PTR(x, tmp);
-      MPFR_SET_ALLOC_SIZE(x, xsize);
+      mpfr_prec_t q = p <= MPFR_PREC_MAX - p / 2 ? p + p / 2 : MPFR_PREC_MAX;
+
+      mpfr_realloc_mant (x, MPFR_PREC2LIMBS (q));
     }
   MPFR_PREC (x) = p;
-  MPFR_SET_NAN (x); /* initializes to NaN */
+  MPFR_SET_NAN (x);
+}
+
+/* Enlarge the significand of x so that its precision can be increased
+   up to p by mpfr_set_prec or mpfr_prec_round without any reallocation.
+   The precision and the value of x are not changed. */
+void
+mpfr_reserve_prec (mpfr_ptr x, mpfr_prec_t p)
+{
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  if (MPFR_PREC2LIMBS (p) > MPFR_GET_ALLOC_SIZE (x))
+    mpfr_realloc_mant (x, MPFR_PREC2LIMBS (p));
 }
 
 #undef mpfr_get_prec
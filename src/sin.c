@@ -40,6 +40,7 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   mpfr_exp_t expx, err1, err;
   mpfr_prec_t precy, m;
   int inexact, sign, reduce;
+  MPFR_GROUP_DECL (group);
   MPFR_ZIV_DECL (loop);
   MPFR_SAVE_EXPO_DECL (expo);
 
@@ -97,13 +98,18 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       m += err1;
     }
 
+  /* c and xr are taken in a group with the largest precision needed,
+     expx + m - 1 if there is an argument reduction; their precisions are
+     then reduced without any reallocation. As expx + m - 1 will silently
+     be converted into mpfr_prec_t, the assert below may be useful to avoid
+     undefined behavior. */
   if (expx >= 2)
     {
-      mpfr_init2 (c, expx + m - 1);
-      mpfr_init2 (xr, m);
+      MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
+      MPFR_GROUP_INIT_2 (group, expx + m - 1, c, xr);
     }
   else
-    mpfr_init2 (c, m);
+    MPFR_GROUP_INIT_1 (group, m, c);
 
   MPFR_ZIV_INIT (loop, m);
   for (;;)
@@ -118,12 +124,8 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
                         the reduction. */
         {
           reduce = 1;
-          /* As expx + m - 1 will silently be converted into mpfr_prec_t
-             in the mpfr_set_prec call, the assert below may be useful to
-             avoid undefined behavior. */
-          MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
-          mpfr_set_prec (c, expx + m - 1);
-          mpfr_set_prec (xr, m);
+          MPFR_ASSERTD (MPFR_PREC (c) == expx + m - 1);
+          MPFR_PREC (xr) = m;
           mpfr_const_pi (c, MPFR_RNDN);
           mpfr_mul_2ui (c, c, 1, MPFR_RNDN);
           mpfr_remainder (xr, x, c, MPFR_RNDN);
@@ -155,7 +157,7 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
       sign = MPFR_SIGN(xx);
       /* now that the argument is reduced, precision m is enough */
-      mpfr_set_prec (c, m);
+      MPFR_PREC (c) = m;
       mpfr_cos (c, xx, MPFR_RNDA);    /* c = cos(x) rounded away */
       mpfr_sqr (c, c, MPFR_RNDU);     /* away */
       mpfr_ui_sub (c, 1, c, MPFR_RNDZ);
@@ -191,6 +193,13 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
     ziv_next:
       /* Else generic increase */
       MPFR_ZIV_NEXT (loop, m);
+      if (expx >= 2)
+        {
+          MPFR_ASSERTN (expx + m - 1 <= MPFR_PREC_MAX);
+          MPFR_GROUP_REPREC_2 (group, expx + m - 1, c, xr);
+        }
+      else
+        MPFR_GROUP_REPREC_1 (group, m, c);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -198,9 +207,7 @@ mpfr_sin (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
   /* inexact cannot be 0, since this would mean that c was representable
      within the target precision, but in that case mpfr_can_round will fail */
 
-  mpfr_clear (c);
-  if (expx >= 2)
-    mpfr_clear (xr);
+  MPFR_GROUP_CLEAR (group);
 
  end:
   MPFR_SAVE_EXPO_FREE (expo);
@@ -209,7 +209,7 @@ mpfr_sin_cos (mpfr_ptr y, mpfr_ptr z, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
 
     next_step:
       MPFR_ZIV_NEXT (loop, m);
-      mpfr_set_prec (c, m);
+      mpfr_ziv_set_prec (c, m);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -493,7 +493,29 @@ mpfr_sqrt2 (mpfr_ptr r, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
 
 #endif /* !defined(MPFR_GENERIC_ABI) && GMP_NUMB_BITS == 64 */
 
-int
+#if !defined(MPFR_GENERIC_ABI)
+
+/* Special code for 3*GMP_NUMB_BITS < PREC(r) <= 8*GMP_NUMB_BITS, generated
+   from sqrt_fixed.h: mpfr_sqrtN is used when MPFR_PREC2LIMBS(PREC(r)) = N. */
+#define FUNCTION mpfr_sqrt4
+#define N 4
+#include "sqrt_fixed.h"
+#define FUNCTION mpfr_sqrt5
+#define N 5
+#include "sqrt_fixed.h"
+#define FUNCTION mpfr_sqrt6
+#define N 6
+#include "sqrt_fixed.h"
+#define FUNCTION mpfr_sqrt7
+#define N 7
+#include "sqrt_fixed.h"
+#define FUNCTION mpfr_sqrt8
+#define N 8
+#include "sqrt_fixed.h"
+
+#endif /* !defined(MPFR_GENERIC_ABI) */
+
+MPFR_FMV_FUNCTION_ATTR int
 mpfr_sqrt (mpfr_ptr r, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
 {
   mp_size_t rsize; /* number of limbs of r (plus 1 if exact limb multiple) */
@@ -572,6 +594,24 @@ mpfr_sqrt (mpfr_ptr r, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
   }
 #endif
 
+#if !defined(MPFR_GENERIC_ABI)
+  if (rq == MPFR_GET_PREC (u) &&
+      3 * GMP_NUMB_BITS < rq && rq <= 8 * GMP_NUMB_BITS)
+    switch (MPFR_PREC2LIMBS (rq))
+      {
+      case 4:
+        return mpfr_sqrt4 (r, u, rnd_mode);
+      case 5:
+        return mpfr_sqrt5 (r, u, rnd_mode);
+      case 6:
+        return mpfr_sqrt6 (r, u, rnd_mode);
+      case 7:
+        return mpfr_sqrt7 (r, u, rnd_mode);
+      case 8:
+        return mpfr_sqrt8 (r, u, rnd_mode);
+      }
+#endif
+
   MPFR_TMP_MARK (marker);
   MPFR_UNSIGNED_MINUS_MODULO (sh, rq);
   if (sh == 0 && rnd_mode == MPFR_RNDN)
@@ -0,0 +1,144 @@
+/* mpfr_sqrtN -- square root of a floating-point number of N limbs
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Special code for (N-1)*GMP_NUMB_BITS < PREC(r) = PREC(u)
+   <= N*GMP_NUMB_BITS. Before including this file, define FUNCTION as the
+   name of the function and N as the number of limbs (see sqrt.c). Since N
+   is a constant, the compiler can unroll the loops on the limbs.
+
+   We compute the integer square root of {np, 2k}, which contains the
+   significand of u (shifted by one bit if the exponent of u is odd), where
+   k = N when PREC(r) < N*GMP_NUMB_BITS, so that the round bit is in the
+   root, and k = N+1 otherwise. */
+
+static int
+FUNCTION (mpfr_ptr r, mpfr_srcptr u, mpfr_rnd_t rnd_mode)
+{
+  mpfr_prec_t p = MPFR_GET_PREC(r);
+  mpfr_limb_ptr up = MPFR_MANT(u), rp = MPFR_MANT(r);
+  mp_limb_t np[2 * N + 2], tp[N + 1], rb, sb, x;
+  mpfr_prec_t exp_u = MPFR_EXP(u), exp_r, sh = N * GMP_NUMB_BITS - p;
+  mp_limb_t mask = MPFR_LIMB_MASK(sh);
+  int i, k = N + (sh == 0);
+
+  MPFR_ASSERTD((N - 1) * GMP_NUMB_BITS < p && p <= N * GMP_NUMB_BITS);
+
+  for (i = 0; i < 2 * k - N; i++)
+    np[i] = 0;
+  if (((unsigned int) exp_u & 1) != 0)
+    {
+      np[2 * k - N - 1] = mpn_rshift (np + 2 * k - N, up, N, 1);
+      exp_u ++;
+    }
+  else
+    for (i = 0; i < N; i++)
+      np[2 * k - N + i] = up[i];
+  exp_r = exp_u / 2;
+
+  /* with r2p = NULL, mpn_sqrtrem only tells whether the remainder is zero */
+  sb = mpn_sqrtrem (tp, NULL, np, 2 * k) != 0;
+  MPFR_ASSERTD(tp[k - 1] >= MPFR_LIMB_HIGHBIT);
+
+  if (sh == 0)
+    {
+      rb = tp[0] & MPFR_LIMB_HIGHBIT;
+      sb |= tp[0] ^ rb;
+    }
+  else
+    {
+      rb = tp[0] & (MPFR_LIMB_ONE << (sh - 1));
+      sb |= (tp[0] & mask) ^ rb;
+      tp[0] &= ~mask;
+    }
+  for (i = 0; i < N; i++)
+    rp[i] = tp[k - N + i];
+
+  /* rounding */
+  if (MPFR_UNLIKELY (exp_r > __gmpfr_emax))
+    return mpfr_overflow (r, rnd_mode, 1);
+
+  /* See comments in mpfr_div_1 */
+  if (MPFR_UNLIKELY (exp_r < __gmpfr_emin))
+    {
+      if (rnd_mode == MPFR_RNDN)
+        {
+          /* x = 0 iff r = 1/2*2^(emin-1) and the root is exact */
+          x = (rp[N - 1] ^ MPFR_LIMB_HIGHBIT) | sb;
+          for (i = 0; i < N - 1; i++)
+            x |= rp[i];
+          if (exp_r < __gmpfr_emin - 1 || x == 0)
+            rnd_mode = MPFR_RNDZ;
+        }
+      else if (MPFR_IS_LIKE_RNDA(rnd_mode, 0))
+        {
+          /* x = MPFR_LIMB_MAX iff r = 0.111...111*2^(emin-1) */
+          x = rp[0] | mask;
+          for (i = 1; i < N; i++)
+            x &= rp[i];
+          if (exp_r == __gmpfr_emin - 1 && x == MPFR_LIMB_MAX && (rb | sb))
+            goto rounding; /* no underflow */
+        }
+      return mpfr_underflow (r, rnd_mode, 1);
+    }
+
+ rounding:
+  MPFR_EXP (r) = exp_r;
+  if (sb == 0 /* implies rb = 0 */ || rnd_mode == MPFR_RNDF)
+    {
+      MPFR_ASSERTD(exp_r >= __gmpfr_emin);
+      MPFR_ASSERTD(exp_r <= __gmpfr_emax);
+      MPFR_RET (0);
+    }
+  else if (rnd_mode == MPFR_RNDN)
+    {
+      /* since sb <> 0 now, only rb is needed */
+      if (rb == 0)
+        goto truncate;
+      else
+        goto add_one_ulp;
+    }
+  else if (MPFR_IS_LIKE_RNDZ(rnd_mode, 0))
+    {
+    truncate:
+      MPFR_ASSERTD(exp_r >= __gmpfr_emin);
+      MPFR_ASSERTD(exp_r <= __gmpfr_emax);
+      MPFR_RET(-1);
+    }
+  else /* round away from zero */
+    {
+    add_one_ulp:
+      rp[0] += MPFR_LIMB_ONE << sh;
+      for (i = 1; i < N && rp[i - 1] == 0; i++)
+        rp[i] ++;
+      if (rp[N - 1] == 0)
+        {
+          rp[N - 1] = MPFR_LIMB_HIGHBIT;
+          if (MPFR_UNLIKELY(exp_r + 1 > __gmpfr_emax))
+            return mpfr_overflow (r, rnd_mode, 1);
+          MPFR_ASSERTD(exp_r + 1 >= __gmpfr_emin);
+          MPFR_SET_EXP (r, exp_r + 1);
+        }
+      MPFR_RET(1);
+    }
+}
+
+#undef FUNCTION
+#undef N
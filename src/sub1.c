@@ -53,6 +53,23 @@ mpfr_sub1 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
       mpfr_get_prec (c), mpfr_log_prec, c, rnd_mode),
      ("a[%Pd]=%.*Rg", mpfr_get_prec (a), mpfr_log_prec, a));
 
+  /* In-place subtraction when |b| >> |c| (or |c| >> |b|, with a sharing
+     its significand with c): see mpfr_add1_inplace and mpfr_add1. */
+  if (MPFR_UNLIKELY (MPFR_MANT (a) == MPFR_MANT (b) ||
+                     MPFR_MANT (a) == MPFR_MANT (c)) &&
+      rnd_mode != MPFR_RNDF && ! MPFR_IS_UBF (b) && ! MPFR_IS_UBF (c))
+    {
+      int swap = MPFR_MANT (a) == MPFR_MANT (c);
+      mpfr_srcptr x = swap ? c : b, y = swap ? b : c;
+
+      if (MPFR_GET_PREC (a) == MPFR_GET_PREC (x) &&
+          MPFR_GET_PREC (y) <= MPFR_GET_PREC (a) &&
+          MPFR_GET_EXP (x) - MPFR_GET_EXP (y) >= 2 &&
+          mpfr_add1_inplace (a, x, y, swap ? - MPFR_SIGN (b) : MPFR_SIGN (b),
+                             1, rnd_mode, &inexact))
+        MPFR_RET (inexact);
+    }
+
   MPFR_TMP_MARK(marker);
   ap = MPFR_MANT(a);
   an = MPFR_LIMB_SIZE(a);
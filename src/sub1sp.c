@@ -33,10 +33,6 @@ If not, see <https://www.gnu.org/licenses/>. */
    Bug report: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=108467
 */
 
-/* define MPFR_FULLSUB to use alternate code in mpfr_sub1sp2 and mpfr_sub1sp2n
-   (see comments in mpfr_sub1sp2) */
-/* #define MPFR_FULLSUB */
-
 #if MPFR_WANT_ASSERT >= 2
 /* Check the result of mpfr_sub1sp with mpfr_sub1.
 
@@ -523,16 +519,15 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   mp_limb_t rb; /* round bit */
   mp_limb_t sb; /* sticky bit */
   mp_limb_t mask, a0, a1;
+  mp_limb_t bo; /* borrow */
   mpfr_uexp_t d;
 
   MPFR_ASSERTD(GMP_NUMB_BITS < p && p < 2 * GMP_NUMB_BITS);
 
   if (bx == cx) /* subtraction is exact in this case */
     {
-      /* first compute a0: if the compiler is smart enough, it will use the generated
-         borrow to get for free the term (bp[0] < cp[0]) */
-      a0 = bp[0] - cp[0];
-      a1 = bp[1] - cp[1] - (bp[0] < cp[0]);
+      MPFR_SUBB (a0, bo, bp[0], cp[0], 0);
+      MPFR_SUBB (a1, bo, bp[1], cp[1], bo);
       if (a1 == 0 && a0 == 0) /* result is zero */
         {
           if (rnd_mode == MPFR_RNDD)
@@ -542,7 +537,7 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
           MPFR_SET_ZERO(a);
           MPFR_RET (0);
         }
-      else if (a1 >= bp[1]) /* borrow: |c| > |b| */
+      else if (bo) /* borrow: |c| > |b| */
         {
           MPFR_SET_OPPOSITE_SIGN (a, b);
           /* a = b-c mod 2^(2*GMP_NUMB_BITS) */
@@ -599,41 +594,17 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
       if (d < GMP_NUMB_BITS)
         {
           t = (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d);
-          /* TODO: Change the code to generate a full subtraction with borrow,
-             avoiding the test on sb and the corresponding correction. Note
-             that Clang has builtins:
-               https://clang.llvm.org/docs/LanguageExtensions.html#multiprecision-arithmetic-builtins
-             but the generated code may not be good:
-               https://llvm.org/bugs/show_bug.cgi?id=20748
-             With the current source code, Clang generates on x86_64:
-               1. sub %rsi,%rbx for the first subtraction in a1;
-               2. sub %rdi,%rax for the subtraction in a0;
-               3. sbb $0x0,%rbx for the second subtraction in a1, i.e. just
-                  subtracting the borrow out from (2).
-             So, Clang recognizes the borrow, but doesn't merge (1) and (3).
-             Bug: https://llvm.org/bugs/show_bug.cgi?id=25858
-             For GCC: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=79173
-          */
-#ifndef MPFR_FULLSUB
-          a0 = bp[0] - t;
-          a1 = bp[1] - (cp[1] >> d) - (bp[0] < t);
           sb = cp[0] << (GMP_NUMB_BITS - d); /* neglected part of c */
-          if (sb)
-            {
-              a1 -= (a0 == 0);
-              a0 --;
-              /* a = a1,a0 cannot become zero here, since:
-                 a) if d >= 2, then a1 >= 2^(w-1) - (2^(w-2)-1) with
-                    w = GMP_NUMB_BITS, thus a1 - 1 >= 2^(w-2),
-                 b) if d = 1, then since p < 2*GMP_NUMB_BITS we have sb=0. */
-              MPFR_ASSERTD(a1 > 0 || a0 > 0);
-              sb = -sb; /* 2^GMP_NUMB_BITS - sb */
-            }
-#else
-          sb = - (cp[0] << (GMP_NUMB_BITS - d));
-          a0 = bp[0] - t - (sb != 0);
-          a1 = bp[1] - (cp[1] >> d) - (bp[0] < t || (bp[0] == t && sb != 0));
-#endif
+          /* subtract sb too, i.e., negate sb and subtract a borrow from a0
+             if sb <> 0 */
+          MPFR_SUBB (a0, bo, bp[0], t, sb != 0);
+          a1 = bp[1] - (cp[1] >> d) - bo;
+          /* a = a1,a0 cannot be zero here when sb <> 0, since:
+             a) if d >= 2, then a1 >= 2^(w-1) - (2^(w-2)-1) with
+                w = GMP_NUMB_BITS, thus a1 - 1 >= 2^(w-2),
+             b) if d = 1, then since p < 2*GMP_NUMB_BITS we have sb=0. */
+          MPFR_ASSERTD(a1 > 0 || a0 > 0);
+          sb = -sb; /* 2^GMP_NUMB_BITS - sb */
           if (a1 == 0)
             {
               /* this implies d=1, which in turn implies sb=0 */
@@ -667,10 +638,8 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
              significant bit of a0 below */
           sb = (d == GMP_NUMB_BITS) ? cp[0]
             : (cp[1] << (2*GMP_NUMB_BITS - d)) | (cp[0] != 0);
-          t = (cp[1] >> (d - GMP_NUMB_BITS)) + (sb != 0);
-          /* warning: t might overflow to 0 if d=GMP_NUMB_BITS and sb <> 0 */
-          a0 = bp[0] - t;
-          a1 = bp[1] - (bp[0] < t) - (t == 0 && sb != 0);
+          MPFR_SUBB (a0, bo, bp[0], cp[1] >> (d - GMP_NUMB_BITS), sb != 0);
+          a1 = bp[1] - bo;
           sb = -sb;
           /* since bp[1] has its most significant bit set, we can have an
              exponent decrease of at most one */
@@ -693,8 +662,8 @@ mpfr_sub1sp2 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
              1/2 ulp(b) < ulp(b) - c < ulp(b), thus rb = sb = 1, unless we
              had an exponent decrease. */
           t = MPFR_LIMB_ONE << sh;
-          a0 = bp[0] - t;
-          a1 = bp[1] - (bp[0] < t);
+          MPFR_SUBB (a0, bo, bp[0], t, 0);
+          a1 = bp[1] - bo;
           if (a1 < MPFR_LIMB_HIGHBIT)
             {
               /* necessarily we had b = 1000...000 */
@@ -784,6 +753,7 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
   mp_limb_t rb; /* round bit */
   mp_limb_t sb; /* sticky bit */
   mp_limb_t a0, a1;
+  mp_limb_t bo; /* borrow */
   mpfr_uexp_t d;
 
 /* this function is inspired by mpfr_sub1sp2 (for the operations of the
@@ -791,8 +761,8 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
   if (bx == cx) /* subtraction is exact in this case */
     {
-      a0 = bp[0] - cp[0];
-      a1 = bp[1] - cp[1] - (bp[0] < cp[0]);
+      MPFR_SUBB (a0, bo, bp[0], cp[0], 0);
+      MPFR_SUBB (a1, bo, bp[1], cp[1], bo);
       if (a1 == 0 && a0 == 0) /* result is zero */
         {
           if (rnd_mode == MPFR_RNDD)
@@ -802,10 +772,7 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
           MPFR_SET_ZERO(a);
           MPFR_RET (0);
         }
-      /* since B/2 <= bp[1], cp[1] < B with B=2^GMP_NUMB_BITS,
-         if no borrow we have 0 <=  bp[1] - cp[1] - x < B/2
-         where x = (bp[0] < cp[0]) is 0 or 1, thus a1 < B/2 <= bp[1] */
-      else if (a1 >= bp[1]) /* borrow: |c| > |b| */
+      else if (bo) /* borrow: |c| > |b| */
         {
           MPFR_SET_OPPOSITE_SIGN (a, b);
           /* negate [a1,a0] */
@@ -866,26 +833,16 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
              |      a1       |      a0       |
              |     bp[1]     |     bp[0]     |
              |    cp[1]>>d   |      t        |     sb     | */
-#ifndef MPFR_FULLSUB
-          a0 = bp[0] - t;
-          a1 = bp[1] - (cp[1] >> d) - (bp[0] < t);
           sb = cp[0] << (GMP_NUMB_BITS - d); /* neglected part of c */
-          /* now negate sb and subtract borrow to a0 if sb <> 0 */
-          if (sb)
-            {
-              a1 -= (a0 == 0);
-              a0 --;
-              /* a = a1,a0 can only be zero when d=1, b = 0.1000...000*2^bx,
-                 and c = 0.111...111*2^(bx-1). In that case (where we have
-                 sb = MPFR_LIMB_HIGHBIT below), the subtraction is exact, the
-                 result is b/2^(2*GMP_NUMB_BITS). This case is dealt below. */
-              sb = -sb;
-            }
-#else
-          sb = - (cp[0] << (GMP_NUMB_BITS - d));
-          a0 = bp[0] - t - (sb != 0);
-          a1 = bp[1] - (cp[1] >> d) - (bp[0] < t || (bp[0] == t && sb != 0));
-#endif
+          /* subtract sb too, i.e., negate sb and subtract a borrow from a0
+             if sb <> 0 */
+          MPFR_SUBB (a0, bo, bp[0], t, sb != 0);
+          a1 = bp[1] - (cp[1] >> d) - bo;
+          /* a = a1,a0 can only be zero when d=1, b = 0.1000...000*2^bx,
+             and c = 0.111...111*2^(bx-1). In that case (where we have
+             sb = MPFR_LIMB_HIGHBIT below), the subtraction is exact, the
+             result is b/2^(2*GMP_NUMB_BITS). This case is dealt below. */
+          sb = -sb;
           /* now the result is formed of [a1,a0,sb], which might not be
              normalized */
           if (a1 == MPFR_LIMB_ZERO)
@@ -935,11 +892,8 @@ mpfr_sub1sp2n (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
             : (cp[1] << (2*GMP_NUMB_BITS - d))
               | (cp[0] >> (d - GMP_NUMB_BITS))
               | ((cp[0] << (2*GMP_NUMB_BITS - d)) != 0);
-          t = (cp[1] >> (d - GMP_NUMB_BITS)) + (sb != 0);
-          /* Warning: t might overflow to 0 if d=GMP_NUMB_BITS, sb <> 0,
-             and cp[1] = 111...111 */
-          a0 = bp[0] - t;
-          a1 = bp[1] - (bp[0] < t) - (t == 0 && sb != 0);
+          MPFR_SUBB (a0, bo, bp[0], cp[1] >> (d - GMP_NUMB_BITS), sb != 0);
+          a1 = bp[1] - bo;
           sb = -sb;
           /* now the result is [a1,a0,sb]. Since bp[1] has its most significant
              bit set, we can have an exponent decrease of at most one */
@@ -1066,18 +1020,16 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
   mp_limb_t rb; /* round bit */
   mp_limb_t sb; /* sticky bit */
   mp_limb_t mask, a0, a1, a2;
+  mp_limb_t bo; /* borrow */
   mpfr_uexp_t d;
 
   MPFR_ASSERTD(2 * GMP_NUMB_BITS < p && p < 3 * GMP_NUMB_BITS);
 
   if (bx == cx) /* subtraction is exact in this case */
     {
-      a0 = bp[0] - cp[0];
-      a1 = bp[1] - cp[1] - (bp[0] < cp[0]);
-      /* a borrow is generated for a when either bp[1] < cp[1],
-         or bp[1] = cp[1] and bp[0] < cp[0] */
-      a2 = bp[2] - cp[2]
-        - (bp[1] < cp[1] || (bp[1] == cp[1] && bp[0] < cp[0]));
+      MPFR_SUBB (a0, bo, bp[0], cp[0], 0);
+      MPFR_SUBB (a1, bo, bp[1], cp[1], bo);
+      MPFR_SUBB (a2, bo, bp[2], cp[2], bo);
       if (a2 == 0 && a1 == 0 && a0 == 0) /* result is zero */
         {
           if (rnd_mode == MPFR_RNDD)
@@ -1087,7 +1039,7 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
           MPFR_SET_ZERO(a);
           MPFR_RET (0);
         }
-      else if (a2 >= bp[2]) /* borrow: |c| > |b| */
+      else if (bo) /* borrow: |c| > |b| */
         {
           MPFR_SET_OPPOSITE_SIGN (a, b);
           /* a = b-c mod 2^(3*GMP_NUMB_BITS) */
@@ -1151,29 +1103,22 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
       mask = MPFR_LIMB_MASK(sh);
       if (d < GMP_NUMB_BITS)
         {
-          mp_limb_t cy;
           /* warning: we must have the most significant bit of sb correct
              since it might become the round bit below */
           sb = cp[0] << (GMP_NUMB_BITS - d); /* neglected part of c */
-          a0 = bp[0] - ((cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d));
-          a1 = bp[1] - ((cp[2] << (GMP_NUMB_BITS - d)) | (cp[1] >> d))
-            - (a0 > bp[0]);
-          cy = a1 > bp[1] || (a1 == bp[1] && a0 > bp[0]); /* borrow in a1 */
-          a2 = bp[2] - (cp[2] >> d) - cy;
-          /* if sb is non-zero, subtract 1 from a2, a1, a0 since we want a
-             non-negative neglected part */
-          if (sb)
-            {
-              a2 -= (a1 == 0 && a0 == 0);
-              a1 -= (a0 == 0);
-              a0 --;
-              /* a = a2,a1,a0 cannot become zero here, since:
-                 a) if d >= 2, then a2 >= 2^(w-1) - (2^(w-2)-1) with
-                    w = GMP_NUMB_BITS, thus a2 - 1 >= 2^(w-2),
-                 b) if d = 1, then since p < 3*GMP_NUMB_BITS we have sb=0. */
-              MPFR_ASSERTD(a2 > 0 || a1 > 0 || a0 > 0);
-              sb = -sb; /* 2^GMP_NUMB_BITS - sb */
-            }
+          /* if sb is non-zero, subtract 1 from a2, a1, a0 (with the borrow
+             in) since we want a non-negative neglected part */
+          MPFR_SUBB (a0, bo, bp[0],
+                     (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d), sb != 0);
+          MPFR_SUBB (a1, bo, bp[1],
+                     (cp[2] << (GMP_NUMB_BITS - d)) | (cp[1] >> d), bo);
+          a2 = bp[2] - (cp[2] >> d) - bo;
+          /* a = a2,a1,a0 cannot be zero here when sb <> 0, since:
+             a) if d >= 2, then a2 >= 2^(w-1) - (2^(w-2)-1) with
+                w = GMP_NUMB_BITS, thus a2 - 1 >= 2^(w-2),
+             b) if d = 1, then since p < 3*GMP_NUMB_BITS we have sb=0. */
+          MPFR_ASSERTD(a2 > 0 || a1 > 0 || a0 > 0);
+          sb = -sb; /* 2^GMP_NUMB_BITS - sb */
           if (a2 == 0)
             {
               /* this implies d=1, which in turn implies sb=0 */
@@ -1221,25 +1166,14 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
             : (cp[1] << (2*GMP_NUMB_BITS - d)) | (cp[0] != 0);
           c0shifted = (d == GMP_NUMB_BITS) ? cp[1]
             : (cp[2] << (2*GMP_NUMB_BITS-d)) | (cp[1] >> (d - GMP_NUMB_BITS));
-          a0 = bp[0] - c0shifted;
+          /* if sb is non-zero, subtract 1 from a2, a1, a0 (with the borrow
+             in) since we want a non-negative neglected part */
+          MPFR_SUBB (a0, bo, bp[0], c0shifted, sb != 0);
           /* TODO: add a non-regression test for cp[2] == MPFR_LIMB_MAX,
-             d == GMP_NUMB_BITS and a0 > bp[0]. */
-          a1 = bp[1] - (cp[2] >> (d - GMP_NUMB_BITS)) - (a0 > bp[0]);
-          a2 = bp[2] - (a1 > bp[1] || (a1 == bp[1] && a0 > bp[0]));
-          /* if sb is non-zero, subtract 1 from a2, a1, a0 since we want a
-             non-negative neglected part */
-          if (sb)
-            {
-              a2 -= (a1 == 0 && a0 == 0);
-              a1 -= (a0 == 0);
-              a0 --;
-              /* a = a2,a1,a0 cannot become zero here, since:
-                 a) if d >= 2, then a2 >= 2^(w-1) - (2^(w-2)-1) with
-                    w = GMP_NUMB_BITS, thus a2 - 1 >= 2^(w-2),
-                 b) if d = 1, then since p < 3*GMP_NUMB_BITS we have sb=0. */
-              MPFR_ASSERTD(a2 > 0 || a1 > 0 || a0 > 0);
-              sb = -sb; /* 2^GMP_NUMB_BITS - sb */
-            }
+             d == GMP_NUMB_BITS and a borrow from a0. */
+          MPFR_SUBB (a1, bo, bp[1], cp[2] >> (d - GMP_NUMB_BITS), bo);
+          a2 = bp[2] - bo;
+          sb = -sb; /* 2^GMP_NUMB_BITS - sb */
           /* since bp[2] has its most significant bit set, we can have an
              exponent decrease of at most one */
           if (a2 < MPFR_LIMB_HIGHBIT)
@@ -1271,9 +1205,9 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
           sb = -sb;
           /* TODO: add a non-regression test for cp[2] == MPFR_LIMB_MAX,
              d == 2*GMP_NUMB_BITS and sb != 0. */
-          a0 = bp[0] - (cp[2] >> (d - 2*GMP_NUMB_BITS)) - (sb != 0);
-          a1 = bp[1] - (a0 > bp[0] || (a0 == bp[0] && sb != 0));
-          a2 = bp[2] - (a1 > bp[1]);
+          MPFR_SUBB (a0, bo, bp[0], cp[2] >> (d - 2*GMP_NUMB_BITS), sb != 0);
+          MPFR_SUBB (a1, bo, bp[1], 0, bo);
+          a2 = bp[2] - bo;
           if (a2 < MPFR_LIMB_HIGHBIT)
             {
               ap[2] = (a2 << 1) | (a1 >> (GMP_NUMB_BITS - 1));
@@ -1296,9 +1230,9 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
           /* We compute b - ulp(b), and the remainder ulp(b) - c satisfies:
              1/2 ulp(b) < ulp(b) - c < ulp(b), thus rb = sb = 1. */
           mp_limb_t t = MPFR_LIMB_ONE << sh;
-          a0 = bp[0] - t;
-          a1 = bp[1] - (bp[0] < t);
-          a2 = bp[2] - (a1 > bp[1]);
+          MPFR_SUBB (a0, bo, bp[0], t, 0);
+          MPFR_SUBB (a1, bo, bp[1], 0, bo);
+          a2 = bp[2] - bo;
           if (a2 < MPFR_LIMB_HIGHBIT)
             {
               /* necessarily we had b = 1000...000 */
@@ -1379,6 +1313,25 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
     }
 }
 
+/* Special code for 3*GMP_NUMB_BITS < p <= 8*GMP_NUMB_BITS, generated from
+   sub1sp_fixed.h: mpfr_sub1spN is used when MPFR_PREC2LIMBS(p) = N and the
+   exponents of b and c differ by less than GMP_NUMB_BITS. */
+#define FUNCTION mpfr_sub1sp4
+#define N 4
+#include "sub1sp_fixed.h"
+#define FUNCTION mpfr_sub1sp5
+#define N 5
+#include "sub1sp_fixed.h"
+#define FUNCTION mpfr_sub1sp6
+#define N 6
+#include "sub1sp_fixed.h"
+#define FUNCTION mpfr_sub1sp7
+#define N 7
+#include "sub1sp_fixed.h"
+#define FUNCTION mpfr_sub1sp8
+#define N 8
+#include "sub1sp_fixed.h"
+
 #endif /* !defined(MPFR_GENERIC_ABI) */
 
 /* Rounding Sub */
@@ -1433,7 +1386,7 @@ mpfr_sub1sp3 (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
  *
  */
 
-MPFR_HOT_FUNCTION_ATTR int
+MPFR_HOT_FUNCTION_ATTR MPFR_FMV_FUNCTION_ATTR int
 mpfr_sub1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 {
   mpfr_exp_t bx, cx;
@@ -1489,6 +1442,25 @@ mpfr_sub1sp (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode)
 
   if (p == 2 * GMP_NUMB_BITS)
     return mpfr_sub1sp2n (a, b, c, rnd_mode);
+
+  /* |EXP(b) - EXP(c)| < GMP_NUMB_BITS is tested with unsigned arithmetic,
+     which avoids an integer overflow */
+  if (3 * GMP_NUMB_BITS < p && p <= 8 * GMP_NUMB_BITS &&
+      (mpfr_uexp_t) MPFR_GET_EXP (b) - MPFR_GET_EXP (c) + (GMP_NUMB_BITS - 1)
+      < 2 * GMP_NUMB_BITS - 1)
+    switch (MPFR_PREC2LIMBS (p))
+      {
+      case 4:
+        return mpfr_sub1sp4 (a, b, c, rnd_mode, p);
+      case 5:
+        return mpfr_sub1sp5 (a, b, c, rnd_mode, p);
+      case 6:
+        return mpfr_sub1sp6 (a, b, c, rnd_mode, p);
+      case 7:
+        return mpfr_sub1sp7 (a, b, c, rnd_mode, p);
+      case 8:
+        return mpfr_sub1sp8 (a, b, c, rnd_mode, p);
+      }
 #endif
 
   n = MPFR_PREC2LIMBS (p);
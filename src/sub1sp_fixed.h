@@ -0,0 +1,197 @@
+/* mpfr_sub1spN -- subtract two floating-point numbers of N limbs
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Special code for (N-1)*GMP_NUMB_BITS < p = PREC(a) = PREC(b) = PREC(c)
+   <= N*GMP_NUMB_BITS, when the exponents of b and c differ by less than
+   GMP_NUMB_BITS (the other cases are left to the generic code). Before
+   including this file, define FUNCTION as the name of the function and N
+   as the number of limbs (see sub1sp.c). Since N is a constant, the
+   compiler can unroll the loops on the limbs.
+
+   Since d = |EXP(b) - EXP(c)| < GMP_NUMB_BITS, the part of c shifted out
+   fits in one limb, thus the difference {t, N} + sb/B computed below is
+   exact, even when a cancellation occurs. */
+
+static int
+FUNCTION (mpfr_ptr a, mpfr_srcptr b, mpfr_srcptr c, mpfr_rnd_t rnd_mode,
+          mpfr_prec_t p)
+{
+  mpfr_exp_t bx = MPFR_GET_EXP (b);
+  mpfr_exp_t cx = MPFR_GET_EXP (c);
+  mp_limb_t *ap = MPFR_MANT(a);
+  mp_limb_t *bp = MPFR_MANT(b);
+  mp_limb_t *cp = MPFR_MANT(c);
+  mpfr_prec_t cnt, sh = N * GMP_NUMB_BITS - p;
+  mp_limb_t t[N], rb, sb, x, mask = MPFR_LIMB_MASK(sh);
+  mp_limb_t bo; /* borrow */
+  mpfr_uexp_t d;
+  int i;
+
+  MPFR_ASSERTD((N - 1) * GMP_NUMB_BITS < p && p <= N * GMP_NUMB_BITS);
+
+  if (bx == cx)
+    {
+      sb = 0;
+      MPFR_SUBB (t[0], bo, bp[0], cp[0], 0);
+      for (i = 1; i < N; i++)
+        MPFR_SUBB (t[i], bo, bp[i], cp[i], bo);
+      x = t[0];
+      for (i = 1; i < N; i++)
+        x |= t[i];
+      if (x == 0) /* result is zero */
+        {
+          if (rnd_mode == MPFR_RNDD)
+            MPFR_SET_NEG(a);
+          else
+            MPFR_SET_POS(a);
+          MPFR_SET_ZERO(a);
+          MPFR_RET (0);
+        }
+      else if (bo) /* borrow: |c| > |b| */
+        {
+          MPFR_SET_OPPOSITE_SIGN (a, b);
+          /* a = b-c mod 2^(N*GMP_NUMB_BITS) */
+          MPFR_SUBB (t[0], bo, 0, t[0], 0);
+          for (i = 1; i < N; i++)
+            MPFR_SUBB (t[i], bo, 0, t[i], bo);
+        }
+      else
+        MPFR_SET_SAME_SIGN (a, b);
+    }
+  else
+    {
+      if (bx < cx)  /* swap b and c */
+        {
+          mpfr_exp_t tx;
+          mp_limb_t *tp;
+          tx = bx; bx = cx; cx = tx;
+          tp = bp; bp = cp; cp = tp;
+          MPFR_SET_OPPOSITE_SIGN (a, b);
+        }
+      else
+        {
+          MPFR_SET_SAME_SIGN (a, b);
+        }
+      d = (mpfr_uexp_t) bx - cx;
+      MPFR_ASSERTD(0 < d && d < GMP_NUMB_BITS);
+      sb = cp[0] << (GMP_NUMB_BITS - d); /* neglected part of c */
+      /* if sb is non-zero, subtract 1 from {t, N} (with the borrow in)
+         since we want a non-negative neglected part */
+      MPFR_SUBB (t[0], bo, bp[0],
+                 (cp[1] << (GMP_NUMB_BITS - d)) | (cp[0] >> d), sb != 0);
+      for (i = 1; i < N - 1; i++)
+        MPFR_SUBB (t[i], bo, bp[i],
+                   (cp[i + 1] << (GMP_NUMB_BITS - d)) | (cp[i] >> d), bo);
+      t[N - 1] = bp[N - 1] - (cp[N - 1] >> d) - bo;
+      sb = -sb;
+    }
+
+  /* now {t, N} + sb/B is non-zero; leading zero limbs can only occur when
+     d <= 1 */
+  while (t[N - 1] == 0)
+    {
+      for (i = N - 1; i > 0; i--)
+        t[i] = t[i - 1];
+      t[0] = sb;
+      sb = 0;
+      bx -= GMP_NUMB_BITS;
+    }
+  count_leading_zeros (cnt, t[N - 1]);
+  if (cnt)
+    {
+      for (i = N - 1; i > 0; i--)
+        t[i] = (t[i] << cnt) | (t[i - 1] >> (GMP_NUMB_BITS - cnt));
+      t[0] = (t[0] << cnt) | (sb >> (GMP_NUMB_BITS - cnt));
+      sb <<= cnt;
+      bx -= cnt;
+    }
+
+  if (sh == 0)
+    {
+      rb = sb & MPFR_LIMB_HIGHBIT;
+      sb ^= rb;
+    }
+  else
+    {
+      rb = t[0] & (MPFR_LIMB_ONE << (sh - 1));
+      sb |= (t[0] & mask) ^ rb;
+      t[0] &= ~mask;
+    }
+  for (i = 0; i < N; i++)
+    ap[i] = t[i];
+
+  /* now perform rounding */
+
+  /* Warning: MPFR considers underflow *after* rounding with an unbounded
+     exponent range. However, since b and c have same precision p, they are
+     multiples of 2^(emin-p), likewise for b-c. Thus if bx < emin, the
+     subtraction (with an unbounded exponent range) is exact, so that bx is
+     also the exponent after rounding with an unbounded exponent range. */
+  if (MPFR_UNLIKELY(bx < __gmpfr_emin))
+    {
+      /* for RNDN, mpfr_underflow always rounds away, thus for |a|<=2^(emin-2)
+         we have to change to RNDZ */
+      if (rnd_mode == MPFR_RNDN)
+        {
+          x = ap[N - 1] ^ MPFR_LIMB_HIGHBIT;
+          for (i = 0; i < N - 1; i++)
+            x |= ap[i];
+          if (bx < __gmpfr_emin - 1 || x == 0)
+            rnd_mode = MPFR_RNDZ;
+        }
+      return mpfr_underflow (a, rnd_mode, MPFR_SIGN(a));
+    }
+
+  MPFR_SET_EXP (a, bx);
+  if ((rb == 0 && sb == 0) || rnd_mode == MPFR_RNDF)
+    MPFR_RET (0);
+  else if (rnd_mode == MPFR_RNDN)
+    {
+      if (rb == 0 || (sb == 0 && (ap[0] & (MPFR_LIMB_ONE << sh)) == 0))
+        goto truncate;
+      else
+        goto add_one_ulp;
+    }
+  else if (MPFR_IS_LIKE_RNDZ(rnd_mode, MPFR_IS_NEG(a)))
+    {
+    truncate:
+      MPFR_RET(-MPFR_SIGN(a));
+    }
+  else /* round away from zero */
+    {
+    add_one_ulp:
+      ap[0] += MPFR_LIMB_ONE << sh;
+      for (i = 1; i < N && ap[i - 1] == 0; i++)
+        ap[i] ++;
+      if (MPFR_UNLIKELY(ap[N - 1] == 0))
+        {
+          ap[N - 1] = MPFR_LIMB_HIGHBIT;
+          /* Note: bx+1 cannot exceed __gmpfr_emax, since |a| <= |b|, thus
+             bx+1 is at most equal to the original exponent of b. */
+          MPFR_ASSERTD(bx + 1 <= __gmpfr_emax);
+          MPFR_SET_EXP (a, bx + 1);
+        }
+      MPFR_RET(MPFR_SIGN(a));
+    }
+}
+
+#undef FUNCTION
+#undef N
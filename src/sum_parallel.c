@@ -0,0 +1,126 @@
+/* mpfr_sum_parallel -- sum of an array of numbers, using several threads
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* The array is split into nthreads chunks of consecutive terms, and each
+   chunk is added exactly to its own accumulator (see sumacc.c) by its own
+   thread, the first chunk being done by the calling thread. Then the
+   partial accumulators are merged, exactly, and the sum is rounded once,
+   like in mpfr_sum: the result, the ternary value and the flags do not
+   depend on the number of threads and are the same as with mpfr_sum.
+
+   The terms are only read by the threads, which do not touch the flags.
+   But the exponent range of a new thread is the default one, so that the
+   one of the caller is copied, as the exponents of the terms are checked
+   against it in some debug builds.
+
+   When MPFR has not been built with --enable-parallel, or when there are
+   too few terms per thread for the threads to be worth it, this is just
+   mpfr_sum. */
+
+/* minimum number of terms per thread */
+#ifndef MPFR_SUM_PARALLEL_THRESHOLD
+# define MPFR_SUM_PARALLEL_THRESHOLD 1024
+#endif
+
+#ifdef MPFR_HAVE_THREADS
+
+typedef struct {
+  const mpfr_ptr *tab;
+  unsigned long n;
+  mpfr_exp_t emin, emax;
+  mpfr_sumacc_t acc;
+} mpfr_sum_chunk_t;
+
+MPFR_THREAD_FUNC (sum_chunk, arg)
+{
+  mpfr_sum_chunk_t *c = (mpfr_sum_chunk_t *) arg;
+
+  mpfr_set_emin (c->emin);
+  mpfr_set_emax (c->emax);
+  mpfr_sumacc_add_array (c->acc, c->tab, c->n);
+  MPFR_THREAD_RETURN;
+}
+
+#endif
+
+int
+mpfr_sum_parallel (mpfr_ptr sum, const mpfr_ptr *tab, unsigned long n,
+                   unsigned int nthreads, mpfr_rnd_t rnd)
+{
+#ifdef MPFR_HAVE_THREADS
+  mpfr_sum_chunk_t *c;
+  MPFR_THREAD_T *thr;
+  char *started;
+  unsigned long q, r, i;
+  unsigned int k;
+  int inex;
+  MPFR_TMP_DECL (marker);
+
+  if (nthreads > n / MPFR_SUM_PARALLEL_THRESHOLD)
+    nthreads = n / MPFR_SUM_PARALLEL_THRESHOLD;
+  if (nthreads <= 1)
+    return mpfr_sum (sum, tab, n, rnd);
+
+  MPFR_TMP_MARK (marker);
+  c = (mpfr_sum_chunk_t *) MPFR_TMP_ALLOC (nthreads * sizeof *c);
+  thr = (MPFR_THREAD_T *) MPFR_TMP_ALLOC (nthreads * sizeof *thr);
+  started = (char *) MPFR_TMP_ALLOC (nthreads);
+
+  /* chunk k has q or q+1 terms */
+  q = n / nthreads;
+  r = n % nthreads;
+  for (k = 0, i = 0; k < nthreads; k++)
+    {
+      c[k].tab = tab + i;
+      c[k].n = q + (k < r);
+      c[k].emin = __gmpfr_emin;
+      c[k].emax = __gmpfr_emax;
+      mpfr_sumacc_init (c[k].acc);
+      i += c[k].n;
+    }
+  MPFR_ASSERTD (i == n);
+
+  /* If a thread cannot be created, its chunk is done at the end by the
+     calling thread. */
+  for (k = 1; k < nthreads; k++)
+    started[k] = MPFR_THREAD_CREATE (thr[k], sum_chunk, &c[k]);
+  mpfr_sumacc_add_array (c[0].acc, c[0].tab, c[0].n);
+  for (k = 1; k < nthreads; k++)
+    {
+      if (started[k])
+        MPFR_THREAD_JOIN (thr[k]);
+      else
+        mpfr_sumacc_add_array (c[k].acc, c[k].tab, c[k].n);
+      mpfr_sumacc_merge (c[0].acc, c[k].acc);
+      mpfr_sumacc_clear (c[k].acc);
+    }
+
+  inex = mpfr_sumacc_get (sum, c[0].acc, rnd);
+  mpfr_sumacc_clear (c[0].acc);
+  MPFR_TMP_FREE (marker);
+  return inex;
+#else
+  (void) nthreads;
+  return mpfr_sum (sum, tab, n, rnd);
+#endif
+}
@@ -0,0 +1,586 @@
+/* mpfr_sumacc_* -- exact accumulation of a sequence of terms, with a
+   correct rounding of the sum at the end
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#define MPFR_NEED_LONGLONG_H
+#include "mpfr-impl.h"
+
+/* The terms are accumulated exactly, so that the order of the additions
+   does not matter and cancellations are not an issue: the sum of the
+   terms is only rounded at the end by mpfr_sumacc_get, which views the
+   blocks as MPFR numbers (after a change of sign when negative) and
+   calls mpfr_sum on them. Thus, the same correct rounding and special
+   value rules as mpfr_sum apply.
+
+   Everything is done on limb indices (a limb index i corresponds to the
+   bits of weight 2^(i*GMP_NUMB_BITS) to 2^((i+1)*GMP_NUMB_BITS-1)), which
+   are much smaller than the exponents, so that the exponent of any term
+   (e.g. the exponent of an exact product, up to 2*MPFR_EMAX_MAX) can be
+   handled without integer overflow.
+
+   Invariant: if B = size * GMP_NUMB_BITS, the value V of a block satisfies
+   -2^(B-GMP_NUMB_BITS-1) <= V < 2^(B-GMP_NUMB_BITS-1), i.e. the most
+   significant limb is a sign extension of the next one. A term T of tn
+   limbs can be added at limb index lo when lo + tn <= block lo + size - 2,
+   so that |T| < 2^(B-2*GMP_NUMB_BITS), and |V+T| < 2^(B-1) is still
+   representable; if the invariant no longer holds after the addition,
+   one sign extension limb is added.
+
+   A term is added to the block that needs the smallest extension. If this
+   extension would be more than SUMACC_GAP limbs larger than the block and
+   the term together, a new block is created instead. */
+
+#define SUMACC_GAP 4
+
+void
+mpfr_sumacc_init (mpfr_sumacc_ptr acc)
+{
+  acc->_mpfr_blk = NULL;
+  acc->_mpfr_nblk = 0;
+  acc->_mpfr_ablk = 0;
+  acc->_mpfr_tmp = NULL;
+  acc->_mpfr_tmp_alloc = 0;
+  acc->_mpfr_flags = 0;
+}
+
+void
+mpfr_sumacc_clear (mpfr_sumacc_ptr acc)
+{
+  int k;
+
+  for (k = 0; k < acc->_mpfr_nblk; k++)
+    mpfr_free_func (acc->_mpfr_blk[k].d,
+                    acc->_mpfr_blk[k].alloc * MPFR_BYTES_PER_MP_LIMB);
+  if (acc->_mpfr_ablk != 0)
+    mpfr_free_func (acc->_mpfr_blk,
+                    acc->_mpfr_ablk * sizeof (mpfr_sumacc_block_t));
+  if (acc->_mpfr_tmp_alloc != 0)
+    mpfr_free_func (acc->_mpfr_tmp,
+                    acc->_mpfr_tmp_alloc * MPFR_BYTES_PER_MP_LIMB);
+  mpfr_sumacc_init (acc);
+}
+
+/* Extend the block b by nl limbs below and nh limbs above, the new
+   limbs above being a sign extension. */
+static void
+sumacc_grow (mpfr_sumacc_block_t *b, mp_size_t nl, mp_size_t nh)
+{
+  mp_size_t n = b->size + nl + nh;
+  mp_limb_t ext;
+
+  if (n > b->alloc)
+    {
+      mp_size_t alloc = MAX (n, 2 * b->alloc);
+
+      b->d = (mp_limb_t *) mpfr_reallocate_func
+        (b->d, b->alloc * MPFR_BYTES_PER_MP_LIMB,
+         alloc * MPFR_BYTES_PER_MP_LIMB);
+      b->alloc = alloc;
+    }
+
+  ext = MPFR_LIMB_MSB (b->d[b->size - 1]) != 0 ? MPFR_LIMB_MAX : 0;
+  for (; nh > 0; nh--)
+    b->d[b->size++] = ext;
+
+  if (nl > 0)
+    {
+      memmove (b->d + nl, b->d, b->size * MPFR_BYTES_PER_MP_LIMB);
+      MPN_ZERO (b->d, nl);
+      b->size += nl;
+      b->lo -= nl;
+    }
+
+  MPFR_ASSERTD (b->size == n);
+}
+
+/* Add (-1)^neg * {tp, tn} * 2^(lo*GMP_NUMB_BITS) to the accumulator. */
+static void
+sumacc_add_aligned (mpfr_sumacc_ptr acc, const mp_limb_t *tp, mp_size_t tn,
+                    mpfr_exp_t lo, int neg)
+{
+  mpfr_sumacc_block_t *b;
+  mpfr_exp_t hi = lo + tn;
+  mpfr_uexp_t ext = 0;
+  mp_size_t nl = 0, nh = 0, off, rest;
+  int k, best = -1;
+
+  for (k = 0; k < acc->_mpfr_nblk; k++)
+    {
+      mpfr_exp_t blo = acc->_mpfr_blk[k].lo;
+      mpfr_exp_t bhi = blo + acc->_mpfr_blk[k].size - 2;
+      mpfr_uexp_t l, h;
+
+      l = lo < blo ? (mpfr_uexp_t) blo - (mpfr_uexp_t) lo : 0;
+      h = hi > bhi ? (mpfr_uexp_t) hi - (mpfr_uexp_t) bhi : 0;
+      if (best < 0 || l + h < ext)
+        {
+          best = k;
+          ext = l + h;
+          if (ext == 0)
+            break;
+        }
+    }
+
+  if (best >= 0 &&
+      ext <= (mpfr_uexp_t) acc->_mpfr_blk[best].size + tn + SUMACC_GAP)
+    {
+      b = acc->_mpfr_blk + best;
+      if (ext != 0)
+        {
+          mpfr_exp_t bhi = b->lo + b->size - 2;
+
+          nl = lo < b->lo ? b->lo - lo : 0;
+          nh = hi > bhi ? hi - bhi : 0;
+          sumacc_grow (b, nl, nh);
+        }
+    }
+  else
+    {
+      if (acc->_mpfr_nblk == acc->_mpfr_ablk)
+        {
+          int ablk = acc->_mpfr_ablk == 0 ? 4 : 2 * acc->_mpfr_ablk;
+
+          acc->_mpfr_blk = (mpfr_sumacc_block_t *) (acc->_mpfr_ablk == 0 ?
+            mpfr_allocate_func (ablk * sizeof (mpfr_sumacc_block_t)) :
+            mpfr_reallocate_func
+            (acc->_mpfr_blk, acc->_mpfr_ablk * sizeof (mpfr_sumacc_block_t),
+             ablk * sizeof (mpfr_sumacc_block_t)));
+          acc->_mpfr_ablk = ablk;
+        }
+      b = acc->_mpfr_blk + acc->_mpfr_nblk++;
+      b->size = tn + 2;
+      b->alloc = b->size;
+      b->d = (mp_limb_t *) mpfr_allocate_func (b->alloc
+                                               * MPFR_BYTES_PER_MP_LIMB);
+      MPN_ZERO (b->d, b->size);
+      b->lo = lo;
+    }
+
+  off = lo - b->lo;
+  rest = b->size - off - tn;
+  MPFR_ASSERTD (off >= 0 && rest >= 2);
+  if (neg)
+    {
+      if (mpn_sub_n (b->d + off, b->d + off, tp, tn))
+        mpn_sub_1 (b->d + off + tn, b->d + off + tn, rest, 1);
+    }
+  else
+    {
+      if (mpn_add_n (b->d + off, b->d + off, tp, tn))
+        mpn_add_1 (b->d + off + tn, b->d + off + tn, rest, 1);
+    }
+
+  /* restore the invariant */
+  {
+    mp_limb_t top = b->d[b->size - 1];
+    mp_limb_t sgn = MPFR_LIMB_MSB (b->d[b->size - 2]);
+
+    if (! ((top == 0 && sgn == 0) || (top == MPFR_LIMB_MAX && sgn != 0)))
+      sumacc_grow (b, 0, 1);
+  }
+}
+
+/* Add (-1)^neg * {xp, xn} * 2^(e-xn*GMP_NUMB_BITS), where xp[xn-1] is
+   non-zero, using the xn+1 limbs at tp as scratch space (tp may be xp). */
+static void
+sumacc_add_regular (mpfr_sumacc_ptr acc, const mp_limb_t *xp, mp_size_t xn,
+                    mpfr_exp_t e, int neg, mp_limb_t *tp)
+{
+  mpfr_exp_t qe, lo;
+  int re;
+
+  MPFR_ASSERTD (xn > 0 && xp[xn - 1] != 0);
+
+  acc->_mpfr_flags |= MPFR_SUMACC_REG;
+
+  /* e = qe * GMP_NUMB_BITS + re with 0 <= re < GMP_NUMB_BITS */
+  qe = e / GMP_NUMB_BITS;
+  re = (int) (e - qe * GMP_NUMB_BITS);
+  if (re < 0)
+    {
+      qe--;
+      re += GMP_NUMB_BITS;
+    }
+  lo = qe - xn;
+
+  if (re != 0)
+    {
+      tp[xn] = mpn_lshift (tp, xp, xn, re);
+      xp = tp;
+      if (xp[xn] != 0)
+        xn++;
+    }
+
+  /* Skip the low zero limbs (e.g. for small integers or products of
+     numbers with many trailing zeros). */
+  while (xp[0] == 0)
+    {
+      xp++;
+      xn--;
+      lo++;
+    }
+
+  sumacc_add_aligned (acc, xp, xn, lo, neg);
+}
+
+/* Add the MPFR number x to the accumulator. */
+void
+mpfr_sumacc_add (mpfr_sumacc_ptr acc, mpfr_srcptr x)
+{
+  mp_size_t xn;
+
+  if (MPFR_UNLIKELY (MPFR_IS_SINGULAR (x)))
+    {
+      if (MPFR_IS_NAN (x))
+        acc->_mpfr_flags |= MPFR_SUMACC_NAN;
+      else if (MPFR_IS_INF (x))
+        acc->_mpfr_flags |=
+          MPFR_IS_POS (x) ? MPFR_SUMACC_PINF : MPFR_SUMACC_NINF;
+      else
+        acc->_mpfr_flags |=
+          MPFR_IS_POS (x) ? MPFR_SUMACC_PZERO : MPFR_SUMACC_NZERO;
+      return;
+    }
+
+  xn = MPFR_LIMB_SIZE (x);
+  if (acc->_mpfr_tmp_alloc <= xn)
+    {
+      mp_size_t talloc = MAX (xn + 1, 2 * acc->_mpfr_tmp_alloc);
+
+      acc->_mpfr_tmp = (mp_limb_t *) (acc->_mpfr_tmp_alloc == 0 ?
+        mpfr_allocate_func (talloc * MPFR_BYTES_PER_MP_LIMB) :
+        mpfr_reallocate_func (acc->_mpfr_tmp,
+                              acc->_mpfr_tmp_alloc * MPFR_BYTES_PER_MP_LIMB,
+                              talloc * MPFR_BYTES_PER_MP_LIMB));
+      acc->_mpfr_tmp_alloc = talloc;
+    }
+  sumacc_add_regular (acc, MPFR_MANT (x), xn, MPFR_GET_EXP (x),
+                      MPFR_IS_NEG (x), acc->_mpfr_tmp);
+}
+
+/* Add the n numbers tab[0], ..., tab[n-1] to the accumulator. */
+void
+mpfr_sumacc_add_array (mpfr_sumacc_ptr acc, const mpfr_ptr *tab,
+                       unsigned long n)
+{
+  unsigned long i;
+
+  for (i = 0; i < n; i++)
+    mpfr_sumacc_add (acc, tab[i]);
+}
+
+/* Add (-1)^neg * {xp, xn} * 2^(e-xn*GMP_NUMB_BITS) to the accumulator,
+   where xp[xn-1] may be zero (for instance, if {xp, xn} is the product
+   of two significands), but {xp, xn} must not be zero. The exponent e
+   can be any value of the mpfr_exp_t type. The xn+1 limbs at xp may be
+   overwritten, so that no copy is needed. */
+void
+mpfr_sumacc_add_limbs (mpfr_sumacc_ptr acc, mp_limb_t *xp, mp_size_t xn,
+                       mpfr_exp_t e, int neg)
+{
+  while (xp[xn - 1] == 0)
+    {
+      xn--;
+      e -= GMP_NUMB_BITS;
+    }
+  sumacc_add_regular (acc, xp, xn, e, neg, xp);
+}
+
+/* Add the sum held by the accumulator src to acc, exactly. This is used
+   to merge partial sums computed separately (e.g. by different threads),
+   so that the result of mpfr_sumacc_get is the same as if all the terms
+   had been added to acc. */
+void
+mpfr_sumacc_merge (mpfr_sumacc_ptr acc, mpfr_sumacc_srcptr src)
+{
+  int k;
+
+  acc->_mpfr_flags |= src->_mpfr_flags;
+
+  for (k = 0; k < src->_mpfr_nblk; k++)
+    {
+      const mpfr_sumacc_block_t *b = src->_mpfr_blk + k;
+      mp_size_t n = b->size, l = 0;
+      mp_limb_t *tp;
+      int neg;
+
+      if (acc->_mpfr_tmp_alloc < n)
+        {
+          mp_size_t talloc = MAX (n, 2 * acc->_mpfr_tmp_alloc);
+
+          acc->_mpfr_tmp = (mp_limb_t *) (acc->_mpfr_tmp_alloc == 0 ?
+            mpfr_allocate_func (talloc * MPFR_BYTES_PER_MP_LIMB) :
+            mpfr_reallocate_func (acc->_mpfr_tmp,
+                                  acc->_mpfr_tmp_alloc
+                                  * MPFR_BYTES_PER_MP_LIMB,
+                                  talloc * MPFR_BYTES_PER_MP_LIMB));
+          acc->_mpfr_tmp_alloc = talloc;
+        }
+      tp = acc->_mpfr_tmp;
+
+      /* absolute value and sign of the block */
+      neg = MPFR_LIMB_MSB (b->d[n - 1]) != 0;
+      if (neg)
+        {
+          mpn_com (tp, b->d, n);
+          mpn_add_1 (tp, tp, n, 1);
+        }
+      else
+        MPN_COPY (tp, b->d, n);
+      while (n > 0 && tp[n - 1] == 0)
+        n--;
+      if (n == 0)
+        continue;  /* the terms of this block have cancelled */
+      while (tp[l] == 0)
+        l++;
+
+      sumacc_add_aligned (acc, tp + l, n - l, b->lo + l, neg);
+    }
+}
+
+/* Set res to the exact zero sum. Same rules as mpfr_sum: if there were
+   regular terms (that have cancelled) or zeros of both signs, the sign
+   is + except in MPFR_RNDD; otherwise this is the sign of the zeros, if
+   any. */
+static int
+sumacc_zero (mpfr_ptr res, mpfr_sumacc_srcptr acc, mpfr_rnd_t rnd)
+{
+  MPFR_SET_ZERO (res);
+  if ((acc->_mpfr_flags & MPFR_SUMACC_REG) ||
+      (acc->_mpfr_flags & (MPFR_SUMACC_PZERO | MPFR_SUMACC_NZERO)) ==
+      (MPFR_SUMACC_PZERO | MPFR_SUMACC_NZERO))
+    {
+      if (rnd == MPFR_RNDD)
+        MPFR_SET_NEG (res);
+      else
+        MPFR_SET_POS (res);
+    }
+  else if (acc->_mpfr_flags & MPFR_SUMACC_NZERO)
+    MPFR_SET_NEG (res);
+  else
+    MPFR_SET_POS (res);
+  MPFR_RET (0);
+}
+
+/* Set res to the sum of the m numbers tab[k], rounded in the direction
+   rnd, and return the ternary value. The exponent of tab[k] is relative
+   to the limb index top[k], and low[k] is the limb index of its least
+   significant limb; the numbers are sorted by decreasing top[k]. The
+   exponent of res is relative to the limb index *base. This must be
+   called in the extended exponent range.
+
+   Usually, the numbers are close to each other and their exponents are
+   just made relative to top[0] before calling mpfr_sum. But in general,
+   the relative exponents may not be representable (e.g. for the sum of
+   2^(2*MPFR_EMAX_MAX) and 2^(2*MPFR_EMIN_MIN)). So the numbers are split
+   into a first cluster, i.e. the numbers tab[0..j-1], which is separated
+   from the next ones by a large enough gap, and the remaining ones. If
+   the sum of the first cluster is zero, the result is the sum of the
+   remaining numbers. Otherwise this sum is a non-zero multiple of
+   2^(low*GMP_NUMB_BITS), where low is the limb index of the least
+   significant limb of the cluster, and the remaining numbers can only
+   affect the rounding through the sign of their sum (if it is non-zero),
+   which is computed recursively: they are replaced by a single number
+   of the same sign below the rounding bits, like in mpfr_sum. Since the
+   size of a cluster is bounded by the memory, its relative exponents are
+   representable. */
+static int
+sumacc_round (mpfr_ptr res, mpfr_ptr *tab, mpfr_exp_t *top, mpfr_exp_t *low,
+              int m, mpfr_rnd_t rnd, mpfr_exp_t *base)
+{
+  mpfr_prec_t p = MPFR_PREC (res);
+  mpfr_exp_t lo = low[0], gap, dummy;
+  mpfr_t t, z;
+  mp_limb_t tl[1], zl[1];
+  int j, k;
+
+  /* The sum of the numbers after the gap is less than 2^(int bits) times
+     the largest one, thus less than 2^(low*GMP_NUMB_BITS-p-2). */
+  gap = (p + 2 + (mpfr_prec_t) (sizeof (int) * CHAR_BIT)) / GMP_NUMB_BITS
+    + 1;
+  for (j = 1; j < m && top[j] > lo - gap; j++)
+    if (low[j] < lo)
+      lo = low[j];
+
+  *base = top[0];
+  MPFR_ASSERTN (lo - top[0] > (MPFR_EMIN_MIN + p + 3) / GMP_NUMB_BITS + 2);
+  for (k = 0; k < j; k++)
+    MPFR_EXP (tab[k]) += (top[k] - top[0]) * GMP_NUMB_BITS;
+
+  if (j == m)
+    return mpfr_sum (res, tab, m, rnd);
+
+  MPFR_TMP_INIT1 (tl, t, MPFR_PREC_MIN);
+  mpfr_sum (t, tab, j, MPFR_RNDZ);
+  if (MPFR_IS_ZERO (t))
+    return sumacc_round (res, tab + j, top + j, low + j, m - j, rnd, base);
+
+  sumacc_round (t, tab + j, top + j, low + j, m - j, MPFR_RNDZ, &dummy);
+  if (MPFR_IS_ZERO (t))
+    return mpfr_sum (res, tab, j, rnd);
+
+  /* |z| = 2^(low*GMP_NUMB_BITS-p-3) */
+  MPFR_TMP_INIT1 (zl, z, MPFR_PREC_MIN);
+  zl[0] = MPFR_LIMB_HIGHBIT;
+  MPFR_SET_SAME_SIGN (z, t);
+  MPFR_SET_EXP (z, (lo - top[0]) * GMP_NUMB_BITS - p - 2);
+  tab[j] = z;
+  return mpfr_sum (res, tab, j + 1, rnd);
+}
+
+/* Set res to the sum of the terms added to the accumulator, rounded in
+   the direction rnd, and return the ternary value. The accumulator is
+   not modified. */
+int
+mpfr_sumacc_get (mpfr_ptr res, mpfr_sumacc_srcptr acc, mpfr_rnd_t rnd)
+{
+  mpfr_ptr *tab;
+  mpfr_exp_t *top, *low;
+  mp_limb_t *tp;
+  mp_size_t total = 0;
+  mpfr_exp_t base;
+  int k, m, cnt, inex;
+  MPFR_SAVE_EXPO_DECL (expo);
+  MPFR_TMP_DECL (marker);
+  MPFR_LOG_FUNC
+    (("rnd=%d", rnd),
+     ("res[%Pd]=%.*Rg", mpfr_get_prec (res), mpfr_log_prec, res));
+
+  if (MPFR_UNLIKELY ((acc->_mpfr_flags & MPFR_SUMACC_NAN) ||
+                     ((acc->_mpfr_flags & MPFR_SUMACC_PINF) &&
+                      (acc->_mpfr_flags & MPFR_SUMACC_NINF))))
+    {
+      MPFR_SET_NAN (res);
+      MPFR_RET_NAN;
+    }
+
+  if (MPFR_UNLIKELY (acc->_mpfr_flags & (MPFR_SUMACC_PINF | MPFR_SUMACC_NINF)))
+    {
+      MPFR_SET_INF (res);
+      if (acc->_mpfr_flags & MPFR_SUMACC_PINF)
+        MPFR_SET_POS (res);
+      else
+        MPFR_SET_NEG (res);
+      MPFR_RET (0);
+    }
+
+  if (acc->_mpfr_nblk == 0)
+    return sumacc_zero (res, acc, rnd);
+
+  MPFR_TMP_MARK (marker);
+
+  for (k = 0; k < acc->_mpfr_nblk; k++)
+    total += acc->_mpfr_blk[k].size;
+  tp = MPFR_TMP_LIMBS_ALLOC (total);
+  tab = (mpfr_ptr *) MPFR_TMP_ALLOC (acc->_mpfr_nblk * sizeof (mpfr_ptr));
+  top = (mpfr_exp_t *) MPFR_TMP_ALLOC (acc->_mpfr_nblk * sizeof (mpfr_exp_t));
+  low = (mpfr_exp_t *) MPFR_TMP_ALLOC (acc->_mpfr_nblk * sizeof (mpfr_exp_t));
+
+  /* Convert the non-zero blocks to MPFR numbers, sorted by decreasing
+     limb index of their most significant limb (insertion sort, as there
+     are very few blocks in practice). */
+  m = 0;
+  for (k = 0; k < acc->_mpfr_nblk; k++)
+    {
+      const mpfr_sumacc_block_t *b = acc->_mpfr_blk + k;
+      mp_size_t n = b->size, l = 0;
+      mpfr_ptr x;
+      int i, neg;
+
+      while (n > 0 && b->d[n - 1] == 0)
+        n--;
+      if (n == 0)
+        continue;  /* the terms of this block have cancelled */
+
+      n = b->size;
+      neg = MPFR_LIMB_MSB (b->d[n - 1]) != 0;
+      if (neg)
+        {
+          mpn_com (tp, b->d, n);
+          mpn_add_1 (tp, tp, n, 1);
+        }
+      else
+        MPN_COPY (tp, b->d, n);
+      while (tp[n - 1] == 0)
+        n--;
+      while (tp[l] == 0)
+        l++;
+      count_leading_zeros (cnt, tp[n - 1]);
+      if (cnt != 0)
+        mpn_lshift (tp + l, tp + l, n - l, cnt);
+
+      x = (mpfr_ptr) MPFR_TMP_ALLOC (sizeof (mpfr_t));
+      MPFR_ASSERTN (n - l <= MPFR_PREC_MAX / GMP_NUMB_BITS);
+      MPFR_PREC (x) = (mpfr_prec_t) (n - l) * GMP_NUMB_BITS;
+      MPFR_SET_SIGN (x, neg ? MPFR_SIGN_NEG : MPFR_SIGN_POS);
+      MPFR_MANT (x) = tp + l;
+      MPFR_EXP (x) = - cnt;  /* relative to the limb index b->lo + n */
+
+      for (i = m; i > 0 && top[i - 1] < b->lo + n; i--)
+        {
+          tab[i] = tab[i - 1];
+          top[i] = top[i - 1];
+          low[i] = low[i - 1];
+        }
+      tab[i] = x;
+      top[i] = b->lo + n;
+      low[i] = b->lo + l;
+      m++;
+      tp += b->size;
+    }
+
+  if (m == 0)
+    {
+      MPFR_TMP_FREE (marker);
+      return sumacc_zero (res, acc, rnd);
+    }
+
+  MPFR_SAVE_EXPO_MARK (expo);
+  inex = sumacc_round (res, tab, top, low, m, rnd, &base);
+  MPFR_SAVE_EXPO_FREE (expo);
+  MPFR_TMP_FREE (marker);
+
+  if (MPFR_NOTZERO (res))
+    {
+      mpfr_exp_t e = MPFR_EXP (res), qe;
+
+      /* The exponent of the result is e + base * GMP_NUMB_BITS, which
+         is computed in limb units so that it is saturated (in a way
+         compatible with mpfr_check_range) instead of overflowing. */
+      qe = e / GMP_NUMB_BITS;
+      e -= qe * GMP_NUMB_BITS;
+      if (e < 0)
+        {
+          qe--;
+          e += GMP_NUMB_BITS;
+        }
+      qe += base;
+      if (qe > MPFR_EMAX_MAX / GMP_NUMB_BITS + 1)
+        e = MPFR_EMAX_MAX + 1;
+      else if (qe < MPFR_EMIN_MIN / GMP_NUMB_BITS - 1)
+        e = MPFR_EMIN_MIN - 2;
+      else
+        e += qe * GMP_NUMB_BITS;
+      MPFR_EXP (res) = e;
+    }
+
+  return mpfr_check_range (res, inex, rnd);
+}
@@ -0,0 +1,342 @@
+/* Tuning parameters that can be changed at run time.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include <stdio.h>
+#include <stdlib.h> /* for getenv */
+#include <string.h>
+
+/* we need the default values from mparam.h */
+#define MPFR_TUNE_DONT_REDEFINE
+#include "mpfr-impl.h"
+
+/* The tuning parameters are identified by the names of the macros of
+   mparam.h, which give their default values. They are global to the
+   process (not thread-local), so that they should not be changed while
+   other threads use MPFR.
+
+   The file read by mpfr_tune_load has the format of the file generated
+   by "tuneup -r": each parameter is given by its name followed by its
+   value, or by its values for a table (the size of the table being the
+   number of values), separated by blanks (spaces or newlines). A '#'
+   starts a comment, up to the end of the line. */
+
+static const short mulhigh_default[] = {MPFR_MULHIGH_TAB};
+static const short sqrhigh_default[] = {MPFR_SQRHIGH_TAB};
+static const short divhigh_default[] = {MPFR_DIVHIGH_TAB};
+
+#define MPFR_TUNE_DEFAULT                                               \
+  { MPFR_MUL_THRESHOLD, MPFR_SQR_THRESHOLD, MPFR_DIV_THRESHOLD,         \
+    MPFR_MULHIGH_FULL_THRESHOLD, MPFR_SQRHIGH_FULL_THRESHOLD,           \
+    MPFR_EXP_2_THRESHOLD, MPFR_EXP_THRESHOLD, MPFR_SINCOS_THRESHOLD,    \
+    MPFR_AI_THRESHOLD1, MPFR_AI_THRESHOLD2, MPFR_AI_THRESHOLD3,         \
+    { numberof_const (mulhigh_default), {MPFR_MULHIGH_TAB} },           \
+    { numberof_const (sqrhigh_default), {MPFR_SQRHIGH_TAB} },           \
+    { numberof_const (divhigh_default), {MPFR_DIVHIGH_TAB} } }
+
+static const mpfr_tune_t tune_default = MPFR_TUNE_DEFAULT;
+
+mpfr_tune_t __gmpfr_tune = MPFR_TUNE_DEFAULT;
+
+/* kinds of parameters */
+#define TUNE_LIMBS    0  /* threshold in limbs, at least its minimum */
+#define TUNE_BITS     1  /* threshold in bits */
+#define TUNE_LONG     2  /* any long */
+#define TUNE_MULHIGH  3  /* table for mpfr_mulhigh_n or mpfr_sqrhigh_n */
+#define TUNE_DIVHIGH  4  /* table for mpfr_divhigh_n */
+
+typedef struct {
+  const char *name;
+  int kind;
+  size_t offset;  /* of the value or of the table in mpfr_tune_t */
+  long min;       /* minimum value (except for TUNE_LONG), or minimum
+                     size of a table */
+} mpfr_tune_param_t;
+
+/* The minimum sizes of the tables ensure that the values used by the
+   functions of mulders.c after the tables are valid. A threshold of 0
+   (MPFR_DIV_THRESHOLD) means that the corresponding algorithm is always
+   tried; the other thresholds in limbs must be at least 1, as checked for
+   the default values in mpfr_tune_reset. */
+static const mpfr_tune_param_t tune_params[] = {
+  { "MPFR_MUL_THRESHOLD", TUNE_LIMBS, offsetof (mpfr_tune_t, mul), 1 },
+  { "MPFR_SQR_THRESHOLD", TUNE_LIMBS, offsetof (mpfr_tune_t, sqr), 1 },
+  { "MPFR_DIV_THRESHOLD", TUNE_LIMBS, offsetof (mpfr_tune_t, div), 0 },
+  { "MPFR_MULHIGH_FULL_THRESHOLD", TUNE_LIMBS,
+    offsetof (mpfr_tune_t, mulhigh_full), 1 },
+  { "MPFR_SQRHIGH_FULL_THRESHOLD", TUNE_LIMBS,
+    offsetof (mpfr_tune_t, sqrhigh_full), 1 },
+  { "MPFR_EXP_2_THRESHOLD", TUNE_BITS, offsetof (mpfr_tune_t, exp_2), 0 },
+  { "MPFR_EXP_THRESHOLD", TUNE_BITS, offsetof (mpfr_tune_t, exp), 0 },
+  { "MPFR_SINCOS_THRESHOLD", TUNE_BITS, offsetof (mpfr_tune_t, sincos), 0 },
+  { "MPFR_AI_THRESHOLD1", TUNE_LONG, offsetof (mpfr_tune_t, ai1), 0 },
+  { "MPFR_AI_THRESHOLD2", TUNE_LONG, offsetof (mpfr_tune_t, ai2), 0 },
+  { "MPFR_AI_THRESHOLD3", TUNE_LONG, offsetof (mpfr_tune_t, ai3), 0 },
+  { "MPFR_MULHIGH_TAB", TUNE_MULHIGH, offsetof (mpfr_tune_t, mulhigh), 8 },
+  { "MPFR_SQRHIGH_TAB", TUNE_MULHIGH, offsetof (mpfr_tune_t, sqrhigh), 3 },
+  { "MPFR_DIVHIGH_TAB", TUNE_DIVHIGH, offsetof (mpfr_tune_t, divhigh), 15 }
+};
+
+#define TUNE_VALUE(t,p) ((char *) (t) + (p)->offset)
+#define TUNE_TAB(t,p) ((mpfr_tune_tab_t *) TUNE_VALUE (t, p))
+
+/* Return the parameter of the given name, and set *size to 1 if the name
+   is the one of a table followed by "_SIZE" (for the size of the table),
+   to 0 otherwise. Return NULL if there is no such parameter. */
+static const mpfr_tune_param_t *
+tune_lookup (const char *name, int *size)
+{
+  int i;
+
+  for (i = 0; i < numberof (tune_params); i++)
+    {
+      const mpfr_tune_param_t *p = &tune_params[i];
+      size_t l = strlen (p->name);
+
+      if (strncmp (name, p->name, l) != 0)
+        continue;
+      if (name[l] == '\0')
+        {
+          *size = 0;
+          return p;
+        }
+      if (p->kind >= TUNE_MULHIGH && strcmp (name + l, "_SIZE") == 0)
+        {
+          *size = 1;
+          return p;
+        }
+    }
+  return NULL;
+}
+
+/* Return non-zero if k is a valid value for the entry of index n of a
+   table of the given kind (see the assertions in mulders.c). */
+static int
+tune_tab_ok (int kind, mp_size_t n, long k)
+{
+  if (kind == TUNE_MULHIGH)
+    return k == -1 || k == 0 || ((n + 4) / 2 <= k && k < n);
+  else
+    return k == 0 || ((n + 4) / 2 <= k && k < n - 1);
+}
+
+/* Value used by mulders.c after the end of the table p. */
+static short
+tune_tab_default (const mpfr_tune_param_t *p, mp_size_t n)
+{
+  if (p->offset == offsetof (mpfr_tune_t, mulhigh))
+    return 3 * (n / 4);
+  else if (p->offset == offsetof (mpfr_tune_t, sqrhigh))
+    return (n + 4) / 2;
+  else
+    return 2 * (n / 3);
+}
+
+/* Set the parameter p (the size of the table p if size is non-zero) of t,
+   or the entry of index i of the table p, to v. Return 0 on success, a
+   non-zero value if the index or the value is invalid. */
+static int
+tune_set (mpfr_tune_t *t, const mpfr_tune_param_t *p, int size,
+          unsigned long i, long v)
+{
+  mpfr_tune_tab_t *tab;
+
+  if (p->kind < TUNE_MULHIGH || size)
+    {
+      if (i != 0 || (p->kind != TUNE_LONG && v < p->min))
+        return 1;
+    }
+
+  switch (p->kind)
+    {
+    case TUNE_LIMBS:
+    case TUNE_BITS:
+      if (v > MPFR_PREC_MAX)
+        return 1;
+      *(mpfr_prec_t *) TUNE_VALUE (t, p) = v;
+      return 0;
+    case TUNE_LONG:
+      *(long *) TUNE_VALUE (t, p) = v;
+      return 0;
+    default:
+      tab = TUNE_TAB (t, p);
+      if (size)
+        {
+          mp_size_t n;
+
+          if (v > MPFR_TUNE_TAB_SIZE_MAX)
+            return 1;
+          /* the new entries give the same values as before */
+          for (n = tab->size; n < v; n++)
+            tab->k[n] = tune_tab_default (p, n);
+          tab->size = v;
+          return 0;
+        }
+      if (i >= (unsigned long) tab->size ||
+          ! tune_tab_ok (p->kind, (mp_size_t) i, v))
+        return 1;
+      tab->k[i] = v;
+      return 0;
+    }
+}
+
+int
+mpfr_tune_set (const char *name, unsigned long i, long v)
+{
+  const mpfr_tune_param_t *p;
+  int size;
+
+  p = tune_lookup (name, &size);
+  return p == NULL ? 1 : tune_set (&__gmpfr_tune, p, size, i, v);
+}
+
+int
+mpfr_tune_get (const char *name, unsigned long i, long *v)
+{
+  const mpfr_tune_param_t *p;
+  mpfr_tune_tab_t *tab;
+  int size;
+
+  p = tune_lookup (name, &size);
+  if (p == NULL)
+    return 1;
+  if (p->kind < TUNE_MULHIGH || size)
+    {
+      if (i != 0)
+        return 1;
+    }
+
+  switch (p->kind)
+    {
+    case TUNE_LIMBS:
+    case TUNE_BITS:
+      *v = *(mpfr_prec_t *) TUNE_VALUE (&__gmpfr_tune, p);
+      return 0;
+    case TUNE_LONG:
+      *v = *(long *) TUNE_VALUE (&__gmpfr_tune, p);
+      return 0;
+    default:
+      tab = TUNE_TAB (&__gmpfr_tune, p);
+      if (size)
+        *v = tab->size;
+      else if (i < (unsigned long) tab->size)
+        *v = tab->k[i];
+      else
+        return 1;
+      return 0;
+    }
+}
+
+void
+mpfr_tune_reset (void)
+{
+  MPFR_STAT_STATIC_ASSERT (MPFR_MUL_THRESHOLD >= 1 &&
+                           MPFR_SQR_THRESHOLD >= 1);
+  MPFR_STAT_STATIC_ASSERT (MPFR_MULHIGH_FULL_THRESHOLD >= 1 &&
+                           MPFR_SQRHIGH_FULL_THRESHOLD >= 1);
+  MPFR_STAT_STATIC_ASSERT (numberof_const (mulhigh_default) >= 8 &&
+                           numberof_const (sqrhigh_default) >= 3 &&
+                           numberof_const (divhigh_default) >= 15);
+  MPFR_STAT_STATIC_ASSERT
+    (numberof_const (mulhigh_default) <= MPFR_TUNE_TAB_SIZE_MAX &&
+     numberof_const (sqrhigh_default) <= MPFR_TUNE_TAB_SIZE_MAX &&
+     numberof_const (divhigh_default) <= MPFR_TUNE_TAB_SIZE_MAX);
+
+  __gmpfr_tune = tune_default;
+}
+
+/* Read the parameters from the file f into t. Return 0 on success. */
+static int
+tune_read (mpfr_tune_t *t, FILE *f)
+{
+  char name[64];
+  const mpfr_tune_param_t *p;
+  int size, c;
+  long v;
+
+  while (fscanf (f, " %63s", name) == 1)
+    {
+      if (name[0] == '#')
+        {
+          do
+            c = getc (f);
+          while (c != '\n' && c != EOF);
+          continue;
+        }
+      p = tune_lookup (name, &size);
+      if (p == NULL || size)
+        return 1;
+      if (p->kind < TUNE_MULHIGH)
+        {
+          if (fscanf (f, "%ld", &v) != 1 || tune_set (t, p, 0, 0, v))
+            return 1;
+        }
+      else
+        {
+          mpfr_tune_tab_t *tab = TUNE_TAB (t, p);
+          mp_size_t n = 0;
+
+          /* the values end at the next name or comment */
+          while (fscanf (f, "%ld", &v) == 1)
+            {
+              if (n >= MPFR_TUNE_TAB_SIZE_MAX || ! tune_tab_ok (p->kind, n, v))
+                return 1;
+              tab->k[n++] = v;
+            }
+          if (n < p->min)
+            return 1;
+          tab->size = n;
+        }
+    }
+  return ferror (f);
+}
+
+/* Read the parameters from the given file (from the file given by the
+   MPFR_TUNE_FILE environment variable if filename is NULL, if set). The
+   parameters not given in the file are unchanged. On error, nothing is
+   changed. This function is never called implicitly (e.g., at load time):
+   otherwise any process linked with MPFR, including setuid programs, would
+   read a file chosen by the environment. */
+int
+mpfr_tune_load (const char *filename)
+{
+  FILE *f;
+  mpfr_tune_t *t;
+  int err;
+
+  if (filename == NULL)
+    {
+      filename = getenv ("MPFR_TUNE_FILE");
+      if (filename == NULL || *filename == '\0')
+        return 0;
+    }
+
+  f = fopen (filename, "r");
+  if (f == NULL)
+    return 1;
+  t = (mpfr_tune_t *) mpfr_allocate_func (sizeof (mpfr_tune_t));
+  *t = __gmpfr_tune;
+  err = tune_read (t, f);
+  if (! err)
+    __gmpfr_tune = *t;
+  mpfr_free_func (t, sizeof (mpfr_tune_t));
+  fclose (f);
+  return err;
+}
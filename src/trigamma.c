@@ -323,8 +323,8 @@ mpfr_trigamma_positive (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
       if (MPFR_CAN_ROUND (t, p - errt, MPFR_PREC(y), rnd_mode))
         break;
       MPFR_ZIV_NEXT (loop, p);
-      mpfr_set_prec (t, p);
-      mpfr_set_prec (u, p);
+      mpfr_ziv_set_prec (t, p);
+      mpfr_ziv_set_prec (u, p);
     }
   MPFR_ZIV_FREE (loop);
   inex = mpfr_set (y, t, rnd_mode);
@@ -486,8 +486,8 @@ mpfr_trigamma_reflection (mpfr_ptr y, mpfr_srcptr x, mpfr_rnd_t rnd_mode)
             break;
         }
       MPFR_ZIV_NEXT (loop, p);
-      mpfr_set_prec (t, p);
-      mpfr_set_prec (v, p);
+      mpfr_ziv_set_prec (t, p);
+      mpfr_ziv_set_prec (v, p);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -118,7 +118,7 @@ mpfr_ui_pow_ui (mpfr_ptr x, unsigned long int k, unsigned long int n,
 
       /* Actualisation of the precision */
       MPFR_ZIV_NEXT (loop, prec);
-      mpfr_set_prec (res, prec);
+      mpfr_ziv_set_prec (res, prec);
     }
   MPFR_ZIV_FREE (loop);
 
@@ -0,0 +1,153 @@
+/* mpfr_vec_init2, mpfr_vec_clear, mpfr_init_array2, mpfr_clear_array and
+   accessors -- vectors of numbers of the same precision with contiguous
+   storage
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-impl.h"
+
+/* A vector uses a single memory block, containing in this order:
+   - the significands of the n elements (n * MPFR_PREC2LIMBS(p) limbs);
+   - the n elements themselves (__mpfr_struct), initialized with the
+     custom interface so that each of them points to its significand;
+   - the n pointers to these elements.
+   The significands are put first since the alignment of mp_limb_t is
+   the strictest one (on some ABI's, a limb is larger than a pointer). */
+
+static size_t
+mpfr_vec_bytes (unsigned long n, mpfr_prec_t p)
+{
+  size_t per_elt;
+
+  per_elt = mpfr_custom_get_size (p) + sizeof (__mpfr_struct)
+    + sizeof (mpfr_ptr);
+  MPFR_ASSERTN (n <= ((size_t) -1) / per_elt);
+  return n * per_elt;
+}
+
+void
+mpfr_vec_init2 (mpfr_vec_ptr v, unsigned long n, mpfr_prec_t p)
+{
+  mp_size_t xsize;
+  unsigned long i;
+
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  v->_mpfr_vec_prec = p;
+  v->_mpfr_vec_size = n;
+  if (MPFR_UNLIKELY (n == 0))
+    {
+      v->_mpfr_vec_d = NULL;
+      v->_mpfr_vec_x = NULL;
+      v->_mpfr_vec_p = NULL;
+      return;
+    }
+
+  xsize = MPFR_PREC2LIMBS (p);
+  v->_mpfr_vec_d = (mp_limb_t *) mpfr_allocate_func (mpfr_vec_bytes (n, p));
+  v->_mpfr_vec_x = (mpfr_ptr) (v->_mpfr_vec_d + n * xsize);
+  v->_mpfr_vec_p = (mpfr_ptr *) (v->_mpfr_vec_x + n);
+
+  for (i = 0; i < n; i++)
+    {
+      mpfr_ptr x = v->_mpfr_vec_x + i;
+
+      mpfr_custom_init_set (x, MPFR_NAN_KIND, 0, p,
+                            v->_mpfr_vec_d + i * xsize);
+      v->_mpfr_vec_p[i] = x;
+    }
+}
+
+void
+mpfr_vec_clear (mpfr_vec_ptr v)
+{
+  if (v->_mpfr_vec_size != 0)
+    mpfr_free_func (v->_mpfr_vec_d,
+                    mpfr_vec_bytes (v->_mpfr_vec_size, v->_mpfr_vec_prec));
+  v->_mpfr_vec_size = 0;
+}
+
+/* An array of n variables x[0..n-1] given by the caller shares a single
+   block with the n significands, like a vector, but without the pointers.
+   Since the variables may be exchanged by mpfr_swap, the block starts at
+   the lowest significand address. */
+void
+mpfr_init_array2 (mpfr_ptr x, unsigned long n, mpfr_prec_t p)
+{
+  size_t size;
+  char *d;
+  unsigned long i;
+
+  MPFR_ASSERTN (MPFR_PREC_COND (p));
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  size = mpfr_custom_get_size (p);
+  MPFR_ASSERTN (n <= ((size_t) -1) / size);
+  d = (char *) mpfr_allocate_func (n * size);
+  for (i = 0; i < n; i++)
+    mpfr_custom_init_set (x + i, MPFR_NAN_KIND, 0, p, d + i * size);
+}
+
+void
+mpfr_clear_array (mpfr_ptr x, unsigned long n)
+{
+  mp_limb_t *d;
+  unsigned long i;
+
+  if (MPFR_UNLIKELY (n == 0))
+    return;
+
+  d = MPFR_MANT (x);
+  for (i = 1; i < n; i++)
+    if (MPFR_MANT (x + i) < d)
+      d = MPFR_MANT (x + i);
+  mpfr_free_func (d, n * mpfr_custom_get_size (MPFR_PREC (x)));
+}
+
+#undef mpfr_vec_get
+mpfr_ptr
+mpfr_vec_get (mpfr_vec_srcptr v, unsigned long i)
+{
+  MPFR_ASSERTD (i < v->_mpfr_vec_size);
+  return v->_mpfr_vec_x + i;
+}
+
+#undef mpfr_vec_ptrs
+const mpfr_ptr *
+mpfr_vec_ptrs (mpfr_vec_srcptr v)
+{
+  return v->_mpfr_vec_p;
+}
+
+#undef mpfr_vec_size
+unsigned long
+mpfr_vec_size (mpfr_vec_srcptr v)
+{
+  return v->_mpfr_vec_size;
+}
+
+#undef mpfr_vec_get_prec
+mpfr_prec_t
+mpfr_vec_get_prec (mpfr_vec_srcptr v)
+{
+  return v->_mpfr_vec_prec;
+}
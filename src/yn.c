@@ -333,10 +333,10 @@ mpfr_yn (mpfr_ptr res, long n, mpfr_srcptr z, mpfr_rnd_t r)
     MPFR_ZIV_INIT (loop, prec);
     for (;;)
       {
-        mpfr_set_prec (y, prec);
-        mpfr_set_prec (s1, prec);
-        mpfr_set_prec (s2, prec);
-        mpfr_set_prec (s3, prec);
+        mpfr_ziv_set_prec (y, prec);
+        mpfr_ziv_set_prec (s1, prec);
+        mpfr_ziv_set_prec (s2, prec);
+        mpfr_ziv_set_prec (s3, prec);
 
         mpfr_sqr (y, z, MPFR_RNDN);
         mpfr_div_2ui (y, y, 2, MPFR_RNDN); /* z^2/4 */
@@ -106,8 +106,9 @@ mpfr_zeta_c (int p, mpfr_t *tc)
       mpfr_t d;
       int k, l;
       mpfr_prec_t prec = MPFR_PREC (tc[1]);
+      MPFR_GROUP_DECL (group);
 
-      mpfr_init2 (d, prec);
+      MPFR_GROUP_INIT_1 (group, prec, d);
       mpfr_div_ui (tc[1], __gmpfr_one, 12, MPFR_RNDN);
       for (k = 2; k <= p; k++)
         {
@@ -121,7 +122,7 @@ mpfr_zeta_c (int p, mpfr_t *tc)
           mpfr_div_ui (tc[k], d, 24, MPFR_RNDN);
           MPFR_CHANGE_SIGN (tc[k]);
         }
-      mpfr_clear (d);
+      MPFR_GROUP_CLEAR (group);
     }
 }
 
@@ -165,8 +166,12 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
   mpfr_prec_t precz, precs, d, dint;
   int p, n, l, add;
   int inex;
+  MPFR_GROUP_DECL (group1);
   MPFR_GROUP_DECL (group);
   MPFR_ZIV_DECL (loop);
+  MPFR_LOG_FUNC
+    (("s[%Pd]=%.*Rg rnd=%d", mpfr_get_prec (s), mpfr_log_prec, s, rnd_mode),
+     ("z[%Pd]=%.*Rg", mpfr_get_prec (z), mpfr_log_prec, z));
 
   MPFR_ASSERTD (MPFR_IS_POS (s) && MPFR_GET_EXP (s) >= 0);
 
@@ -199,7 +204,7 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
 
   /* we want that s1 = s-1 is exact, i.e. we should have PREC(s1) >= EXP(s) */
   dint = (mpfr_uexp_t) MPFR_GET_EXP (s);
-  mpfr_init2 (s1, MAX (precs, dint));
+  MPFR_GROUP_INIT_1 (group1, MAX (precs, dint), s1);
   inex = mpfr_sub (s1, s, __gmpfr_one, MPFR_RNDN);
   MPFR_ASSERTD (inex == 0);
 
@@ -227,7 +232,9 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
         }
       else /* Branch 2 */
         {
-          size_t size;
+          mp_size_t size;
+          MPFR_GROUP_DECL (group2);
+          MPFR_TMP_DECL (marker);
 
           /* branch 2 */
           /* Computation of parameters n, p and working precision */
@@ -260,11 +267,16 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
 
           /* internal precision is dint */
 
-          size = (p + 1) * sizeof(mpfr_t);
-          tc1 = (mpfr_t*) mpfr_allocate_func (size);
-          for (l=1; l<=p; l++)
-            mpfr_init2 (tc1[l], dint);
           MPFR_GROUP_REPREC_4 (group, dint, b, c, z_pre, f);
+          /* the significands of the tc1[l] are taken in a single block,
+             above the group (thus from the arena if possible); like tc1[0],
+             the first slot is not used, so that the block is never empty */
+          MPFR_TMP_MARK (marker);
+          tc1 = (mpfr_t*) MPFR_TMP_ALLOC ((p + 1) * sizeof(mpfr_t));
+          size = MPFR_PREC2LIMBS (dint);
+          MPFR_GROUP_ALLOC (group2, (p + 1) * size);
+          for (l=1; l<=p; l++)
+            MPFR_TMP_INIT1 (group2.mant + l * size, tc1[l], dint);
 
           /* precision of z is precz */
 
@@ -279,9 +291,8 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
           mpfr_div (c, c, f, MPFR_RNDN);
           mpfr_add (z_pre, z_pre, c, MPFR_RNDN);
           mpfr_add (z_pre, z_pre, b, MPFR_RNDN);
-          for (l=1; l<=p; l++)
-            mpfr_clear (tc1[l]);
-          mpfr_free_func (tc1, size);
+          MPFR_GROUP_CLEAR (group2);
+          MPFR_TMP_FREE (marker);
           /* End branch 2 */
         }
 
@@ -294,7 +305,7 @@ mpfr_zeta_pos (mpfr_ptr z, mpfr_srcptr s, mpfr_rnd_t rnd_mode)
   inex = mpfr_set (z, z_pre, rnd_mode);
 
   MPFR_GROUP_CLEAR (group);
-  mpfr_clear (s1);
+  MPFR_GROUP_CLEAR (group1);
 
   return inex;
 }
@@ -314,8 +325,9 @@ compute_add (mpfr_srcptr s, mpfr_prec_t precz)
 {
   mpfr_t t, u, m1;
   long add;
+  MPFR_GROUP_DECL (group);
 
-  mpfr_inits2 (64, t, u, m1, (mpfr_ptr) 0);
+  MPFR_GROUP_INIT_3 (group, 64, t, u, m1);
   if (mpfr_cmp_ui (s, 1) >= 0)
     mpfr_sub_ui (t, s, 1, MPFR_RNDU);
   else
@@ -346,7 +358,7 @@ compute_add (mpfr_srcptr s, mpfr_prec_t precz)
   mpfr_sqr (t, t, MPFR_RNDU); /* c^2 */
   mpfr_mul (u, u, t, MPFR_RNDU); /* c^3*(13+m1) */
   add = mpfr_get_exp (u);
-  mpfr_clears (t, u, m1, (mpfr_ptr) 0);
+  MPFR_GROUP_CLEAR (group);
   return add;
 }
 
@@ -70,10 +70,13 @@ size_t tests_memory_limit = DEFAULT_MEMORY_LIMIT;
    with several threads are added and executed whether the shared cache
    is enabled or not, thread locking should be enabled together with TLS
    whenever possible, and when it is unavailable, these multithread tests
-   must not be run. */
+   must not be run.
+   Thread locking is also enabled with --enable-parallel, as the tests of
+   mpfr_sum_parallel and of the constants then use several threads. */
 static struct header  *tests_memory_list;
 static size_t tests_total_size = 0;
 static size_t tests_max_size = 0;
+static size_t tests_nalloc = 0;
 MPFR_LOCK_DECL(mpfr_lock_memory)
 
 static void *
@@ -173,6 +176,7 @@ tests_allocate (size_t size)
     }
 
   tests_addsize (size);
+  tests_nalloc++;
 
   h = (struct header *) mpfr_default_allocate (sizeof (*h));
   h->next = tests_memory_list;
@@ -235,6 +239,7 @@ tests_reallocate (void *ptr, size_t old_size, size_t new_size)
 
   tests_total_size -= old_size;
   tests_addsize (new_size);
+  tests_nalloc++;
 
   h->size = new_size;
   h->ptr = mpfr_default_reallocate (ptr, old_size, new_size);
@@ -317,6 +322,13 @@ tests_reset_maxsize (void)
   tests_max_size = 0;
 }
 
+/* Number of calls to tests_allocate and tests_reallocate so far. */
+size_t
+tests_get_nalloc (void)
+{
+  return tests_nalloc;
+}
+
 void
 tests_memory_start (void)
 {
@@ -201,6 +201,7 @@ void tests_free (void *, size_t);
 size_t tests_get_totalsize (void);
 size_t tests_get_maxsize (void);
 void tests_reset_maxsize (void);
+size_t tests_get_nalloc (void);
 void tests_memory_start (void);
 void tests_memory_end (void);
 
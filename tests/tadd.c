@@ -897,6 +897,90 @@ coverage_bk_eq_0 (void)
   mpfr_clear (c);
 }
 
+/* Test mpfr_add (x, x, y, rnd) and mpfr_sub (x, y, x, rnd) against the
+   out-of-place operations, which are done in place in mpfr_add1 and
+   mpfr_sub1 when x has a larger precision than y (y may be negative). The
+   values of x near 1/2 or 1 and the exponent differences near PREC(x) test
+   the carry and borrow propagation and the computation of the round and
+   sticky bits, and a reduced emax tests the overflow. */
+static void
+check_inplace (void)
+{
+  mpfr_t x, y, r, s;
+  mpfr_prec_t px, py;
+  mpfr_exp_t d, emax;
+  int i, j, k, r1, r2;
+  unsigned int f1, f2;
+
+  emax = mpfr_get_emax ();
+  for (i = 0; i < 2000; i++)
+    {
+      px = MPFR_PREC_MIN + randlimb () % (4 * GMP_NUMB_BITS);
+      py = MPFR_PREC_MIN + randlimb () % (2 * GMP_NUMB_BITS);
+      mpfr_inits2 (px, x, r, s, (mpfr_ptr) 0);
+      mpfr_init2 (y, py);
+      switch (randlimb () % 3)
+        {
+        case 0:
+          mpfr_urandomb (x, RANDS);
+          break;
+        case 1:
+          mpfr_set_ui_2exp (x, 1, -1, MPFR_RNDN);
+          break;
+        default:
+          mpfr_set_ui (x, 1, MPFR_RNDN);
+          mpfr_nextbelow (x);
+        }
+      if (randlimb () % 2)
+        mpfr_nextabove (x);
+      mpfr_urandomb (y, RANDS);
+      if (MPFR_IS_ZERO (y))
+        mpfr_set_ui (y, 1, MPFR_RNDN);
+      if (randlimb () % 2)
+        mpfr_neg (y, y, MPFR_RNDN);
+      d = randlimb () % 2 ? randlimb () % (px + 4) : px - 2 + randlimb () % 5;
+      mpfr_set_exp (x, 1);
+      mpfr_set_exp (y, 1 - d);
+      /* j = 0: s = s + y; j = 1: s = y - s, where mpfr_sub1 gets the
+         destination aliased to its second operand; j = 2, 3: the same
+         with emax = max(EXP(x), EXP(y)), so that the result may overflow
+         (d = -1 is possible when px = 1). */
+      for (j = 0; j < 4; j++)
+        {
+          if (j == 2)
+            set_emax (d < 0 ? 1 - d : 1);
+          RND_LOOP_NO_RNDF (k)
+            {
+              mpfr_set (s, x, MPFR_RNDN);
+              mpfr_clear_flags ();
+              r1 = j & 1 ? mpfr_sub (r, y, s, (mpfr_rnd_t) k)
+                : mpfr_add (r, s, y, (mpfr_rnd_t) k);
+              f1 = __gmpfr_flags;
+              mpfr_clear_flags ();
+              r2 = j & 1 ? mpfr_sub (s, y, s, (mpfr_rnd_t) k)
+                : mpfr_add (s, s, y, (mpfr_rnd_t) k);
+              f2 = __gmpfr_flags;
+              if (! mpfr_equal_p (r, s) || ! SAME_SIGN (r1, r2) || f1 != f2)
+                {
+                  printf ("Error in check_inplace for %s, j = %d\n",
+                          mpfr_print_rnd_mode ((mpfr_rnd_t) k), j);
+                  printf ("x = "); mpfr_dump (x);
+                  printf ("y = "); mpfr_dump (y);
+                  printf ("Expected "); mpfr_dump (r);
+                  printf ("  with inex = %d, flags =", r1);
+                  flags_out (f1);
+                  printf ("Got      "); mpfr_dump (s);
+                  printf ("  with inex = %d, flags =", r2);
+                  flags_out (f2);
+                  exit (1);
+                }
+            }
+        }
+      set_emax (emax);
+      mpfr_clears (x, y, r, s, (mpfr_ptr) 0);
+    }
+}
+
 static void
 tests (void)
 {
@@ -1153,6 +1237,7 @@ tests (void)
   check_overflow ();
   check_1111 ();
   check_1minuseps ();
+  check_inplace ();
 }
 
 static void
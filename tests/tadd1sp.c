@@ -166,7 +166,7 @@ coverage (void)
 
   /* coverage test in mpfr_add1sp: case round away, where add_one_ulp
      gives a carry, and the new exponent is below emax */
-  for (p = MPFR_PREC_MIN; p <= 3 * GMP_NUMB_BITS; p++)
+  for (p = MPFR_PREC_MIN; p <= 8 * GMP_NUMB_BITS; p++)
     {
       mpfr_set_prec (a, p);
       mpfr_set_prec (b, p);
@@ -294,6 +294,12 @@ main (void)
       check_random (GMP_NUMB_BITS);
       check_random (2 * GMP_NUMB_BITS);
     }
+  /* precisions of 4 to 8 limbs, which have their own code */
+  for (i = 4; i <= 8; i++)
+    {
+      check_random (i * GMP_NUMB_BITS - 1);
+      check_random (i * GMP_NUMB_BITS);
+    }
   check_overflow ();
 
   tests_end_mpfr ();
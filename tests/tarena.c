@@ -0,0 +1,156 @@
+/* Test file for the arena used by the MPFR_GROUP_* macros.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+typedef int (*func_t) (mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+static struct
+{
+  const char *name;
+  func_t f;
+  int zero; /* non-zero if no allocation is expected after the first calls */
+} funcs[] = {
+  { "mpfr_log", mpfr_log, 1 },
+  { "mpfr_exp", mpfr_exp, 1 },
+  { "mpfr_sin", mpfr_sin, 1 },
+  /* the binary splitting of mpfr_atan_aux uses temporaries whose
+     sizes change from a call to the other */
+  { "mpfr_atan", mpfr_atan, 0 },
+  { "mpfr_gamma", mpfr_gamma, 1 },
+  { "mpfr_zeta", mpfr_zeta, 1 }
+};
+
+/* Return the number of memory allocations done by n calls to funcs[k]
+   in precision p, after the same n calls have been done once to fill the
+   caches and the arena. */
+static size_t
+count_allocs (int k, mpfr_prec_t p, int n)
+{
+  mpfr_t x, y;
+  size_t c;
+  int i, j;
+
+  mpfr_inits2 (p, x, y, (mpfr_ptr) 0);
+  for (j = 0; j < 2; j++)
+    {
+      mpfr_set_ui (x, 17, MPFR_RNDN);
+      mpfr_div_ui (x, x, 7, MPFR_RNDN);
+      c = tests_get_nalloc ();
+      for (i = 0; i < n; i++)
+        {
+          funcs[k].f (y, x, MPFR_RNDN);
+          mpfr_nextabove (x);
+        }
+    }
+  c = tests_get_nalloc () - c;
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+  return c;
+}
+
+#if MPFR_WANT_ASSERT < 2
+/* In steady state, the functions whose temporaries are all in groups
+   (and mpz_t from the pool) do not allocate memory. */
+static void
+check_steady_state (void)
+{
+  mpfr_prec_t p;
+  size_t c;
+  int k;
+
+  for (k = 0; k < numberof (funcs); k++)
+    if (funcs[k].zero)
+      for (p = 2 * GMP_NUMB_BITS; p <= 16 * GMP_NUMB_BITS; p *= 2)
+        {
+          c = count_allocs (k, p, 10);
+          if (c != 0)
+            {
+              printf ("Error: %lu allocation(s) for 10 calls to %s with "
+                      "precision %lu\n", (unsigned long) c, funcs[k].name,
+                      (unsigned long) p);
+              exit (1);
+            }
+        }
+}
+#endif
+
+/* Groups must still work after the arena has been freed, and when it is
+   freed while a group is live in it (which does nothing). */
+static void
+check_free (void)
+{
+  mpfr_t x, y, z, a, b;
+  MPFR_GROUP_DECL (group);
+
+  mpfr_inits2 (4 * GMP_NUMB_BITS, x, y, z, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_log (y, x, MPFR_RNDN);
+  mpfr_free_cache ();
+  mpfr_log (z, x, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (y, z));
+
+  /* a group too large for the static table, thus in the arena */
+  MPFR_GROUP_INIT_2 (group, 16 * GMP_NUMB_BITS, a, b);
+  mpfr_set (a, y, MPFR_RNDN);
+  mpfr_set (b, y, MPFR_RNDN);
+  mpfr_free_arena ();
+  mpfr_log (z, x, MPFR_RNDN);
+  MPFR_ASSERTN (mpfr_equal_p (a, y) && mpfr_equal_p (b, y));
+  MPFR_ASSERTN (mpfr_equal_p (z, y));
+  MPFR_GROUP_CLEAR (group);
+
+  mpfr_clears (x, y, z, (mpfr_ptr) 0);
+}
+
+int
+main (int argc, char *argv[])
+{
+  tests_start_mpfr ();
+
+  /* tarena <prec> <n>: print the number of allocations for n calls of
+     each function in the given precision */
+  if (argc == 3)
+    {
+      mpfr_prec_t p = strtoul (argv[1], NULL, 10);
+      int k, n = atoi (argv[2]);
+
+      if (tests_memory_disabled)
+        printf ("Memory tracking is disabled\n");
+      else
+        for (k = 0; k < numberof (funcs); k++)
+          printf ("%-12s %8.2f allocations per call\n", funcs[k].name,
+                  (double) count_allocs (k, p, n) / n);
+      tests_end_mpfr ();
+      return 0;
+    }
+
+  /* the allocations are counted only with the memory functions of
+     memory.c, and with the arena enabled; with MPFR_WANT_ASSERT >= 2,
+     some functions check their result with variables from the heap */
+#if MPFR_WANT_ASSERT < 2
+  if (! tests_memory_disabled && MPFR_ARENA_MAX_SIZE != 0)
+    check_steady_state ();
+#endif
+  check_free ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -130,6 +130,41 @@ check_sharedcache_p (void)
 #endif
 }
 
+static void
+check_parallel_p (void)
+{
+#if defined(MPFR_WANT_PARALLEL)
+  if (!mpfr_buildopt_parallel_p ())
+    {
+      printf ("Error: mpfr_buildopt_parallel_p should return true\n");
+      exit (1);
+    }
+#else
+  if (mpfr_buildopt_parallel_p ())
+    {
+      printf ("Error: mpfr_buildopt_parallel_p should return false\n");
+      exit (1);
+    }
+#endif
+}
+
+static void
+check_fmv_variant (void)
+{
+  const char *s = mpfr_buildopt_fmv_variant ();
+
+#if defined(MPFR_WANT_FMV)
+  if (strcmp (s, "x86-64-v3") != 0 && strcmp (s, "x86-64-v2") != 0 &&
+      strcmp (s, "default") != 0)
+#else
+  if (strcmp (s, "default") != 0)
+#endif
+    {
+      printf ("Error: unexpected mpfr_buildopt_fmv_variant: %s\n", s);
+      exit (1);
+    }
+}
+
 int
 main (void)
 {
@@ -141,6 +176,8 @@ main (void)
   check_float128_p();
   check_gmpinternals_p();
   check_sharedcache_p ();
+  check_parallel_p ();
+  check_fmv_variant ();
   {
     const char *s = mpfr_buildopt_tune_case ();
     (void) strlen (s);
@@ -48,6 +48,28 @@ exercise_Ziv (void)
   mpfr_clear (y);
 }
 
+/* The result does not depend on the number of threads (see bsplit.c):
+   check it in a precision for which several threads are used. */
+static void
+check_threads (void)
+{
+  mpfr_t x, y;
+  int inex1, inex2;
+
+  mpfr_inits2 (30000, x, y, (mpfr_ptr) 0);
+  inex1 = mpfr_const_euler_internal (x, MPFR_RNDN);
+  mpfr_set_const_nthreads (3);
+  MPFR_ASSERTN (mpfr_get_const_nthreads () == 3);
+  inex2 = mpfr_const_euler_internal (y, MPFR_RNDN);
+  mpfr_set_const_nthreads (1);
+  if (! mpfr_equal_p (x, y) || inex1 != inex2)
+    {
+      printf ("Error in check_threads for euler\n");
+      exit (1);
+    }
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -70,6 +92,7 @@ main (int argc, char *argv[])
     }
 
   exercise_Ziv ();
+  check_threads ();
 
   mpfr_init (y);
   mpfr_init (z);
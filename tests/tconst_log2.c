@@ -138,6 +138,66 @@ check_cache (void)
   mpfr_clear (x);
 }
 
+/* When the precision of the cache increases, the state of the binary
+   splitting is extended (see bsplit.c): check the values against direct
+   computations. */
+static void
+check_extend (void)
+{
+  mpfr_t x, y;
+  mpfr_prec_t p;
+  unsigned long n = 0;
+  int inex1, inex2;
+
+  mpfr_free_cache ();
+  mpfr_inits2 (MPFR_PREC_MIN, x, y, (mpfr_ptr) 0);
+  /* the cache precision is increased by at least 10% */
+  for (p = 1000; p < 5000; p += p / 8)
+    {
+      mpfr_set_prec (x, p);
+      mpfr_set_prec (y, p);
+      inex1 = mpfr_const_log2 (x, MPFR_RNDN);
+      MPFR_ASSERTN (__gmpfr_cache_const_log2->bs != NULL);
+      MPFR_ASSERTN (__gmpfr_cache_const_log2->bs->n > n);
+      n = __gmpfr_cache_const_log2->bs->n;
+      inex2 = mpfr_const_log2_internal (y, MPFR_RNDN);
+      if (! mpfr_equal_p (x, y) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in check_extend for log2, p = %ld\n", (long) p);
+          printf ("expected "); mpfr_dump (y);
+          printf ("got      "); mpfr_dump (x);
+          exit (1);
+        }
+    }
+  mpfr_free_cache ();
+  MPFR_ASSERTN (__gmpfr_cache_const_log2->bs == NULL);
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+/* The result does not depend on the number of threads (see bsplit.c):
+   check it in a precision for which several threads are used. */
+static void
+check_threads (void)
+{
+  mpfr_t x, y;
+  int inex1, inex2;
+
+  mpfr_inits2 (40000, x, y, (mpfr_ptr) 0);
+  inex1 = mpfr_const_log2_internal (x, MPFR_RNDN);
+  mpfr_set_const_nthreads (3);
+  MPFR_ASSERTN (mpfr_get_const_nthreads () == 3);
+  inex2 = mpfr_const_log2_internal (y, MPFR_RNDN);
+  mpfr_set_const_nthreads (0);
+  MPFR_ASSERTN (mpfr_get_const_nthreads () == 1);
+  mpfr_set_const_nthreads (1);
+  if (! mpfr_equal_p (x, y) || inex1 != inex2)
+    {
+      printf ("Error in check_threads for log2\n");
+      exit (1);
+    }
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
 /* Wrapper for tgeneric */
 static int
 my_const_log2 (mpfr_ptr x, mpfr_srcptr y, mpfr_rnd_t r)
@@ -225,6 +285,8 @@ main (int argc, char *argv[])
 
   check_large ();
   check_cache ();
+  check_threads ();
+  check_extend ();
 
   test_generic (MPFR_PREC_MIN, 200, 1);
 
@@ -50,8 +50,13 @@ start_routine (void *arg)
       /* Check that no reallocation has been performed */
       MPFR_ASSERTN (m == MPFR_MANT (x));
       mpfr_clear (x);
+      /* Free the shared caches while the other threads may use them. */
+      if (inc % 10 == 0 && p % 3 == 0)
+        mpfr_free_cache2 (MPFR_FREE_GLOBAL_CACHE);
     }
 
+  /* Free the pools and the arena of this thread. */
+  mpfr_free_cache2 (MPFR_FREE_LOCAL_CACHE);
   pthread_exit (NULL);
 }
 
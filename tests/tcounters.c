@@ -0,0 +1,238 @@
+/* Test file for the counters of the Ziv loops and of the allocations.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include "mpfr-test.h"
+
+/* Copy the counters of the function name to *c, and return the number
+   of functions with counters, or 0 if name is not among them. */
+static unsigned long
+get_counters (mpfr_counters_t *c, const char *name)
+{
+  mpfr_counters_t *tab;
+  unsigned long i, n, m;
+
+  n = mpfr_counters_get (NULL, 0);
+  if (n == 0)
+    return 0;
+  tab = (mpfr_counters_t *) tests_allocate (n * sizeof (mpfr_counters_t));
+  m = mpfr_counters_get (tab, n);
+  MPFR_ASSERTN (m == n);
+  for (i = 0; i < n; i++)
+    if (strcmp (tab[i].name, name) == 0)
+      break;
+  if (i < n)
+    *c = tab[i];
+  tests_free (tab, n * sizeof (mpfr_counters_t));
+  return i < n ? n : 0;
+}
+
+static void
+check_sin (void)
+{
+  mpfr_counters_t c;
+  mpfr_t x, y;
+  unsigned long n;
+  int i;
+
+  mpfr_inits2 (100, x, y, (mpfr_ptr) 0);
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  mpfr_div_ui (x, x, 7, MPFR_RNDN);
+  mpfr_counters_reset ();
+  for (i = 0; i < 10; i++)
+    {
+      mpfr_sin (y, x, MPFR_RNDN);
+      mpfr_nextabove (x);
+    }
+  n = get_counters (&c, "mpfr_sin");
+  if (n == 0)
+    {
+      printf ("Error: no counters for mpfr_sin\n");
+      exit (1);
+    }
+  /* each call enters the Ziv loop once and does one iteration, plus one
+     for each failure */
+  if (c.calls != 10 || c.loops != 10 ||
+      c.iterations != c.loops + c.failures || c.bytes < 0 ||
+      (mpfr_counters_cycles_p () ? c.cycles <= 0 : c.cycles != 0))
+    {
+      printf ("Error: wrong counters for mpfr_sin: calls=%lu loops=%lu"
+              " iterations=%lu failures=%lu bytes=%g cycles=%g\n", c.calls,
+              c.loops, c.iterations, c.failures, c.bytes, c.cycles);
+      exit (1);
+    }
+
+  /* The counters are reset, but the functions are kept. */
+  mpfr_counters_reset ();
+  if (mpfr_counters_get (NULL, 0) != n || get_counters (&c, "mpfr_sin") == 0
+      || c.calls != 0 || c.loops != 0 || c.iterations != 0
+      || c.failures != 0
+      || c.bytes != 0 || c.cycles != 0 || mpfr_counters_get_bytes () != 0)
+    {
+      printf ("Error: counters not reset\n");
+      exit (1);
+    }
+  mpfr_clears (x, y, (mpfr_ptr) 0);
+}
+
+/* mpfr_atan2 has two Ziv loops, the second one being used for
+   atan2(+Inf,-Inf) only: it must have a single entry, counting both
+   (each of the two calls below enters one of them). */
+static void
+check_atan2 (void)
+{
+  mpfr_counters_t *tab;
+  mpfr_t x, y, z;
+  unsigned long i, j, n;
+
+  mpfr_inits2 (100, x, y, z, (mpfr_ptr) 0);
+  mpfr_counters_reset ();
+  mpfr_set_ui (y, 1, MPFR_RNDN);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_atan2 (z, y, x, MPFR_RNDN);
+  mpfr_set_inf (y, 1);
+  mpfr_set_inf (x, -1);
+  mpfr_atan2 (z, y, x, MPFR_RNDN);
+
+  n = mpfr_counters_get (NULL, 0);
+  tab = (mpfr_counters_t *) tests_allocate (n * sizeof (mpfr_counters_t));
+  MPFR_ASSERTN (mpfr_counters_get (tab, n) == n);
+  for (i = 0; i < n; i++)
+    for (j = i + 1; j < n; j++)
+      if (strcmp (tab[i].name, tab[j].name) == 0)
+        {
+          printf ("Error: two entries for %s\n", tab[i].name);
+          exit (1);
+        }
+  for (i = 0; i < n; i++)
+    if (strcmp (tab[i].name, "mpfr_atan2") == 0)
+      break;
+  if (i == n || tab[i].calls != 2 || tab[i].loops != 2)
+    {
+      printf ("Error: mpfr_atan2 should have 2 calls and 2 Ziv loops"
+              " entered\n");
+      exit (1);
+    }
+  tests_free (tab, n * sizeof (mpfr_counters_t));
+  mpfr_clears (x, y, z, (mpfr_ptr) 0);
+}
+
+/* A function with two Ziv loops that may both be entered in the same call
+   (like mpfr_lngamma_aux): the first one is entered twice, then the second
+   one, each with one failure, so that each call counts 3 loops. */
+static void
+ziv_two_loops (void)
+{
+  mpfr_prec_t p = 53;
+  MPFR_ZIV_DECL (loop);
+  int i;
+
+  for (i = 0; i < 2; i++)
+    {
+      MPFR_ZIV_INIT (loop, p);
+      MPFR_ZIV_NEXT (loop, p);
+      MPFR_ZIV_FREE (loop);
+    }
+  {
+    MPFR_ZIV_DECL (loop2);
+
+    MPFR_ZIV_SAME_CALL (loop2, loop);
+    MPFR_ZIV_INIT (loop2, p);
+    MPFR_ZIV_NEXT (loop2, p);
+    MPFR_ZIV_FREE (loop2);
+  }
+}
+
+static void
+check_calls (void)
+{
+  mpfr_counters_t c;
+
+  mpfr_counters_reset ();
+  ziv_two_loops ();
+  ziv_two_loops ();
+  if (get_counters (&c, "ziv_two_loops") == 0 || c.calls != 2 ||
+      c.loops != 6 || c.iterations != 12 || c.failures != 6)
+    {
+      printf ("Error: wrong counters for ziv_two_loops: calls=%lu loops=%lu"
+              " iterations=%lu failures=%lu\n", c.calls, c.loops,
+              c.iterations, c.failures);
+      exit (1);
+    }
+}
+
+/* The counters of bytes must not decrease when the counters are reset
+   between MPFR_ZIV_INIT and MPFR_ZIV_FREE, which is simulated here by
+   calling the internal functions directly. */
+static void
+check_reset (void)
+{
+  static mpfr_counters_node_t node;
+  double b0;
+  int call = 0;
+
+  b0 = mpfr_ziv_counters_start (&node, "check_reset", &call);
+  mpfr_counters_reset ();
+  mpfr_ziv_counters_stop (&node, MPFR_CYCLES (), b0);
+  if (node.c.bytes < 0 || mpfr_counters_get_bytes () != 0)
+    {
+      printf ("Error: wrong bytes after a reset: %g\n", node.c.bytes);
+      exit (1);
+    }
+}
+
+static void
+check_bytes (void)
+{
+  mpfr_t x;
+  double b;
+
+  b = mpfr_counters_get_bytes ();
+  mpfr_init2 (x, 1000);
+  if (mpfr_counters_get_bytes () < b + 1000 / CHAR_BIT)
+    {
+      printf ("Error: allocation of mpfr_init2 not counted\n");
+      exit (1);
+    }
+  b = mpfr_counters_get_bytes ();
+  mpfr_set_prec (x, 2000);
+  if (mpfr_counters_get_bytes () < b + 1000 / CHAR_BIT)
+    {
+      printf ("Error: reallocation of mpfr_set_prec not counted\n");
+      exit (1);
+    }
+  mpfr_clear (x);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_sin ();
+  check_atan2 ();
+  check_calls ();
+  check_reset ();
+  check_bytes ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -1832,6 +1832,111 @@ coverage2 (void)
   mpfr_clear (w);
 }
 
+/* Check that q, with ternary value inex, is u/v correctly rounded in the
+   rounding mode rnd, for u > 0 and v > 0, with exact products: if q is not
+   u/v, the neighbor of q toward u/v (directed rounding) or the midpoint
+   between them (rounding to nearest) must be on the other side of u/v. */
+static void
+check_div_rounding (mpfr_srcptr q, mpfr_srcptr u, mpfr_srcptr v,
+                    mpfr_rnd_t rnd, int inex)
+{
+  mpfr_t r, w;
+  int c, d = 0, ok;
+
+  mpfr_init2 (r, MPFR_PREC (q) + 1);
+  mpfr_init2 (w, MPFR_PREC (r) + MPFR_PREC (v));
+  MPFR_ASSERTN (mpfr_mul (w, q, v, MPFR_RNDN) == 0);
+  c = mpfr_cmp (w, u);  /* sign of q - u/v */
+  ok = SAME_SIGN (c, inex);
+  if (c != 0)
+    {
+      mpfr_set (r, q, MPFR_RNDN);
+      if (c > 0)
+        mpfr_nextbelow (r);
+      else
+        mpfr_nextabove (r);
+      /* r is now the midpoint (it is exact in precision PREC(q) + 1, even
+         when q is a power of 2); once more to get the neighbor */
+      if (rnd != MPFR_RNDN)
+        {
+          if (c > 0)
+            mpfr_nextbelow (r);
+          else
+            mpfr_nextabove (r);
+        }
+      MPFR_ASSERTN (mpfr_mul (w, r, v, MPFR_RNDN) == 0);
+      d = mpfr_cmp (w, u);
+      if (rnd == MPFR_RNDZ || rnd == MPFR_RNDD)
+        ok = ok && c < 0 && d > 0;
+      else if (rnd == MPFR_RNDU || rnd == MPFR_RNDA)
+        ok = ok && c > 0 && d < 0;
+      else /* in case of a tie, the significand of q must be even */
+        ok = ok && (d == 0 ? mpfr_min_prec (q) < MPFR_PREC (q)
+                    : VSIGN (d) == - VSIGN (c));
+    }
+  if (! ok)
+    {
+      printf ("Error in mpfr_div for %s\n", mpfr_print_rnd_mode (rnd));
+      printf ("u = ");
+      mpfr_dump (u);
+      printf ("v = ");
+      mpfr_dump (v);
+      printf ("got q = ");
+      mpfr_dump (q);
+      printf ("inex = %d, c = %d, d = %d\n", inex, c, d);
+      exit (1);
+    }
+  mpfr_clears (r, w, (mpfr_ptr) 0);
+}
+
+/* With --enable-gmp-internals, when the short division is not used (or
+   fails), mpfr_div first computes the quotient with mpn_div_q, without the
+   remainder, and keeps it only if its truncated bits (except the round bit
+   for MPFR_RNDN) are neither 0 nor 1; otherwise it uses mpn_divrem. Both
+   cases are tested here, with operands from 2 limbs to above the default
+   MPFR_DIV_THRESHOLD (25 limbs): the precision has 20 truncated bits in the
+   last limb, and u is z*v, z*v + 1 ulp or z*v - 1 ulp, where the low 20
+   bits of z are 0, 1 or random. */
+static void
+check_div_q (void)
+{
+  mpfr_t q, u, v, z;
+  mpfr_prec_t p;
+  mpfr_rnd_t rnd;
+  int n, i, j, inex;
+
+  for (n = 2; n <= 40; n++)
+    {
+      p = n * GMP_NUMB_BITS - 20;
+      mpfr_inits2 (p, q, v, (mpfr_ptr) 0);
+      mpfr_init2 (z, n * GMP_NUMB_BITS);
+      mpfr_init2 (u, MPFR_PREC (z) + p);
+      for (i = 0; i < 9; i++)
+        {
+          do mpfr_urandomb (z, RANDS); while (mpfr_zero_p (z));
+          do mpfr_urandomb (v, RANDS); while (mpfr_zero_p (v));
+          if (i % 3 < 2)
+            {
+              MPFR_MANT (z)[0] &= ~MPFR_LIMB_MASK (20);
+              MPFR_MANT (z)[0] |= i % 3;
+            }
+          inex = mpfr_mul (u, z, v, MPFR_RNDN);
+          MPFR_ASSERTN (inex == 0);
+          if (i / 3 == 1)
+            mpfr_nextabove (u);
+          else if (i / 3 == 2)
+            mpfr_nextbelow (u);
+          RND_LOOP_NO_RNDF (j)
+            {
+              rnd = (mpfr_rnd_t) j;
+              inex = mpfr_div (q, u, v, rnd);
+              check_div_rounding (q, u, v, rnd, inex);
+            }
+        }
+      mpfr_clears (q, u, v, z, (mpfr_ptr) 0);
+    }
+}
+
 /* perform K random tests of mpfr_divhigh_n_basecase for up to N limbs */
 static void
 check_divhigh_basecase (mpfr_prec_t N, int K)
@@ -1903,6 +2008,7 @@ main (int argc, char *argv[])
   check_divhigh_basecase (100, 1000);
   coverage (1024);
   coverage2 ();
+  check_div_q ();
   bug20180126 ();
   bug20171218 ();
   testall_rndf (9);
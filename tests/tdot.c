@@ -166,6 +166,351 @@ check_special (void)
   mpfr_clears (tab[0], tab[1], tab[2], r, (mpfr_ptr) 0);
 }
 
+#define NMAX 50
+
+/* Reference: the exact products, then mpfr_sum. Since the test is done
+   in the default exponent range, the products are exact. */
+static int
+ref_dot (mpfr_ptr r, mpfr_ptr *a, mpfr_ptr *b, int n, mpfr_rnd_t rnd)
+{
+  mpfr_t c[NMAX];
+  mpfr_ptr cp[NMAX];
+  int i, inex;
+
+  for (i = 0; i < n; i++)
+    {
+      mpfr_init2 (c[i], mpfr_get_prec (a[i]) + mpfr_get_prec (b[i]));
+      inex = mpfr_mul (c[i], a[i], b[i], MPFR_RNDN);
+      MPFR_ASSERTN (inex == 0);
+      cp[i] = c[i];
+    }
+  inex = mpfr_sum (r, cp, n, rnd);
+  for (i = 0; i < n; i++)
+    mpfr_clear (c[i]);
+  return inex;
+}
+
+/* Random inputs with exponents in [-e,e], a few singular values when sing
+   is non-zero, and cancellations (a[i]*b[i] = -a[j]*b[j] for j < i) from
+   time to time. */
+static void
+random_inputs (mpfr_ptr *a, mpfr_ptr *b, int n, mpfr_exp_t e, int sing)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    {
+      if (sing && randlimb () % 32 == 0)
+        {
+          switch (randlimb () % 3)
+            {
+            case 0:
+              mpfr_set_nan (a[i]);
+              break;
+            case 1:
+              mpfr_set_inf (a[i], RAND_BOOL () ? 1 : -1);
+              break;
+            default:
+              mpfr_set_zero (a[i], RAND_BOOL () ? 1 : -1);
+            }
+          mpfr_urandomb (b[i], RANDS);
+          continue;
+        }
+      if (i > 0 && randlimb () % 4 == 0)
+        {
+          int j = randlimb () % i;
+
+          if (mpfr_set (a[i], a[j], MPFR_RNDN) == 0 &&
+              mpfr_neg (b[i], b[j], MPFR_RNDN) == 0)
+            continue;
+        }
+      mpfr_urandomb (a[i], RANDS);
+      mpfr_urandomb (b[i], RANDS);
+      if (MPFR_IS_ZERO (a[i]))
+        mpfr_set_ui (a[i], 1, MPFR_RNDN);
+      if (MPFR_IS_ZERO (b[i]))
+        mpfr_set_ui (b[i], 3, MPFR_RNDN);
+      mpfr_set_exp (a[i], (mpfr_exp_t) (randlimb () % (2 * e + 1)) - e);
+      mpfr_set_exp (b[i], (mpfr_exp_t) (randlimb () % (2 * e + 1)) - e);
+      if (RAND_BOOL ())
+        mpfr_neg (a[i], a[i], MPFR_RNDN);
+    }
+}
+
+/* Compare mpfr_dot with the reference, with random precisions (the same
+   one for all the inputs when same is non-zero). */
+static void
+check_random (void)
+{
+  mpfr_t a[NMAX], b[NMAX], r, s;
+  mpfr_ptr ap[NMAX], bp[NMAX];
+  int k, i, n, rnd, inex, sinex;
+  mpfr_exp_t e;
+
+  for (k = 0; k < 500; k++)
+    {
+      int same = RAND_BOOL ();
+      mpfr_prec_t p = MPFR_PREC_MIN + randlimb () % (4 * GMP_NUMB_BITS);
+
+      n = 1 + randlimb () % NMAX;
+      /* small exponents: one block; large ones: several blocks */
+      e = k % 3 == 0 ? 10 : k % 3 == 1 ? 100 : 5000;
+      for (i = 0; i < n; i++)
+        {
+          mpfr_init2 (a[i], same ? p :
+                      MPFR_PREC_MIN + randlimb () % (4 * GMP_NUMB_BITS));
+          mpfr_init2 (b[i], same ? p :
+                      MPFR_PREC_MIN + randlimb () % (4 * GMP_NUMB_BITS));
+          ap[i] = a[i];
+          bp[i] = b[i];
+        }
+      mpfr_inits2 (MPFR_PREC_MIN + randlimb () % (3 * GMP_NUMB_BITS),
+                   r, s, (mpfr_ptr) 0);
+      random_inputs (ap, bp, n, e, k % 2);
+      /* squares, which use mpn_sqr */
+      if (k % 5 == 0)
+        for (i = 0; i < n; i++)
+          bp[i] = ap[i];
+
+      RND_LOOP_NO_RNDF (rnd)
+        {
+          sinex = ref_dot (s, ap, bp, n, (mpfr_rnd_t) rnd);
+          inex = mpfr_dot (r, ap, bp, n, (mpfr_rnd_t) rnd);
+          if (! SAME_VAL (r, s) || ! SAME_SIGN (inex, sinex))
+            {
+              printf ("Error in check_random for %s, n = %d, k = %d\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), n, k);
+              printf ("expected "); mpfr_dump (s);
+              printf ("got      "); mpfr_dump (r);
+              printf ("ternary: expected %d, got %d\n", sinex, inex);
+              exit (1);
+            }
+        }
+
+      for (i = 0; i < n; i++)
+        mpfr_clears (a[i], b[i], (mpfr_ptr) 0);
+      mpfr_clears (r, s, (mpfr_ptr) 0);
+    }
+}
+
+/* Intermediate overflows and underflows: the exact products may be
+   outside the current exponent range while the result is not, and when
+   the result is outside, the usual overflow/underflow rules apply. */
+static void
+check_range (void)
+{
+  mpfr_t a[4], b[4], r, s;
+  mpfr_ptr ap[4], bp[4];
+  mpfr_exp_t emin, emax;
+  mpfr_flags_t flags, sflags;
+  int i, k, rnd, inex, sinex;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+
+  for (i = 0; i < 4; i++)
+    {
+      mpfr_inits2 (20, a[i], b[i], (mpfr_ptr) 0);
+      ap[i] = a[i];
+      bp[i] = b[i];
+    }
+  mpfr_inits2 (12, r, s, (mpfr_ptr) 0);
+
+  for (k = 0; k < 1000; k++)
+    {
+      /* exponents in [-20,20], thus products in [-40,40] */
+      random_inputs (ap, bp, 4, 20, 0);
+      if (k % 4 == 0)
+        {
+          /* x^2 - (x+u)*(x-u) = u^2, with a huge x */
+          mpfr_set_ui_2exp (a[0], 3, 18, MPFR_RNDN);
+          mpfr_set (b[0], a[0], MPFR_RNDN);
+          mpfr_add_ui (a[1], a[0], 1, MPFR_RNDN);
+          mpfr_sub_ui (b[1], a[0], 1, MPFR_RNDN);
+          mpfr_neg (b[1], b[1], MPFR_RNDN);
+        }
+
+      RND_LOOP_NO_RNDF (rnd)
+        {
+          /* reference, computed in the default exponent range */
+          sinex = ref_dot (s, ap, bp, 4, (mpfr_rnd_t) rnd);
+          set_emin (-16);
+          set_emax (16);
+          mpfr_clear_flags ();
+          sinex = mpfr_check_range (s, sinex, (mpfr_rnd_t) rnd);
+          sflags = __gmpfr_flags;
+
+          mpfr_clear_flags ();
+          inex = mpfr_dot (r, ap, bp, 4, (mpfr_rnd_t) rnd);
+          flags = __gmpfr_flags;
+          set_emin (emin);
+          set_emax (emax);
+
+          if (! SAME_VAL (r, s) || ! SAME_SIGN (inex, sinex) ||
+              flags != sflags)
+            {
+              printf ("Error in check_range for %s, k = %d\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), k);
+              printf ("expected "); mpfr_dump (s);
+              printf ("got      "); mpfr_dump (r);
+              printf ("ternary: expected %d, got %d\n", sinex, inex);
+              printf ("expected flags:");
+              flags_out (sflags);
+              printf ("got flags:     ");
+              flags_out (flags);
+              exit (1);
+            }
+        }
+    }
+
+  for (i = 0; i < 4; i++)
+    mpfr_clears (a[i], b[i], (mpfr_ptr) 0);
+  mpfr_clears (r, s, (mpfr_ptr) 0);
+}
+
+/* Sign of a zero result, with the same rules as mpfr_sum. */
+static void
+check_zero_sign (void)
+{
+  mpfr_t a[2], b[2], r;
+  mpfr_ptr ap[2], bp[2];
+  int i, rnd;
+
+  for (i = 0; i < 2; i++)
+    {
+      mpfr_inits2 (17, a[i], b[i], (mpfr_ptr) 0);
+      ap[i] = a[i];
+      bp[i] = b[i];
+    }
+  mpfr_init2 (r, 17);
+
+  RND_LOOP (rnd)
+    {
+      /* (+0)*(-3) + (-0)*5 = -0 */
+      mpfr_set_zero (a[0], 1);
+      mpfr_set_si (b[0], -3, MPFR_RNDN);
+      mpfr_set_zero (a[1], -1);
+      mpfr_set_ui (b[1], 5, MPFR_RNDN);
+      mpfr_dot (r, ap, bp, 2, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || ! MPFR_IS_NEG (r))
+        {
+          printf ("Error in check_zero_sign (1) for %s\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+
+      /* (-0)*5 + 0*0 = +0, except in MPFR_RNDD */
+      mpfr_set_zero (a[0], 1);
+      mpfr_set_zero (b[0], 1);
+      mpfr_dot (r, ap, bp, 2, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) ||
+          (rnd == MPFR_RNDD ? MPFR_IS_POS (r) : MPFR_IS_NEG (r)))
+        {
+          printf ("Error in check_zero_sign (2) for %s\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+
+      /* 3*5 + (-5)*3 = +0, except in MPFR_RNDD */
+      mpfr_set_ui (a[0], 3, MPFR_RNDN);
+      mpfr_set_ui (b[0], 5, MPFR_RNDN);
+      mpfr_set_si (a[1], -5, MPFR_RNDN);
+      mpfr_set_ui (b[1], 3, MPFR_RNDN);
+      mpfr_dot (r, ap, bp, 2, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) ||
+          (rnd == MPFR_RNDD ? MPFR_IS_POS (r) : MPFR_IS_NEG (r)))
+        {
+          printf ("Error in check_zero_sign (3) for %s\n",
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd));
+          exit (1);
+        }
+    }
+
+  for (i = 0; i < 2; i++)
+    mpfr_clears (a[i], b[i], (mpfr_ptr) 0);
+  mpfr_clear (r);
+}
+
+/* Products with exponents near 2*MPFR_EMAX_MAX and 2*MPFR_EMIN_MIN. */
+static void
+check_extreme (void)
+{
+  mpfr_t a[3], b[3], r;
+  mpfr_ptr ap[3], bp[3];
+  mpfr_exp_t emin, emax;
+  int i, inex;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  set_emin (MPFR_EMIN_MIN);
+  set_emax (MPFR_EMAX_MAX);
+
+  for (i = 0; i < 3; i++)
+    {
+      mpfr_inits2 (53, a[i], b[i], (mpfr_ptr) 0);
+      ap[i] = a[i];
+      bp[i] = b[i];
+    }
+  mpfr_init2 (r, 53);
+
+  /* huge^2 - huge^2 + 1 = 1 */
+  mpfr_setmax (a[0], MPFR_EMAX_MAX);
+  mpfr_set (b[0], a[0], MPFR_RNDN);
+  mpfr_neg (a[1], a[0], MPFR_RNDN);
+  mpfr_set (b[1], a[0], MPFR_RNDN);
+  mpfr_set_ui (a[2], 1, MPFR_RNDN);
+  mpfr_set_ui (b[2], 1, MPFR_RNDN);
+  mpfr_clear_flags ();
+  inex = mpfr_dot (r, ap, bp, 3, MPFR_RNDN);
+  if (mpfr_cmp_ui (r, 1) != 0 || inex != 0 || __gmpfr_flags != 0)
+    {
+      printf ("Error in check_extreme (1)\n");
+      exit (1);
+    }
+
+  /* huge^2 + 1 overflows */
+  mpfr_clear_flags ();
+  inex = mpfr_dot (r, ap + 1, bp + 1, 2, MPFR_RNDZ);
+  if (! mpfr_equal_p (r, a[1]) || inex <= 0 ||
+      __gmpfr_flags != (MPFR_FLAGS_OVERFLOW | MPFR_FLAGS_INEXACT))
+    {
+      printf ("Error in check_extreme (2)\n");
+      exit (1);
+    }
+
+  /* tiny^2 + 1 = 1 + tiny^2, rounded */
+  mpfr_setmin (a[0], MPFR_EMIN_MIN);
+  mpfr_set (b[0], a[0], MPFR_RNDN);
+  mpfr_set (a[1], a[0], MPFR_RNDN);
+  mpfr_set (b[1], a[0], MPFR_RNDN);
+  mpfr_clear_flags ();
+  inex = mpfr_dot (r, ap + 1, bp + 1, 2, MPFR_RNDU);
+  mpfr_nextbelow (r);
+  if (mpfr_cmp_ui (r, 1) != 0 || inex <= 0 ||
+      __gmpfr_flags != MPFR_FLAGS_INEXACT)
+    {
+      printf ("Error in check_extreme (3)\n");
+      exit (1);
+    }
+
+  /* tiny^2 underflows */
+  mpfr_clear_flags ();
+  inex = mpfr_dot (r, ap, bp, 1, MPFR_RNDN);
+  if (! MPFR_IS_ZERO (r) || ! MPFR_IS_POS (r) || inex >= 0 ||
+      __gmpfr_flags != (MPFR_FLAGS_UNDERFLOW | MPFR_FLAGS_INEXACT))
+    {
+      printf ("Error in check_extreme (4)\n");
+      exit (1);
+    }
+
+  for (i = 0; i < 3; i++)
+    mpfr_clears (a[i], b[i], (mpfr_ptr) 0);
+  mpfr_clear (r);
+
+  set_emin (emin);
+  set_emax (emax);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -173,6 +518,10 @@ main (int argc, char *argv[])
 
   check_simple ();
   check_special ();
+  check_zero_sign ();
+  check_random ();
+  check_range ();
+  check_extreme ();
 
   tests_end_mpfr ();
 
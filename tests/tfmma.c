@@ -598,6 +598,55 @@ extreme_underflow (void)
   set_emin (emin);
 }
 
+/* One of the exact products is zero and the other one is out of the
+   exponent range (thus an UBF in mpfr_fmma): the result must be the
+   overflow or underflow of the latter, not a copy of the UBF. */
+static void
+zero_times_ubf (void)
+{
+  mpfr_t a, c, z;
+  mpfr_exp_t emin, emax;
+  int inex, neg, swap, i;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  set_emin (-16);
+  set_emax (16);
+  mpfr_inits2 (8, a, c, z, (mpfr_ptr) 0);
+  mpfr_set_zero (a, -1);
+  for (i = 0; i < 2; i++)
+    {
+      /* c^2 = 2^28 (overflow) for i = 0, 2^-28 (underflow) for i = 1 */
+      mpfr_set_si_2exp (c, -1, i == 0 ? 14 : -14, MPFR_RNDN);
+      for (neg = 0; neg < 2; neg++)
+        for (swap = 0; swap < 2; swap++)
+          {
+            mpfr_clear_flags ();
+            inex = swap ?
+              (neg ? mpfr_fmms : mpfr_fmma) (z, c, c, a, a, MPFR_RNDZ) :
+              (neg ? mpfr_fmms : mpfr_fmma) (z, a, a, c, c, MPFR_RNDZ);
+            if (! mpfr_check (z) ||
+                __gmpfr_flags != (MPFR_FLAGS_INEXACT | (i == 0 ?
+                                  MPFR_FLAGS_OVERFLOW : MPFR_FLAGS_UNDERFLOW))
+                || (i == 0 ? ! mpfr_number_p (z) || mpfr_cmpabs_ui (z, 1) < 0
+                    : ! MPFR_IS_ZERO (z))
+                || (MPFR_IS_NEG (z) != (neg && ! swap))
+                || (inex > 0) != (neg && ! swap) || inex == 0)
+              {
+                printf ("Error in zero_times_ubf for i=%d neg=%d swap=%d\n",
+                        i, neg, swap);
+                printf ("got "); mpfr_dump (z);
+                printf ("inex = %d, flags:", inex);
+                flags_out (__gmpfr_flags);
+                exit (1);
+              }
+          }
+    }
+  mpfr_clears (a, c, z, (mpfr_ptr) 0);
+  set_emin (emin);
+  set_emax (emax);
+}
+
 /* Test double-rounding cases in mpfr_set_1_2, which is called when
    all the precisions are the same. With set.c before r13347, this
    triggers errors for neg=0. */
@@ -676,6 +725,7 @@ main (int argc, char *argv[])
   half_plus_half ();
   bug20170405 ();
   double_rounding ();
+  zero_times_ubf ();
   extreme_underflow ();
 
   tests_end_mpfr ();
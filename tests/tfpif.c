@@ -28,6 +28,8 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define FILE_NAME_R  "tfpif_r1.dat" /* fixed file name (read only) */
 #define FILE_NAME_R2 "tfpif_r2.dat" /* fixed file name (read only) with a
                                        precision > MPFR_PREC_MAX */
+#define FILE_NAME_CACHE "tfpif_cache.dat" /* temporary name for the
+                                            contents of the caches */
 
 /* Note: The perror below must be called just after the failing function,
    thus before fprintf (otherwise one could get an error associated with
@@ -414,6 +416,161 @@ fh_extra (void)
   mpfr_clear (x);
 }
 
+static FILE *
+cache_open (const char *mode)
+{
+  FILE *fh;
+
+  fh = fopen (FILE_NAME_CACHE, mode);
+  if (fh == NULL)
+    {
+      perror ("cache_open");
+      fprintf (stderr, "Failed to open \"%s\" with mode \"%s\"\n",
+               FILE_NAME_CACHE, mode);
+      exit (1);
+    }
+  return fh;
+}
+
+static void
+cache_export (void)
+{
+  FILE *fh;
+
+  fh = cache_open ("wb");
+  if (mpfr_fpif_export_cache (fh) != 0)
+    {
+      printf ("mpfr_fpif_export_cache failed\n");
+      exit (1);
+    }
+  fclose (fh);
+}
+
+static int
+cache_import (void)
+{
+  FILE *fh;
+  int status;
+
+  fh = cache_open ("rb");
+  status = mpfr_fpif_import_cache (fh);
+  fclose (fh);
+  return status;
+}
+
+/* Check that the precision of the cache value is at least prec, or that
+   the cache is empty if prec is 0. */
+static void
+cache_check_prec (mpfr_cache_ptr cache, mpfr_prec_t prec, const char *s)
+{
+  mpfr_t x;
+  int inex;
+
+  mpfr_init2 (x, MPFR_PREC_MIN);
+  inex = mpfr_cache_get_value (x, cache);
+  if (prec == 0 ? inex != 2 : inex == 2 || mpfr_get_prec (x) < prec)
+    {
+      printf ("Error in cache_check_prec for %s: expected precision %ld,"
+              " got %ld (ternary value %d)\n", s, (long) prec,
+              inex == 2 ? 0L : (long) mpfr_get_prec (x), inex);
+      exit (1);
+    }
+  mpfr_clear (x);
+}
+
+/* Save the caches of the constants, then load them back. */
+static void
+fh_cache (void)
+{
+  mpfr_t pi[2], euler[2], x;
+  unsigned char c;
+  FILE *fh;
+  int inex[4], r;
+  long size;
+
+  MPFR_ASSERTN (mpfr_fpif_export_cache (NULL) != 0);
+  MPFR_ASSERTN (mpfr_fpif_import_cache (NULL) != 0);
+
+  mpfr_free_cache ();
+  mpfr_inits2 (1000, pi[0], pi[1], euler[0], euler[1], x, (mpfr_ptr) 0);
+  inex[0] = mpfr_const_pi (pi[0], MPFR_RNDD);
+  inex[1] = mpfr_const_pi (pi[1], MPFR_RNDU);
+  mpfr_set_prec (euler[0], 200);
+  mpfr_set_prec (euler[1], 200);
+  inex[2] = mpfr_const_euler (euler[0], MPFR_RNDD);
+  inex[3] = mpfr_const_euler (euler[1], MPFR_RNDU);
+  cache_export ();
+
+  /* the file can be loaded in a new state */
+  mpfr_free_cache ();
+  cache_check_prec (__gmpfr_cache_const_pi, 0, "pi");
+  if (cache_import () != 0)
+    {
+      printf ("mpfr_fpif_import_cache failed\n");
+      exit (1);
+    }
+  cache_check_prec (__gmpfr_cache_const_pi, 1000, "pi");
+  cache_check_prec (__gmpfr_cache_const_euler, 200, "euler");
+  cache_check_prec (__gmpfr_cache_const_catalan, 0, "catalan");
+  for (r = 0; r < 2; r++)
+    {
+      int i;
+
+      i = mpfr_const_pi (x, r ? MPFR_RNDU : MPFR_RNDD);
+      MPFR_ASSERTN (mpfr_equal_p (x, pi[r]) && SAME_SIGN (i, inex[r]));
+      mpfr_set_prec (x, 200);
+      i = mpfr_const_euler (x, r ? MPFR_RNDU : MPFR_RNDD);
+      MPFR_ASSERTN (mpfr_equal_p (x, euler[r]) && SAME_SIGN (i, inex[2+r]));
+      mpfr_set_prec (x, 1000);
+    }
+
+  /* a cache with a larger precision is kept */
+  mpfr_set_prec (x, 2000);
+  mpfr_const_pi (x, MPFR_RNDN);
+  MPFR_ASSERTN (cache_import () == 0);
+  cache_check_prec (__gmpfr_cache_const_pi, 2000, "pi (kept)");
+
+  /* a corrupted file is rejected */
+  fh = cache_open ("r+b");
+  fseek (fh, 0, SEEK_END);
+  size = ftell (fh);
+  fseek (fh, size / 2, SEEK_SET);
+  c = getc (fh);
+  fseek (fh, size / 2, SEEK_SET);
+  putc (c ^ 1, fh);
+  fclose (fh);
+  mpfr_free_cache ();
+  if (cache_import () == 0)
+    {
+      printf ("mpfr_fpif_import_cache did not fail on a corrupted file\n");
+      exit (1);
+    }
+  cache_check_prec (__gmpfr_cache_const_pi, 0, "pi (corrupted)");
+  cache_check_prec (__gmpfr_cache_const_euler, 0, "euler (corrupted)");
+
+  /* so is a file with a bad magic number */
+  fh = cache_open ("wb");
+  fputs ("MPFRx", fh);
+  fclose (fh);
+  MPFR_ASSERTN (cache_import () != 0);
+
+  /* and a file with a wrong value and a correct checksum */
+  mpfr_set_prec (x, 10);
+  mpfr_set_ui (x, 3, MPFR_RNDN);
+  mpfr_cache_set_value (__gmpfr_cache_const_pi, x, 0);
+  cache_export ();
+  mpfr_free_cache ();
+  if (cache_import () == 0)
+    {
+      printf ("mpfr_fpif_import_cache did not fail on a wrong value\n");
+      exit (1);
+    }
+  cache_check_prec (__gmpfr_cache_const_pi, 0, "pi (wrong value)");
+
+  remove (FILE_NAME_CACHE);
+  mpfr_clears (pi[0], pi[1], euler[0], euler[1], x, (mpfr_ptr) 0);
+}
+
 static void
 mem_doit (int argc, char *argv[], mpfr_prec_t p1, mpfr_prec_t p2)
 {
@@ -544,6 +701,7 @@ main (int argc, char *argv[])
   fh_doit (argc, argv, 130, 2048);
   fh_doit (argc, argv, 1, 53);
   fh_check_bad ();
+  fh_cache ();
 
   mem_doit (argc, argv, 130, 2048);
   mem_doit (argc, argv, 1, 53);
@@ -21,6 +21,57 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-test.h"
 
+/* Check mpfr_init_array2 and mpfr_clear_array: single allocation (when
+   the allocations are counted by the test suite), contiguity of the
+   significands, and use of the variables, which may be swapped. */
+static void
+check_array (void)
+{
+  __mpfr_struct x[50];
+  mpfr_prec_t p;
+  unsigned long i, n = numberof (x);
+  size_t c;
+
+  for (p = 8; p <= 3 * GMP_NUMB_BITS + 16; p += 17)
+    {
+      c = tests_get_nalloc ();
+      mpfr_init_array2 (x, n, p);
+      if (! tests_memory_disabled && tests_get_nalloc () != c + 1)
+        {
+          printf ("Error in mpfr_init_array2: %lu allocations\n",
+                  (unsigned long) (tests_get_nalloc () - c));
+          exit (1);
+        }
+      for (i = 0; i < n; i++)
+        {
+          if (! mpfr_nan_p (x + i) || mpfr_get_prec (x + i) != p)
+            {
+              printf ("Error in mpfr_init_array2 for i = %lu\n", i);
+              exit (1);
+            }
+          if (i > 0 && (char *) mpfr_custom_get_significand (x + i) !=
+              (char *) mpfr_custom_get_significand (x + (i - 1)) +
+              mpfr_custom_get_size (p))
+            {
+              printf ("Error, significands are not contiguous\n");
+              exit (1);
+            }
+          mpfr_set_ui (x + i, i, MPFR_RNDN);
+        }
+      mpfr_swap (x, x + (n - 1));
+      mpfr_swap (x + 1, x + (n / 2));
+      if (mpfr_cmp_ui (x, n - 1) != 0 || mpfr_cmp_ui (x + (n - 1), 0) != 0)
+        {
+          printf ("Error in mpfr_swap on an array\n");
+          exit (1);
+        }
+      mpfr_clear_array (x, n);
+    }
+
+  mpfr_init_array2 (x, 0, 17);
+  mpfr_clear_array (x, 0);
+}
+
 int
 main (void)
 {
@@ -34,6 +85,8 @@ main (void)
   mpfr_inits2 (200, a, b, c, (mpfr_ptr) 0);
   mpfr_clears (a, b, c, (mpfr_ptr) 0);
 
+  check_array ();
+
   /* Test for precision 2^31-1 (old bug 13918 on InriaForge, 2012-02-22),
      if allowed (see the constraint on MPFR_PREC_MAX below).
      On 32-bit Linux machines, the prec+GMP_NUMB_BITS-1 in the old formula
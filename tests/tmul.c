@@ -1296,6 +1296,73 @@ coverage2 (void)
   set_emin (emin); /* restore emin */
 }
 
+/* Check the product of numbers with low zero limbs (for instance small
+   integers stored in a large precision), for which mpfr_mul skips the zero
+   limbs, against the product of the same values with a small precision. */
+static void
+check_sparse (void)
+{
+  mpfr_t a1, a2, b, c, bs, cs;
+  mpfr_prec_t pa, pb, pc;
+  int i, r, inex1, inex2;
+
+  for (i = 0; i < 1000; i++)
+    {
+      pa = MPFR_PREC_MIN + randlimb () % (40 * GMP_NUMB_BITS);
+      pb = MPFR_PREC_MIN + randlimb () % (40 * GMP_NUMB_BITS);
+      pc = MPFR_PREC_MIN + randlimb () % (40 * GMP_NUMB_BITS);
+      mpfr_inits2 (pa, a1, a2, (mpfr_ptr) 0);
+      mpfr_init2 (b, pb);
+      mpfr_init2 (c, pc);
+      /* bs and cs are either sparse or as dense as b and c */
+      mpfr_init2 (bs, randlimb () % 2 ? pb :
+                  MPFR_PREC_MIN + randlimb () % MIN (pb, 2 * GMP_NUMB_BITS));
+      mpfr_init2 (cs, randlimb () % 2 ? pc :
+                  MPFR_PREC_MIN + randlimb () % MIN (pc, 2 * GMP_NUMB_BITS));
+      mpfr_urandomb (bs, RANDS);
+      mpfr_urandomb (cs, RANDS);
+      if (MPFR_IS_ZERO (bs))
+        mpfr_set_ui (bs, 1, MPFR_RNDN);
+      if (MPFR_IS_ZERO (cs))
+        mpfr_set_ui (cs, 1, MPFR_RNDN);
+      inex1 = mpfr_set (b, bs, MPFR_RNDN);
+      inex2 = mpfr_set (c, cs, MPFR_RNDN);
+      MPFR_ASSERTN (inex1 == 0 && inex2 == 0);
+      RND_LOOP_NO_RNDF (r)
+        {
+          inex1 = mpfr_mul (a1, b, c, (mpfr_rnd_t) r);
+          inex2 = mpfr_mul (a2, bs, cs, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              printf ("b = "); mpfr_dump (b);
+              printf ("c = "); mpfr_dump (c);
+              printf ("Expected "); mpfr_dump (a2);
+              printf ("  with inex = %d\n", inex2);
+              printf ("Got      "); mpfr_dump (a1);
+              printf ("  with inex = %d\n", inex1);
+              exit (1);
+            }
+          /* square */
+          inex1 = mpfr_mul (a1, b, b, (mpfr_rnd_t) r);
+          inex2 = mpfr_mul (a2, bs, bs, (mpfr_rnd_t) r);
+          if (! mpfr_equal_p (a1, a2) || ! SAME_SIGN (inex1, inex2))
+            {
+              printf ("Error in check_sparse (square) for %s\n",
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) r));
+              printf ("b = "); mpfr_dump (b);
+              printf ("Expected "); mpfr_dump (a2);
+              printf ("  with inex = %d\n", inex2);
+              printf ("Got      "); mpfr_dump (a1);
+              printf ("  with inex = %d\n", inex1);
+              exit (1);
+            }
+        }
+      mpfr_clears (a1, a2, b, c, bs, cs, (mpfr_ptr) 0);
+    }
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1303,6 +1370,7 @@ main (int argc, char *argv[])
 
   coverage (1024);
   coverage2 ();
+  check_sparse ();
   testall_rndf (9);
   check_nans ();
   check_exact ();
@@ -0,0 +1,179 @@
+/* Test file for the mpz_t pool.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+
+#include "mpfr-test.h"
+
+#if MPFR_POOL_NENTRIES
+
+/* Initialize a mpz_t for m limbs and clear it (which puts it in the pool),
+   and return non-zero if it has been served from the pool. */
+static int
+served_p (mp_size_t m)
+{
+  unsigned long h0, h1, m0, m1;
+  mpz_t z;
+
+  mpfr_pool_get_stats (&h0, &m0);
+  mpz_init2 (z, m * GMP_NUMB_BITS);
+  mpfr_pool_get_stats (&h1, &m1);
+  MPFR_ASSERTN (h1 + m1 == h0 + m0 + 1);
+  /* the mpz_t must be large enough */
+  MPFR_ASSERTN (ALLOC (z) >= m);
+  mpz_clear (z);
+  return h1 != h0;
+}
+
+/* Put a mpz_t of n limbs in the pool, and check whether a request of
+   m limbs is then served from the pool. */
+static int
+hit_p (mp_size_t n, mp_size_t m)
+{
+  mpz_t z;
+
+  mpz_init2 (z, n * GMP_NUMB_BITS);
+  mpz_clear (z);
+  return served_p (m);
+}
+
+static void
+check_classes (void)
+{
+  mpfr_free_pool ();
+  MPFR_ASSERTN (mpfr_pool_set_limits (4, 1000 * GMP_NUMB_BITS) == 0);
+  MPFR_ASSERTN (hit_p (100, 50));
+  MPFR_ASSERTN (hit_p (100, 64));
+  MPFR_ASSERTN (hit_p (100, 100));
+  MPFR_ASSERTN (! hit_p (100, 101));
+  MPFR_ASSERTN (hit_p (300, 2));
+  /* too large for the pool */
+  MPFR_ASSERTN (! hit_p (1200, 1100));
+  mpfr_free_pool ();
+  MPFR_ASSERTN (! served_p (1));
+}
+
+static void
+check_limits (void)
+{
+  unsigned int n;
+  mp_bitcnt_t s;
+  mpz_t z[3];
+  int i;
+
+  mpfr_free_pool ();
+  MPFR_ASSERTN (mpfr_pool_set_limits (MPFR_POOL_NENTRIES + 1, 0) != 0);
+  MPFR_ASSERTN (mpfr_pool_set_limits (2, 100 * GMP_NUMB_BITS) == 0);
+  mpfr_pool_get_limits (&n, &s);
+  MPFR_ASSERTN (n == 2 && s == 100 * GMP_NUMB_BITS);
+  MPFR_ASSERTN (! hit_p (200, 1));
+
+  /* only 2 of the 3 entries are kept */
+  for (i = 0; i < 3; i++)
+    mpz_init2 (z[i], GMP_NUMB_BITS);
+  for (i = 0; i < 3; i++)
+    mpz_clear (z[i]);
+  for (i = 0; i < 3; i++)
+    {
+      unsigned long h0, h1, m;
+
+      mpfr_pool_get_stats (&h0, &m);
+      mpz_init2 (z[i], GMP_NUMB_BITS);
+      mpfr_pool_get_stats (&h1, &m);
+      MPFR_ASSERTN ((h1 != h0) == (i < 2));
+    }
+  for (i = 0; i < 3; i++)
+    mpz_clear (z[i]);
+
+  /* lowering the limits frees the entries beyond them */
+  MPFR_ASSERTN (mpfr_pool_set_limits (1, 100 * GMP_NUMB_BITS) == 0);
+  for (i = 0; i < 2; i++)
+    {
+      unsigned long h0, h1, m;
+
+      mpfr_pool_get_stats (&h0, &m);
+      mpz_init2 (z[i], GMP_NUMB_BITS);
+      mpfr_pool_get_stats (&h1, &m);
+      MPFR_ASSERTN ((h1 != h0) == (i < 1));
+    }
+  for (i = 0; i < 2; i++)
+    mpz_clear (z[i]);
+  MPFR_ASSERTN (mpfr_pool_set_limits (0, 0) == 0);
+  MPFR_ASSERTN (! served_p (1));
+}
+
+static void
+check_trim (void)
+{
+  mpfr_free_pool ();
+  MPFR_ASSERTN (mpfr_pool_set_limits (4, 100 * GMP_NUMB_BITS) == 0);
+  MPFR_ASSERTN (! served_p (10));
+  /* the entry has been used since the pool was freed */
+  mpfr_free_cache2 (MPFR_TRIM_POOL);
+  MPFR_ASSERTN (served_p (10));
+  mpfr_free_cache2 (MPFR_TRIM_POOL);
+  /* but not since the last trim */
+  mpfr_free_cache2 (MPFR_TRIM_POOL);
+  MPFR_ASSERTN (! served_p (10));
+}
+
+int
+main (void)
+{
+  unsigned int n;
+  mp_bitcnt_t s;
+  unsigned long h, m;
+
+  tests_start_mpfr ();
+
+  mpfr_pool_get_limits (&n, &s);
+  MPFR_ASSERTN (n == MPFR_POOL_NENTRIES);
+  mpfr_pool_reset_stats ();
+  mpfr_pool_get_stats (&h, &m);
+  MPFR_ASSERTN (h == 0 && m == 0);
+
+  check_classes ();
+  check_limits ();
+  check_trim ();
+
+  MPFR_ASSERTN (mpfr_pool_set_limits (n, s) == 0);
+
+  tests_end_mpfr ();
+  return 0;
+}
+
+#else
+
+int
+main (void)
+{
+  unsigned int n;
+  mp_bitcnt_t s;
+
+  tests_start_mpfr ();
+  MPFR_ASSERTN (mpfr_pool_set_limits (1, 0) != 0);
+  MPFR_ASSERTN (mpfr_pool_set_limits (0, 0) == 0);
+  mpfr_pool_get_limits (&n, &s);
+  MPFR_ASSERTN (n == 0 && s == 0);
+  tests_end_mpfr ();
+  return 0;
+}
+
+#endif
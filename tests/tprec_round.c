@@ -21,6 +21,50 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "mpfr-test.h"
 
+/* Check that mpfr_set_prec and mpfr_prec_round do not reallocate the
+   significand up to the precision given to mpfr_reserve_prec, and that
+   mpfr_ziv_set_prec reserves the precision of the next Ziv iteration. */
+static void
+check_reserve (void)
+{
+  mpfr_t x;
+  mpfr_prec_t p;
+  size_t c;
+
+  mpfr_init2 (x, 3);
+  mpfr_set_ui (x, 5, MPFR_RNDN);
+  mpfr_reserve_prec (x, 10 * GMP_NUMB_BITS);
+  MPFR_ASSERTN (MPFR_GET_ALLOC_SIZE (x) == 10);
+  if (mpfr_get_prec (x) != 3 || mpfr_cmp_ui (x, 5) != 0)
+    {
+      printf ("Error in mpfr_reserve_prec: value or precision changed\n");
+      exit (1);
+    }
+  c = tests_get_nalloc ();
+  for (p = 3; p <= 10 * GMP_NUMB_BITS; p += 13)
+    {
+      mpfr_prec_round (x, p, MPFR_RNDN);
+      MPFR_ASSERTN (mpfr_cmp_ui (x, 5) == 0);
+    }
+  for (p = 1; p <= 10 * GMP_NUMB_BITS; p += 13)
+    mpfr_set_prec (x, p);
+  if (tests_get_nalloc () != c)
+    {
+      printf ("Error, reallocation after mpfr_reserve_prec\n");
+      exit (1);
+    }
+  /* reserving less does nothing */
+  mpfr_reserve_prec (x, 2);
+  MPFR_ASSERTN (MPFR_GET_ALLOC_SIZE (x) == 10);
+
+  mpfr_ziv_set_prec (x, 20 * GMP_NUMB_BITS);
+  MPFR_ASSERTN (MPFR_GET_ALLOC_SIZE (x) == 30);
+  MPFR_ASSERTN (mpfr_get_prec (x) == 20 * GMP_NUMB_BITS && mpfr_nan_p (x));
+  mpfr_ziv_set_prec (x, 30 * GMP_NUMB_BITS);
+  MPFR_ASSERTN (MPFR_GET_ALLOC_SIZE (x) == 30);
+  mpfr_clear (x);
+}
+
 int
 main (void)
 {
@@ -115,6 +159,8 @@ main (void)
 
    mpfr_clear(x);
 
+   check_reserve ();
+
    tests_end_mpfr ();
    return 0;
 }
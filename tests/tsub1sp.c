@@ -416,6 +416,7 @@ int
 main (void)
 {
   mpfr_prec_t p;
+  int i;
 
   tests_start_mpfr ();
 
@@ -435,6 +436,14 @@ main (void)
       check_random (p);
       check_corner (p);
     }
+  /* precisions of 4 to 8 limbs, which have their own code */
+  for (i = 4; i <= 8; i++)
+    for (p = i * GMP_NUMB_BITS - 1; p <= i * GMP_NUMB_BITS; p++)
+      {
+        check_underflow (p);
+        check_random (p);
+        check_corner (p);
+      }
 
   tests_end_mpfr ();
   return 0;
@@ -0,0 +1,170 @@
+/* Test file for mpfr_sum_parallel.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+/* The number of terms must be large enough for several threads to be
+   used (see MPFR_SUM_PARALLEL_THRESHOLD in sum_parallel.c). */
+#define N 9000
+
+/* Check that mpfr_sum_parallel gives the same result, ternary value and
+   flags as mpfr_sum, for 0 to 8 threads, in all the rounding modes. */
+static void
+compare (mpfr_vec_t v, unsigned long n, mpfr_prec_t prec, const char *s)
+{
+  mpfr_t r1, r2;
+  mpfr_flags_t flags1, flags2;
+  unsigned int k;
+  int inex1, inex2, rnd;
+
+  mpfr_inits2 (prec, r1, r2, (mpfr_ptr) 0);
+
+  RND_LOOP_NO_RNDF (rnd)
+    {
+      mpfr_clear_flags ();
+      inex1 = mpfr_sum (r1, mpfr_vec_ptrs (v), n, (mpfr_rnd_t) rnd);
+      flags1 = __gmpfr_flags;
+      for (k = 0; k <= 8; k++)
+        {
+          mpfr_clear_flags ();
+          inex2 = mpfr_sum_parallel (r2, mpfr_vec_ptrs (v), n, k,
+                                     (mpfr_rnd_t) rnd);
+          flags2 = __gmpfr_flags;
+          if (! SAME_VAL (r1, r2) || ! SAME_SIGN (inex1, inex2) ||
+              flags1 != flags2)
+            {
+              printf ("Error in %s for %s, n = %lu, %u threads\n", s,
+                      mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), n, k);
+              printf ("expected "); mpfr_dump (r1);
+              printf ("got      "); mpfr_dump (r2);
+              printf ("ternary: expected %d, got %d\n", inex1, inex2);
+              printf ("expected flags:");
+              flags_out (flags1);
+              printf ("got flags:     ");
+              flags_out (flags2);
+              exit (1);
+            }
+        }
+    }
+
+  mpfr_clears (r1, r2, (mpfr_ptr) 0);
+}
+
+/* Set the n elements of v to random values with exponents in [-e,e]. If
+   cancel is non-zero, the second half is the opposite of the first one,
+   up to a few terms. */
+static void
+random_vec (mpfr_vec_t v, unsigned long n, mpfr_exp_t e, int cancel)
+{
+  unsigned long i;
+
+  for (i = 0; i < n; i++)
+    {
+      mpfr_ptr x = mpfr_vec_get (v, i);
+
+      if (cancel && i >= n / 2 && i < n - 3)
+        {
+          mpfr_neg (x, mpfr_vec_get (v, i - n / 2), MPFR_RNDN);
+          continue;
+        }
+      mpfr_urandomb (x, RANDS);
+      if (MPFR_IS_ZERO (x))
+        mpfr_set_ui (x, 1, MPFR_RNDN);
+      mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % (2 * e + 1)) - e);
+      if (RAND_BOOL ())
+        mpfr_neg (x, x, MPFR_RNDN);
+    }
+}
+
+static void
+check_random (void)
+{
+  mpfr_vec_t v;
+  mpfr_exp_t emin, emax;
+  int k;
+
+  for (k = 0; k < 8; k++)
+    {
+      mpfr_prec_t p = MPFR_PREC_MIN + randlimb () % 150;
+
+      mpfr_vec_init2 (v, N, p);
+      random_vec (v, N, k % 2 ? 10 : 1000, k >= 4);
+      compare (v, N, MPFR_PREC_MIN + randlimb () % 150, "check_random");
+      compare (v, N / 2 + 17, p, "check_random");
+      mpfr_vec_clear (v);
+    }
+
+  /* overflow of the result */
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  set_emin (-20);
+  set_emax (20);
+  mpfr_vec_init2 (v, N, 16);
+  random_vec (v, N, 20, 0);
+  for (k = 0; k < N; k++)
+    mpfr_abs (mpfr_vec_get (v, k), mpfr_vec_get (v, k), MPFR_RNDN);
+  compare (v, N, 12, "check_random (overflow)");
+  mpfr_vec_clear (v);
+  set_emin (emin);
+  set_emax (emax);
+}
+
+/* Singular values anywhere in the array, and zero sums. */
+static void
+check_special (void)
+{
+  mpfr_vec_t v;
+  unsigned long i;
+
+  mpfr_vec_init2 (v, N, 32);
+
+  for (i = 0; i < N; i++)
+    mpfr_set_zero (mpfr_vec_get (v, i), -1);
+  compare (v, N, 32, "check_special (-0)");
+  mpfr_set_zero (mpfr_vec_get (v, N - 1), 1);
+  compare (v, N, 32, "check_special (-0 and +0)");
+
+  random_vec (v, N, 50, 1);
+  compare (v, N, 32, "check_special (cancellation)");
+  mpfr_set_inf (mpfr_vec_get (v, N - 2), -1);
+  compare (v, N, 32, "check_special (-Inf)");
+  mpfr_set_inf (mpfr_vec_get (v, 1), 1);
+  compare (v, N, 32, "check_special (+Inf, -Inf)");
+  mpfr_set_inf (mpfr_vec_get (v, 1), -1);
+  mpfr_set_nan (mpfr_vec_get (v, N / 2));
+  compare (v, N, 32, "check_special (NaN)");
+
+  compare (v, 0, 32, "check_special (n = 0)");
+
+  mpfr_vec_clear (v);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_special ();
+  check_random ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,389 @@
+/* Test file for the sum accumulator (mpfr_sumacc_t).
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 60
+
+/* Set x to a random value with an exponent in [-e,e], singular with
+   probability about 1/sing if sing is non-zero. */
+static void
+random_term (mpfr_ptr x, mpfr_exp_t e, int sing)
+{
+  if (sing != 0 && randlimb () % sing == 0)
+    {
+      switch (randlimb () % 4)
+        {
+        case 0:
+          mpfr_set_nan (x);
+          break;
+        case 1:
+          mpfr_set_inf (x, RAND_BOOL () ? 1 : -1);
+          break;
+        default:
+          mpfr_set_zero (x, RAND_BOOL () ? 1 : -1);
+        }
+      return;
+    }
+  mpfr_urandomb (x, RANDS);
+  if (MPFR_IS_ZERO (x))
+    mpfr_set_ui (x, 1, MPFR_RNDN);
+  mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % (2 * e + 1)) - e);
+  if (RAND_BOOL ())
+    mpfr_neg (x, x, MPFR_RNDN);
+}
+
+/* Add tab[0..n-1] to acc with a random mix of mpfr_sumacc_add and
+   mpfr_sumacc_add_array. */
+static void
+add_terms (mpfr_sumacc_t acc, mpfr_ptr *tab, int n)
+{
+  int i = 0;
+
+  while (i < n)
+    {
+      int k = randlimb () % (n - i + 1);
+
+      if (k == 0)
+        mpfr_sumacc_add (acc, tab[i++]);
+      else
+        {
+          mpfr_sumacc_add_array (acc, tab + i, k);
+          i += k;
+        }
+    }
+}
+
+/* Compare mpfr_sumacc_get with mpfr_sum on the same terms, in the
+   current exponent range. */
+static void
+compare (mpfr_ptr *tab, int n, mpfr_prec_t prec, const char *s)
+{
+  mpfr_sumacc_t acc;
+  mpfr_t r1, r2;
+  mpfr_flags_t flags1, flags2;
+  int inex1, inex2, rnd, k;
+
+  mpfr_inits2 (prec, r1, r2, (mpfr_ptr) 0);
+  mpfr_sumacc_init (acc);
+  add_terms (acc, tab, n);
+
+  RND_LOOP_NO_RNDF (rnd)
+    for (k = 0; k < 2; k++)  /* mpfr_sumacc_get must not change acc */
+      {
+        mpfr_clear_flags ();
+        inex1 = mpfr_sum (r1, tab, n, (mpfr_rnd_t) rnd);
+        flags1 = __gmpfr_flags;
+        mpfr_clear_flags ();
+        inex2 = mpfr_sumacc_get (r2, acc, (mpfr_rnd_t) rnd);
+        flags2 = __gmpfr_flags;
+        if (! SAME_VAL (r1, r2) || ! SAME_SIGN (inex1, inex2) ||
+            flags1 != flags2)
+          {
+            printf ("Error in %s for %s, n = %d, prec = %lu\n", s,
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), n,
+                    (unsigned long) prec);
+            printf ("expected "); mpfr_dump (r1);
+            printf ("got      "); mpfr_dump (r2);
+            printf ("ternary: expected %d, got %d\n", inex1, inex2);
+            printf ("expected flags:");
+            flags_out (flags1);
+            printf ("got flags:     ");
+            flags_out (flags2);
+            exit (1);
+          }
+      }
+
+  mpfr_sumacc_clear (acc);
+  mpfr_clears (r1, r2, (mpfr_ptr) 0);
+}
+
+static void
+check_random (void)
+{
+  mpfr_t x[N];
+  mpfr_ptr tab[N];
+  int i, k, n;
+
+  for (i = 0; i < N; i++)
+    tab[i] = x[i];
+
+  for (k = 0; k < 1000; k++)
+    {
+      static const mpfr_exp_t e[] = { 5, 50, 1000, 100000 };
+
+      n = randlimb () % (N + 1);
+      for (i = 0; i < n; i++)
+        {
+          mpfr_init2 (x[i], MPFR_PREC_MIN + randlimb () % 200);
+          random_term (x[i], e[k % 4], k % 3 == 0 ? 20 : 0);
+        }
+      /* cancellations, with terms equal to the opposite of other terms
+         (and in particular an exact zero sum from time to time) */
+      if (k % 5 == 0)
+        for (i = n / 2; i < n; i++)
+          {
+            mpfr_set_prec (x[i], mpfr_get_prec (x[i - n / 2]));
+            mpfr_neg (x[i], x[i - n / 2], MPFR_RNDN);
+          }
+      compare (tab, n, MPFR_PREC_MIN + randlimb () % 150, "check_random");
+      for (i = 0; i < n; i++)
+        mpfr_clear (x[i]);
+    }
+}
+
+/* Overflows and underflows of the result in a reduced exponent range. */
+static void
+check_range (void)
+{
+  mpfr_t x[N];
+  mpfr_ptr tab[N];
+  mpfr_exp_t emin, emax;
+  int i, k, n;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  set_emin (-20);
+  set_emax (20);
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_init2 (x[i], 16);
+      tab[i] = x[i];
+    }
+
+  for (k = 0; k < 1000; k++)
+    {
+      n = 1 + randlimb () % N;
+      for (i = 0; i < n; i++)
+        {
+          random_term (x[i], 20, 0);
+          /* mostly terms of the same sign, to get overflows */
+          if (k % 2 == 0)
+            mpfr_abs (x[i], x[i], MPFR_RNDN);
+        }
+      compare (tab, n, 12, "check_range");
+    }
+
+  for (i = 0; i < N; i++)
+    mpfr_clear (x[i]);
+
+  set_emin (emin);
+  set_emax (emax);
+}
+
+/* Special cases: empty accumulator, signs of zero, reuse after
+   mpfr_sumacc_get and after mpfr_sumacc_clear. */
+static void
+check_special (void)
+{
+  mpfr_sumacc_t acc;
+  mpfr_t x, r;
+  int inex, rnd;
+
+  mpfr_inits2 (32, x, r, (mpfr_ptr) 0);
+
+  mpfr_sumacc_init (acc);
+  RND_LOOP (rnd)
+    {
+      inex = mpfr_sumacc_get (r, acc, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || ! MPFR_IS_POS (r) || inex != 0)
+        {
+          printf ("Error for an empty accumulator\n");
+          exit (1);
+        }
+    }
+
+  mpfr_set_zero (x, -1);
+  mpfr_sumacc_add (acc, x);
+  mpfr_sumacc_add (acc, x);
+  RND_LOOP (rnd)
+    {
+      inex = mpfr_sumacc_get (r, acc, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || ! MPFR_IS_NEG (r) || inex != 0)
+        {
+          printf ("Error for -0 + -0\n");
+          exit (1);
+        }
+    }
+
+  /* add terms after mpfr_sumacc_get: -0 + -0 + 17 - 17 + 5 */
+  mpfr_set_ui (x, 17, MPFR_RNDN);
+  mpfr_sumacc_add (acc, x);
+  mpfr_neg (x, x, MPFR_RNDN);
+  mpfr_sumacc_add (acc, x);
+  RND_LOOP (rnd)
+    {
+      inex = mpfr_sumacc_get (r, acc, (mpfr_rnd_t) rnd);
+      if (! MPFR_IS_ZERO (r) || inex != 0 ||
+          (rnd == MPFR_RNDD ? MPFR_IS_POS (r) : MPFR_IS_NEG (r)))
+        {
+          printf ("Error for -0 + -0 + 17 - 17\n");
+          exit (1);
+        }
+    }
+  mpfr_set_ui (x, 5, MPFR_RNDN);
+  mpfr_sumacc_add (acc, x);
+  inex = mpfr_sumacc_get (r, acc, MPFR_RNDN);
+  if (mpfr_cmp_ui (r, 5) != 0 || inex != 0)
+    {
+      printf ("Error for -0 + -0 + 17 - 17 + 5\n");
+      exit (1);
+    }
+
+  /* +Inf and -Inf give NaN */
+  mpfr_set_inf (x, 1);
+  mpfr_sumacc_add (acc, x);
+  mpfr_clear_flags ();
+  inex = mpfr_sumacc_get (r, acc, MPFR_RNDN);
+  if (! mpfr_inf_p (r) || ! MPFR_IS_POS (r) || inex != 0 ||
+      __gmpfr_flags != 0)
+    {
+      printf ("Error for +Inf\n");
+      exit (1);
+    }
+  mpfr_neg (x, x, MPFR_RNDN);
+  mpfr_sumacc_add (acc, x);
+  mpfr_clear_flags ();
+  inex = mpfr_sumacc_get (r, acc, MPFR_RNDN);
+  if (! mpfr_nan_p (r) || inex != 0 || __gmpfr_flags != MPFR_FLAGS_NAN)
+    {
+      printf ("Error for +Inf - Inf\n");
+      exit (1);
+    }
+
+  /* the accumulator can be reused after mpfr_sumacc_clear */
+  mpfr_sumacc_clear (acc);
+  mpfr_sumacc_init (acc);
+  mpfr_set_si (x, -3, MPFR_RNDN);
+  mpfr_sumacc_add (acc, x);
+  inex = mpfr_sumacc_get (r, acc, MPFR_RNDN);
+  if (mpfr_cmp_si (r, -3) != 0 || inex != 0)
+    {
+      printf ("Error after mpfr_sumacc_clear\n");
+      exit (1);
+    }
+  mpfr_sumacc_clear (acc);
+
+  mpfr_clears (x, r, (mpfr_ptr) 0);
+}
+
+/* Merge of accumulators: the terms are split between two accumulators,
+   and the second one is merged into the first one. */
+static void
+check_merge (void)
+{
+  mpfr_t x[N], r1, r2;
+  mpfr_ptr tab[N];
+  mpfr_sumacc_t acc1, acc2;
+  int i, k, n, m, inex1, inex2;
+
+  mpfr_inits2 (40, r1, r2, (mpfr_ptr) 0);
+  for (i = 0; i < N; i++)
+    tab[i] = x[i];
+
+  for (k = 0; k < 200; k++)
+    {
+      n = randlimb () % (N + 1);
+      m = randlimb () % (n + 1);
+      for (i = 0; i < n; i++)
+        {
+          mpfr_init2 (x[i], MPFR_PREC_MIN + randlimb () % 200);
+          random_term (x[i], k % 2 ? 10 : 10000, k % 3 == 0 ? 10 : 0);
+        }
+      if (k % 4 == 0)
+        for (i = m; i < n && i - m < m; i++)
+          {
+            mpfr_set_prec (x[i], mpfr_get_prec (x[i - m]));
+            mpfr_neg (x[i], x[i - m], MPFR_RNDN);
+          }
+      mpfr_sumacc_init (acc1);
+      mpfr_sumacc_init (acc2);
+      mpfr_sumacc_add_array (acc1, tab, m);
+      mpfr_sumacc_add_array (acc2, tab + m, n - m);
+      mpfr_sumacc_merge (acc1, acc2);
+      inex1 = mpfr_sum (r1, tab, n, MPFR_RNDN);
+      inex2 = mpfr_sumacc_get (r2, acc1, MPFR_RNDN);
+      if (! SAME_VAL (r1, r2) || ! SAME_SIGN (inex1, inex2))
+        {
+          printf ("Error in check_merge, n = %d, m = %d\n", n, m);
+          printf ("expected "); mpfr_dump (r1);
+          printf ("got      "); mpfr_dump (r2);
+          exit (1);
+        }
+      mpfr_sumacc_clear (acc1);
+      mpfr_sumacc_clear (acc2);
+      for (i = 0; i < n; i++)
+        mpfr_clear (x[i]);
+    }
+
+  mpfr_clears (r1, r2, (mpfr_ptr) 0);
+}
+
+/* Many terms in a bounded exponent range: the memory used by the
+   accumulator must not depend on the number of terms. The sum of the
+   integers 1 to n is exact. */
+static void
+check_stream (void)
+{
+  mpfr_sumacc_t acc;
+  mpfr_t x, r;
+  unsigned long i, n = 100000;
+  int inex;
+
+  mpfr_init2 (x, 64);
+  mpfr_init2 (r, 64);
+  mpfr_sumacc_init (acc);
+  for (i = 1; i <= n; i++)
+    {
+      mpfr_set_ui (x, i, MPFR_RNDN);
+      mpfr_sumacc_add (acc, x);
+      if (acc->_mpfr_nblk != 1)
+        {
+          printf ("Error in check_stream, %d blocks for i = %lu\n",
+                  acc->_mpfr_nblk, i);
+          exit (1);
+        }
+    }
+  inex = mpfr_sumacc_get (r, acc, MPFR_RNDN);
+  if (mpfr_cmp_ui (r, n * (n + 1) / 2) != 0 || inex != 0)
+    {
+      printf ("Error in check_stream\n");
+      exit (1);
+    }
+  mpfr_sumacc_clear (acc);
+  mpfr_clears (x, r, (mpfr_ptr) 0);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_special ();
+  check_stream ();
+  check_random ();
+  check_range ();
+  check_merge ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,256 @@
+/* Test file for mpfr_tune_set, mpfr_tune_get, mpfr_tune_load and
+   mpfr_tune_reset.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define FILE_NAME "ttune.dat"
+
+static long
+get (const char *name, unsigned long i)
+{
+  long v;
+
+  if (mpfr_tune_get (name, i, &v))
+    {
+      printf ("Error, mpfr_tune_get fails for %s[%lu]\n", name, i);
+      exit (1);
+    }
+  return v;
+}
+
+static void
+set (const char *name, unsigned long i, long v, int ok)
+{
+  long w;
+
+  if ((mpfr_tune_set (name, i, v) == 0) != ok)
+    {
+      printf ("Error, mpfr_tune_set %s for %s[%lu] = %ld\n",
+              ok ? "fails" : "does not fail", name, i, v);
+      exit (1);
+    }
+  if (ok && (w = get (name, i)) != v)
+    {
+      printf ("Error, got %ld instead of %ld for %s[%lu]\n", w, v, name, i);
+      exit (1);
+    }
+}
+
+static void
+check_set_get (void)
+{
+  long v, size;
+
+  set ("MPFR_MUL_THRESHOLD", 0, 1, 1);
+  set ("MPFR_MUL_THRESHOLD", 0, 0, 0);
+  set ("MPFR_MUL_THRESHOLD", 1, 10, 0);
+  set ("MPFR_SQR_THRESHOLD", 0, 1000, 1);
+  set ("MPFR_DIV_THRESHOLD", 0, 0, 1);
+  set ("MPFR_MULHIGH_FULL_THRESHOLD", 0, 0, 0);
+  set ("MPFR_MULHIGH_FULL_THRESHOLD", 0, 5000, 1);
+  set ("MPFR_SQRHIGH_FULL_THRESHOLD", 0, 1, 1);
+  set ("MPFR_EXP_2_THRESHOLD", 0, -1, 0);
+  set ("MPFR_EXP_THRESHOLD", 0, 12345, 1);
+  set ("MPFR_SINCOS_THRESHOLD", 0, 54321, 1);
+  set ("MPFR_AI_THRESHOLD1", 0, -1000, 1);
+  set ("MPFR_FOO_THRESHOLD", 0, 1, 0);
+  set ("MPFR_EXP", 0, 1, 0);
+  set ("MPFR_MUL_THRESHOLD_SIZE", 0, 1, 0);
+
+  /* tables: -1 (mulhigh and sqrhigh only), 0, or (n+4)/2 <= k < n
+     (k < n - 1 for divhigh) */
+  set ("MPFR_MULHIGH_TAB", 7, -1, 1);
+  set ("MPFR_MULHIGH_TAB", 7, 5, 1);
+  set ("MPFR_MULHIGH_TAB", 7, 4, 0);
+  set ("MPFR_MULHIGH_TAB", 7, 7, 0);
+  set ("MPFR_SQRHIGH_TAB", 2, 0, 1);
+  set ("MPFR_SQRHIGH_TAB", 2, -2, 0);
+  set ("MPFR_DIVHIGH_TAB", 14, 9, 1);
+  set ("MPFR_DIVHIGH_TAB", 14, 13, 0);
+  set ("MPFR_DIVHIGH_TAB", 14, -1, 0);
+
+  /* the sizes */
+  set ("MPFR_MULHIGH_TAB_SIZE", 0, 7, 0);
+  set ("MPFR_SQRHIGH_TAB_SIZE", 0, 2, 0);
+  set ("MPFR_DIVHIGH_TAB_SIZE", 0, 14, 0);
+  set ("MPFR_DIVHIGH_TAB_SIZE", 0, 100000, 0);
+  set ("MPFR_MULHIGH_TAB_SIZE", 0, 8, 1);
+  set ("MPFR_MULHIGH_TAB", 8, 0, 0);
+  if (mpfr_tune_get ("MPFR_MULHIGH_TAB", 8, &v) == 0)
+    {
+      printf ("Error, mpfr_tune_get does not fail after the table\n");
+      exit (1);
+    }
+  /* the new entries are the values used after the table */
+  set ("MPFR_MULHIGH_TAB_SIZE", 0, 100, 1);
+  if (get ("MPFR_MULHIGH_TAB", 99) != 3 * (99 / 4))
+    {
+      printf ("Error, wrong new entry in MPFR_MULHIGH_TAB\n");
+      exit (1);
+    }
+  size = get ("MPFR_DIVHIGH_TAB_SIZE", 0);
+  set ("MPFR_DIVHIGH_TAB_SIZE", 0, 20, 1);
+  set ("MPFR_DIVHIGH_TAB_SIZE", 0, 30, 1);
+  if (get ("MPFR_DIVHIGH_TAB", 29) != 2 * (29 / 3))
+    {
+      printf ("Error, wrong new entry in MPFR_DIVHIGH_TAB\n");
+      exit (1);
+    }
+
+  mpfr_tune_reset ();
+  if (get ("MPFR_MUL_THRESHOLD", 0) != MPFR_MUL_THRESHOLD ||
+      get ("MPFR_DIVHIGH_TAB_SIZE", 0) != size)
+    {
+      printf ("Error, mpfr_tune_reset does not restore the values\n");
+      exit (1);
+    }
+}
+
+static void
+check_load (void)
+{
+  FILE *f;
+  int i;
+
+  /* a file with an invalid entry changes nothing */
+  f = fopen (FILE_NAME, "w");
+  MPFR_ASSERTN (f != NULL);
+  fprintf (f, "MPFR_EXP_THRESHOLD 777\nMPFR_MUL_THRESHOLD 0\n");
+  fclose (f);
+  if (mpfr_tune_load (FILE_NAME) == 0 ||
+      get ("MPFR_EXP_THRESHOLD", 0) == 777)
+    {
+      printf ("Error, invalid file accepted by mpfr_tune_load\n");
+      exit (1);
+    }
+
+  f = fopen (FILE_NAME, "w");
+  MPFR_ASSERTN (f != NULL);
+  fprintf (f, "# test file\n\nMPFR_EXP_THRESHOLD 777 # bits\n");
+  fprintf (f, "MPFR_AI_THRESHOLD3  -5\nMPFR_SQRHIGH_TAB\n");
+  for (i = 0; i < 40; i++)
+    fprintf (f, "%d%c", i < 16 ? -1 : (i + 4) / 2,
+             i % 16 == 15 ? '\n' : ' ');
+  fprintf (f, "\nMPFR_DIV_THRESHOLD 3\n");
+  fclose (f);
+  if (mpfr_tune_load (FILE_NAME))
+    {
+      printf ("Error, mpfr_tune_load fails\n");
+      exit (1);
+    }
+  if (get ("MPFR_EXP_THRESHOLD", 0) != 777 ||
+      get ("MPFR_AI_THRESHOLD3", 0) != -5 ||
+      get ("MPFR_DIV_THRESHOLD", 0) != 3 ||
+      get ("MPFR_SQRHIGH_TAB_SIZE", 0) != 40 ||
+      get ("MPFR_SQRHIGH_TAB", 15) != -1 ||
+      get ("MPFR_SQRHIGH_TAB", 39) != 21 ||
+      get ("MPFR_MUL_THRESHOLD", 0) != MPFR_MUL_THRESHOLD)
+    {
+      printf ("Error, wrong values after mpfr_tune_load\n");
+      exit (1);
+    }
+  mpfr_tune_reset ();
+
+  if (mpfr_tune_load ("/nonexistent/" FILE_NAME) == 0)
+    {
+      printf ("Error, mpfr_tune_load does not fail on a missing file\n");
+      exit (1);
+    }
+  remove (FILE_NAME);
+}
+
+/* The results must not depend on the tuning parameters. */
+static void
+check_results (void)
+{
+  mpfr_t x, y, z, r[2][4];
+  int inex[2][4];
+  mpfr_prec_t p;
+  int i, k;
+  long n;
+
+  for (p = 1000; p <= 5000; p += 1000)
+    {
+      mpfr_inits2 (p, x, y, z, (mpfr_ptr) 0);
+      for (k = 0; k < 4; k++)
+        mpfr_inits2 (p, r[0][k], r[1][k], (mpfr_ptr) 0);
+      mpfr_urandomb (x, RANDS);
+      mpfr_urandomb (y, RANDS);
+      mpfr_urandomb (z, RANDS);
+
+      for (i = 0; i < 2; i++)
+        {
+          if (i == 1)
+            {
+              /* the other algorithms, and full products for the short
+                 products */
+              set ("MPFR_MUL_THRESHOLD", 0, 1, 1);
+              set ("MPFR_SQR_THRESHOLD", 0, 1, 1);
+              set ("MPFR_DIV_THRESHOLD", 0, 1, 1);
+              set ("MPFR_EXP_2_THRESHOLD", 0, 0, 1);
+              set ("MPFR_EXP_THRESHOLD", 0, 1, 1);
+              set ("MPFR_SINCOS_THRESHOLD", 0, 1, 1);
+              n = get ("MPFR_MULHIGH_TAB_SIZE", 0);
+              while (n-- > 0)
+                set ("MPFR_MULHIGH_TAB", n, -1, 1);
+              set ("MPFR_MULHIGH_FULL_THRESHOLD", 0, 1, 1);
+              set ("MPFR_SQRHIGH_FULL_THRESHOLD", 0, 1, 1);
+              n = get ("MPFR_DIVHIGH_TAB_SIZE", 0);
+              while (n-- > 0)
+                set ("MPFR_DIVHIGH_TAB", n, 0, 1);
+            }
+          inex[i][0] = mpfr_mul (r[i][0], x, y, MPFR_RNDN);
+          inex[i][1] = mpfr_div (r[i][1], x, y, MPFR_RNDN);
+          inex[i][2] = mpfr_exp (r[i][2], z, MPFR_RNDN);
+          inex[i][3] = mpfr_sin (r[i][3], z, MPFR_RNDN);
+        }
+      mpfr_tune_reset ();
+
+      for (k = 0; k < 4; k++)
+        if (! mpfr_equal_p (r[0][k], r[1][k]) ||
+            ! SAME_SIGN (inex[0][k], inex[1][k]))
+          {
+            printf ("Error, different results for function %d, p = %ld\n",
+                    k, (long) p);
+            printf ("default: "); mpfr_dump (r[0][k]);
+            printf ("changed: "); mpfr_dump (r[1][k]);
+            exit (1);
+          }
+
+      mpfr_clears (x, y, z, (mpfr_ptr) 0);
+      for (k = 0; k < 4; k++)
+        mpfr_clears (r[0][k], r[1][k], (mpfr_ptr) 0);
+    }
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_set_get ();
+  check_load ();
+  check_results ();
+
+  tests_end_mpfr ();
+  return 0;
+}
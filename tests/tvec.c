@@ -0,0 +1,405 @@
+/* Test file for the vector forms of the basic operations
+   (mpfr_add_vec, mpfr_sub_vec, mpfr_mul_vec and mpfr_div_vec)
+   and for the mpfr_vec_t type.
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "mpfr-test.h"
+
+#define N 40
+
+typedef int (*scalar_f) (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+typedef void (*vector_f) (int *, const mpfr_ptr *, const mpfr_ptr *,
+                          const mpfr_ptr *, unsigned long, mpfr_rnd_t);
+
+static struct
+{
+  const char *name;
+  scalar_f sf;
+  vector_f vf;
+} ops[] = {
+  { "mpfr_add_vec", mpfr_add, mpfr_add_vec },
+  { "mpfr_sub_vec", mpfr_sub, mpfr_sub_vec },
+  { "mpfr_mul_vec", mpfr_mul, mpfr_mul_vec },
+  { "mpfr_div_vec", mpfr_div, mpfr_div_vec }
+};
+
+/* Set x to a random value, singular from time to time, and with an
+   exponent in [-e,e]. */
+static void
+random_value (mpfr_ptr x, mpfr_exp_t e)
+{
+  switch (randlimb () % 16)
+    {
+    case 0:
+      mpfr_set_nan (x);
+      break;
+    case 1:
+      mpfr_set_inf (x, RAND_BOOL () ? 1 : -1);
+      break;
+    case 2:
+      mpfr_set_zero (x, RAND_BOOL () ? 1 : -1);
+      break;
+    default:
+      mpfr_urandomb (x, RANDS);
+      if (MPFR_IS_ZERO (x))
+        mpfr_set_ui (x, 1, MPFR_RNDN);
+      mpfr_set_exp (x, (mpfr_exp_t) (randlimb () % (2 * e + 1)) - e);
+      if (RAND_BOOL ())
+        mpfr_neg (x, x, MPFR_RNDN);
+    }
+}
+
+/* Compare the vector form of ops[k] with the scalar function on N random
+   inputs of precision p (with a few elements of a different precision
+   when mixed is non-zero). If reuse is non-zero, the result is stored in
+   the first input. */
+static void
+check_op (int k, mpfr_prec_t p, int mixed, int reuse, mpfr_exp_t e)
+{
+  mpfr_t r[N], a[N], b[N], s[N];
+  mpfr_ptr rp[N], ap[N], bp[N];
+  int inex[N], sinex[N];
+  mpfr_flags_t flags, sflags;
+  int i, rnd;
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_prec_t q = mixed && i != 0 && randlimb () % 4 == 0 ?
+        MPFR_PREC_MIN + randlimb () % (3 * GMP_NUMB_BITS) : p;
+
+      mpfr_inits2 (q, r[i], a[i], b[i], s[i], (mpfr_ptr) 0);
+      rp[i] = reuse ? a[i] : r[i];
+      ap[i] = a[i];
+      bp[i] = b[i];
+    }
+
+  RND_LOOP_NO_RNDF (rnd)
+    {
+      for (i = 0; i < N; i++)
+        {
+          random_value (a[i], e);
+          random_value (b[i], e);
+        }
+
+      /* scalar reference */
+      mpfr_clear_flags ();
+      for (i = 0; i < N; i++)
+        sinex[i] = ops[k].sf (s[i], a[i], b[i], (mpfr_rnd_t) rnd);
+      sflags = __gmpfr_flags;
+
+      mpfr_clear_flags ();
+      ops[k].vf (inex, rp, ap, bp, N, (mpfr_rnd_t) rnd);
+      flags = __gmpfr_flags;
+
+      for (i = 0; i < N; i++)
+        if (! SAME_VAL (rp[i], s[i]) || ! SAME_SIGN (inex[i], sinex[i]))
+          {
+            printf ("Error in %s for %s, p = %lu, i = %d\n", ops[k].name,
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) rnd),
+                    (unsigned long) p, i);
+            printf ("expected "); mpfr_dump (s[i]);
+            printf ("got      "); mpfr_dump (rp[i]);
+            printf ("ternary: expected %d, got %d\n", sinex[i], inex[i]);
+            exit (1);
+          }
+      if (flags != sflags)
+        {
+          printf ("Flags error in %s for %s, p = %lu\n", ops[k].name,
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), (unsigned long) p);
+          printf ("expected flags:");
+          flags_out (sflags);
+          printf ("got flags:     ");
+          flags_out (flags);
+          exit (1);
+        }
+    }
+
+  for (i = 0; i < N; i++)
+    mpfr_clears (r[i], a[i], b[i], s[i], (mpfr_ptr) 0);
+}
+
+/* Compare mpfr_fma_vec (fmma = 0) or mpfr_fmma_vec (fmma = 1) with the
+   scalar function on N random inputs, as in check_op. If reuse is non-zero,
+   the result is stored in the last input. Some elements have the same
+   first two inputs, so that the squaring code is also exercised, and for
+   mpfr_fmma_vec, some elements have c*d equal to -a*b or close to it, so
+   that the products cancel. */
+static void
+check_fused (int fmma, mpfr_prec_t p, int mixed, int reuse, mpfr_exp_t e)
+{
+  mpfr_t r[N], a[N], b[N], c[N], d[N], s[N];
+  mpfr_ptr rp[N], ap[N], bp[N], cp[N], dp[N];
+  int inex[N], sinex[N];
+  mpfr_flags_t flags, sflags;
+  const char *name = fmma ? "mpfr_fmma_vec" : "mpfr_fma_vec";
+  int i, rnd;
+
+  for (i = 0; i < N; i++)
+    {
+      mpfr_prec_t q = mixed && i != 0 && randlimb () % 4 == 0 ?
+        MPFR_PREC_MIN + randlimb () % (3 * GMP_NUMB_BITS) : p;
+
+      mpfr_inits2 (q, r[i], a[i], b[i], c[i], d[i], s[i], (mpfr_ptr) 0);
+      ap[i] = a[i];
+      bp[i] = randlimb () % 8 == 0 ? a[i] : b[i];
+      cp[i] = c[i];
+      dp[i] = d[i];
+      rp[i] = ! reuse ? r[i] : fmma ? d[i] : c[i];
+    }
+
+  RND_LOOP_NO_RNDF (rnd)
+    {
+      for (i = 0; i < N; i++)
+        {
+          random_value (a[i], e);
+          random_value (b[i], e);
+          random_value (c[i], 2 * e);
+          random_value (d[i], e);
+          if (fmma && randlimb () % 8 == 0)
+            {
+              mpfr_neg (c[i], a[i], MPFR_RNDN);
+              mpfr_set (d[i], bp[i], MPFR_RNDN);
+              if (RAND_BOOL ())
+                mpfr_nextabove (d[i]);
+            }
+        }
+
+      /* scalar reference */
+      mpfr_clear_flags ();
+      for (i = 0; i < N; i++)
+        sinex[i] = fmma ?
+          mpfr_fmma (s[i], ap[i], bp[i], cp[i], dp[i], (mpfr_rnd_t) rnd) :
+          mpfr_fma (s[i], ap[i], bp[i], cp[i], (mpfr_rnd_t) rnd);
+      sflags = __gmpfr_flags;
+
+      mpfr_clear_flags ();
+      if (fmma)
+        mpfr_fmma_vec (inex, rp, ap, bp, cp, dp, N, (mpfr_rnd_t) rnd);
+      else
+        mpfr_fma_vec (inex, rp, ap, bp, cp, N, (mpfr_rnd_t) rnd);
+      flags = __gmpfr_flags;
+
+      for (i = 0; i < N; i++)
+        if (! SAME_VAL (rp[i], s[i]) || ! SAME_SIGN (inex[i], sinex[i]))
+          {
+            printf ("Error in %s for %s, p = %lu, i = %d\n", name,
+                    mpfr_print_rnd_mode ((mpfr_rnd_t) rnd),
+                    (unsigned long) p, i);
+            printf ("expected "); mpfr_dump (s[i]);
+            printf ("got      "); mpfr_dump (rp[i]);
+            printf ("ternary: expected %d, got %d\n", sinex[i], inex[i]);
+            exit (1);
+          }
+      if (flags != sflags)
+        {
+          printf ("Flags error in %s for %s, p = %lu\n", name,
+                  mpfr_print_rnd_mode ((mpfr_rnd_t) rnd), (unsigned long) p);
+          printf ("expected flags:");
+          flags_out (sflags);
+          printf ("got flags:     ");
+          flags_out (flags);
+          exit (1);
+        }
+    }
+
+  for (i = 0; i < N; i++)
+    mpfr_clears (r[i], a[i], b[i], c[i], d[i], s[i], (mpfr_ptr) 0);
+}
+
+static void
+check_random (void)
+{
+  mpfr_prec_t p;
+  int k;
+
+  for (k = 0; k < numberof (ops); k++)
+    {
+      /* all the fixed-size kernels, and the generic code */
+      for (p = MPFR_PREC_MIN; p <= 4 * GMP_NUMB_BITS + 1; p++)
+        {
+          check_op (k, p, 0, 0, 20);
+          check_op (k, p, 0, 1, 20);
+        }
+      for (p = MPFR_PREC_MIN; p <= 4 * GMP_NUMB_BITS + 1; p += 7)
+        check_op (k, p, 1, RAND_BOOL (), 20);
+      /* the kernels of 4 to 8 limbs of mpfr_mul and mpfr_div */
+      for (p = 4 * GMP_NUMB_BITS + 2; p <= 8 * GMP_NUMB_BITS + 1; p += 5)
+        check_op (k, p, RAND_BOOL (), RAND_BOOL (), 20);
+    }
+
+  for (k = 0; k < 2; k++)
+    {
+      for (p = MPFR_PREC_MIN; p <= 4 * GMP_NUMB_BITS + 1; p++)
+        {
+          check_fused (k, p, 0, 0, 20);
+          check_fused (k, p, 0, 1, 20);
+        }
+      for (p = MPFR_PREC_MIN; p <= 4 * GMP_NUMB_BITS + 1; p += 7)
+        check_fused (k, p, 1, RAND_BOOL (), 20);
+      check_fused (k, 1000, 0, 0, 20);
+    }
+}
+
+/* Overflows and underflows in a reduced exponent range. */
+static void
+check_range (void)
+{
+  mpfr_exp_t emin, emax;
+  mpfr_prec_t p;
+  int k;
+
+  emin = mpfr_get_emin ();
+  emax = mpfr_get_emax ();
+  set_emin (-16);
+  set_emax (16);
+
+  for (k = 0; k < numberof (ops); k++)
+    for (p = MPFR_PREC_MIN; p <= 8 * GMP_NUMB_BITS + 1;
+         p += p <= 3 * GMP_NUMB_BITS ? 3 : 13)
+      check_op (k, p, 0, 0, 16);
+  for (k = 0; k < 2; k++)
+    for (p = MPFR_PREC_MIN; p <= 3 * GMP_NUMB_BITS + 1; p += 3)
+      check_fused (k, p, 0, RAND_BOOL (), 8);
+
+  set_emin (emin);
+  set_emax (emax);
+}
+
+static void
+check_zero_size (void)
+{
+  mpfr_ptr p[1] = { NULL };
+  int inex[1] = { 17 };
+  int k;
+
+  mpfr_clear_flags ();
+  for (k = 0; k < numberof (ops); k++)
+    ops[k].vf (inex, p, p, p, 0, MPFR_RNDN);
+  mpfr_fma_vec (inex, p, p, p, p, 0, MPFR_RNDN);
+  mpfr_fmma_vec (inex, p, p, p, p, p, 0, MPFR_RNDN);
+  if (inex[0] != 17 || __gmpfr_flags != 0)
+    {
+      printf ("Error for n = 0\n");
+      exit (1);
+    }
+}
+
+/* Check the mpfr_vec_t type: contiguity of the significands, use of the
+   elements as ordinary variables and with the functions taking an array
+   of pointers, and the function versions of the accessors. */
+static void
+check_vec_type (void)
+{
+  mpfr_vec_t u, v, w;
+  mpfr_t s;
+  mpfr_prec_t p;
+  unsigned long i, n = 100;
+  int inex[100];
+
+  for (p = 16; p <= 3 * GMP_NUMB_BITS + 16; p += 17)
+    {
+      mpfr_vec_init2 (u, n, p);
+      mpfr_vec_init2 (v, n, p);
+      mpfr_vec_init2 (w, n, p);
+      mpfr_init2 (s, p);
+
+      if (mpfr_vec_size (u) != n || (mpfr_vec_size) (u) != n ||
+          mpfr_vec_get_prec (u) != p || (mpfr_vec_get_prec) (u) != p)
+        {
+          printf ("Error in mpfr_vec_size or mpfr_vec_get_prec\n");
+          exit (1);
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          mpfr_ptr x = mpfr_vec_get (u, i);
+
+          if (x != (mpfr_vec_get) (u, i) || x != mpfr_vec_ptrs (u)[i] ||
+              x != (mpfr_vec_ptrs) (u)[i])
+            {
+              printf ("Error in mpfr_vec_get or mpfr_vec_ptrs\n");
+              exit (1);
+            }
+          if (! mpfr_nan_p (x) || mpfr_get_prec (x) != p)
+            {
+              printf ("Error in mpfr_vec_init2 for i = %lu\n", i);
+              exit (1);
+            }
+          if (i > 0 && (mp_limb_t *) mpfr_custom_get_significand (x) !=
+              (mp_limb_t *) mpfr_custom_get_significand
+              (mpfr_vec_get (u, i - 1)) + MPFR_PREC2LIMBS (p))
+            {
+              printf ("Error, significands are not contiguous\n");
+              exit (1);
+            }
+          mpfr_set_ui (x, i + 1, MPFR_RNDN);
+          mpfr_set_ui (mpfr_vec_get (v, i), 2 * i + 1, MPFR_RNDN);
+        }
+
+      mpfr_add_vec (inex, mpfr_vec_ptrs (w), mpfr_vec_ptrs (u),
+                    mpfr_vec_ptrs (v), n, MPFR_RNDN);
+      for (i = 0; i < n; i++)
+        {
+          mpfr_set_ui (s, 3 * i + 2, MPFR_RNDN);
+          if (! mpfr_equal_p (s, mpfr_vec_get (w, i)))
+            {
+              printf ("Error in mpfr_add_vec on mpfr_vec_t, p = %lu,"
+                      " i = %lu\n", (unsigned long) p, i);
+              exit (1);
+            }
+        }
+
+      mpfr_sum (s, mpfr_vec_ptrs (u), n, MPFR_RNDZ);
+      if (mpfr_cmp_ui (s, n * (n + 1) / 2) != 0)
+        {
+          printf ("Error in mpfr_sum on mpfr_vec_t, p = %lu\n",
+                  (unsigned long) p);
+          exit (1);
+        }
+
+      mpfr_vec_clear (u);
+      mpfr_vec_clear (v);
+      mpfr_vec_clear (w);
+      mpfr_clear (s);
+    }
+
+  mpfr_vec_init2 (u, 0, 17);
+  if (mpfr_vec_size (u) != 0)
+    {
+      printf ("Error for an empty vector\n");
+      exit (1);
+    }
+  mpfr_vec_clear (u);
+}
+
+int
+main (void)
+{
+  tests_start_mpfr ();
+
+  check_zero_size ();
+  check_random ();
+  check_range ();
+  check_vec_type ();
+
+  tests_end_mpfr ();
+  return 0;
+}
@@ -0,0 +1,99 @@
+/* constbench.c -- timings of the constants for 1 to N threads
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Usage: constbench [prec [maxthreads]]
+   Compute log(2), Euler's constant and Catalan's constant in precision
+   prec with 1 to maxthreads threads (see mpfr_set_const_nthreads), and
+   output the elapsed (wall-clock) times and the speedups. The caches are
+   freed before each computation. The results must be identical. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* elapsed time in microseconds (the CPU time would be the sum over all
+   the threads) */
+static double
+get_walltime (void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec * 1e6 + tv.tv_usec;
+#else
+  return (double) time (NULL) * 1e6;
+#endif
+}
+
+static struct {
+  const char *name;
+  int (*f) (mpfr_ptr, mpfr_rnd_t);
+} tab[] = {
+  { "log2", mpfr_const_log2 },
+  { "euler", mpfr_const_euler },
+  { "catalan", mpfr_const_catalan }
+};
+
+int
+main (int argc, char *argv[])
+{
+  mpfr_prec_t prec = argc > 1 ? atol (argv[1]) : 10000000;
+  unsigned int maxthreads = argc > 2 ? atoi (argv[2]) : 8;
+  unsigned int i, k;
+  mpfr_t x1, x;
+  double t, t1 = 0;
+
+  printf ("GMP: %s  MPFR: %s  parallel: %s\n", gmp_version,
+          mpfr_get_version (), mpfr_buildopt_parallel_p () ? "yes" : "no");
+  printf ("precision = %ld\n", (long) prec);
+
+  mpfr_init2 (x1, prec);
+  mpfr_init2 (x, prec);
+  for (i = 0; i < sizeof (tab) / sizeof (tab[0]); i++)
+    for (k = 1; k <= maxthreads; k++)
+      {
+        mpfr_free_cache ();
+        mpfr_set_const_nthreads (k);
+        t = get_walltime ();
+        tab[i].f (k == 1 ? x1 : x, MPFR_RNDN);
+        t = get_walltime () - t;
+        if (k == 1)
+          t1 = t;
+        printf ("%-8s %2u: %12.0f us  speedup %5.2f\n",
+                tab[i].name, k, t, t1 / t);
+        if (k > 1 && ! mpfr_equal_p (x, x1))
+          {
+            printf ("Error: different results for %u threads\n", k);
+            exit (1);
+          }
+      }
+
+  mpfr_clear (x1);
+  mpfr_clear (x);
+  mpfr_free_cache ();
+  return 0;
+}
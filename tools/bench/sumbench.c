@@ -0,0 +1,113 @@
+/* sumbench.c -- timings of mpfr_sum_parallel for 1 to N threads
+
+Copyright 2026 Free Software Foundation, Inc.
+Contributed by the Pascaline and Caramba projects, INRIA.
+
+This file is part of the GNU MPFR Library.
+
+The GNU MPFR Library is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 3 of the License, or (at your
+option) any later version.
+
+The GNU MPFR Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the GNU MPFR Library; see the file COPYING.LESSER.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/* Usage: sumbench [n [prec [maxthreads]]]
+   Sum n random numbers of precision prec (with exponents in [-100,100]
+   and random signs) with mpfr_sum, then with mpfr_sum_parallel for 1 to
+   maxthreads threads, and output the elapsed (wall-clock) times and the
+   speedups. The results must be identical. */
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+#include "mpfr.h"
+
+/* elapsed time in microseconds (the CPU time would be the sum over all
+   the threads) */
+static double
+get_walltime (void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+  return tv.tv_sec * 1e6 + tv.tv_usec;
+#else
+  return (double) time (NULL) * 1e6;
+#endif
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long n = argc > 1 ? strtoul (argv[1], NULL, 10) : 10000000;
+  mpfr_prec_t prec = argc > 2 ? atol (argv[2]) : 53;
+  unsigned int maxthreads = argc > 3 ? atoi (argv[3]) : 8;
+  unsigned int k;
+  unsigned long i;
+  gmp_randstate_t state;
+  mpfr_vec_t v;
+  mpfr_t s0, s;
+  double t, t0, t1 = 0;
+  int inex0, inex;
+
+  printf ("GMP: %s  MPFR: %s  parallel: %s\n", gmp_version,
+          mpfr_get_version (), mpfr_buildopt_parallel_p () ? "yes" : "no");
+  printf ("n = %lu, precision = %ld\n", n, (long) prec);
+
+  gmp_randinit_default (state);
+  mpfr_vec_init2 (v, n, prec);
+  for (i = 0; i < n; i++)
+    {
+      mpfr_ptr x = mpfr_vec_get (v, i);
+
+      mpfr_urandomb (x, state);
+      mpfr_mul_2si (x, x, (long) (gmp_urandomm_ui (state, 201)) - 100,
+                    MPFR_RNDN);
+      if (gmp_urandomb_ui (state, 1))
+        mpfr_neg (x, x, MPFR_RNDN);
+    }
+  mpfr_init2 (s0, prec);
+  mpfr_init2 (s, prec);
+
+  t = get_walltime ();
+  inex0 = mpfr_sum (s0, mpfr_vec_ptrs (v), n, MPFR_RNDN);
+  t0 = get_walltime () - t;
+  printf ("mpfr_sum:              %10.0f us\n", t0);
+
+  for (k = 1; k <= maxthreads; k++)
+    {
+      t = get_walltime ();
+      inex = mpfr_sum_parallel (s, mpfr_vec_ptrs (v), n, k, MPFR_RNDN);
+      t = get_walltime () - t;
+      if (k == 1)
+        t1 = t;
+      printf ("mpfr_sum_parallel, %2u: %10.0f us  speedup %5.2f\n",
+              k, t, t1 / t);
+      if (! mpfr_equal_p (s, s0) || (inex > 0) != (inex0 > 0)
+          || (inex < 0) != (inex0 < 0))
+        {
+          printf ("Error: different results for %u threads\n", k);
+          exit (1);
+        }
+    }
+
+  mpfr_clear (s0);
+  mpfr_clear (s);
+  mpfr_vec_clear (v);
+  gmp_randclear (state);
+  mpfr_free_cache ();
+  return 0;
+}
@@ -23,6 +23,8 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <time.h>
 
 #define MPFR_NEED_LONGLONG_H
+/* the default values of the tuning parameters are used below */
+#define MPFR_TUNE_DONT_REDEFINE
 #include "mpfr-impl.h"
 
 #undef _PROTO
@@ -20,9 +20,13 @@ along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #define MPFR_NEED_LONGLONG_H
+/* the tuning parameters are the current ones (see thresholds.c), as in
+   the library, so that mpfr_div_divrem below can be compared with
+   mpfr_div after mpfr_tune_set */
 #include "mpfr-impl.h"
 
 /* extracted from mulders.c */
@@ -119,12 +123,100 @@ int verbose;
 /* First we include all the functions we want to tune inside this program.
    We can't use GNU MPFR library since the THRESHOLD can't vary */
 
-/* Setup mpfr_mul */
-mpfr_prec_t mpfr_mul_threshold = MPFR_MUL_THRESHOLD;
+/* Setup mpfr_mul (mpfr_mul_threshold is set by all) */
+mpfr_prec_t mpfr_mul_threshold;
 static double speed_mpfr_mul (struct speed_params *s) {
   SPEED_MPFR_OP (mpfr_mul);
 }
 
+/* Setup mpfr_add1sp and mpfr_sub1sp with the portable carry propagation
+   (MPFR_ADDC_GENERIC and MPFR_SUBB_GENERIC), to be compared with those of
+   the library, which use the carry intrinsics when they are available.
+   The exponent of the second operand is -carry_d. */
+#undef MPFR_ADDC
+#undef MPFR_SUBB
+#define MPFR_ADDC MPFR_ADDC_GENERIC
+#define MPFR_SUBB MPFR_SUBB_GENERIC
+#define mpfr_add1sp mpfr_add1sp_generic
+#define mpfr_sub1sp mpfr_sub1sp_generic
+int mpfr_add1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+int mpfr_sub1sp (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+#include "add1sp.c"
+#include "sub1sp.c"
+#undef mpfr_add1sp
+#undef mpfr_sub1sp
+
+static mpfr_exp_t carry_d;
+
+#define SPEED_MPFR_OP_D(mean_fun) do {               \
+  unsigned  i;                                       \
+  mpfr_limb_ptr wp;                                  \
+  double    t;                                       \
+  mpfr_t    w, x, y;                                 \
+  mp_size_t size;                                    \
+  MPFR_TMP_DECL (marker);                            \
+                                                     \
+  MPFR_TMP_MARK (marker);                            \
+  size = (s->size-1)/GMP_NUMB_BITS+1;                \
+  s->xp[size-1] |= MPFR_LIMB_HIGHBIT;                \
+  MPFR_TMP_INIT1 (s->xp, x, s->size);                \
+  MPFR_SET_EXP (x, 0);                               \
+  s->yp[size-1] |= MPFR_LIMB_HIGHBIT;                \
+  MPFR_TMP_INIT1 (s->yp, y, s->size);                \
+  MPFR_SET_EXP (y, -carry_d);                        \
+  MPFR_TMP_INIT (wp, w, s->size, size);              \
+  MPFR_SET_POS (w);                                  \
+                                                     \
+  speed_operand_src (s, s->xp, size);                \
+  speed_operand_src (s, s->yp, size);                \
+  speed_operand_dst (s, wp, size);                   \
+  speed_cache_fill (s);                              \
+                                                     \
+  speed_starttime ();                                \
+  i = s->reps;                                       \
+  do                                                 \
+    mean_fun (w, x, y, MPFR_RNDN);                   \
+  while (--i != 0);                                  \
+  t = speed_endtime ();                              \
+                                                     \
+  MPFR_TMP_FREE (marker);                            \
+  return t;                                          \
+} while (0)
+
+static double speed_mpfr_add1sp (struct speed_params *s) {
+  SPEED_MPFR_OP_D (mpfr_add1sp);
+}
+static double speed_mpfr_add1sp_generic (struct speed_params *s) {
+  SPEED_MPFR_OP_D (mpfr_add1sp_generic);
+}
+static double speed_mpfr_sub1sp (struct speed_params *s) {
+  SPEED_MPFR_OP_D (mpfr_sub1sp);
+}
+static double speed_mpfr_sub1sp_generic (struct speed_params *s) {
+  SPEED_MPFR_OP_D (mpfr_sub1sp_generic);
+}
+
+/* Setup mpfr_div without the mpn_div_q fast path (thus always with
+   mpn_divrem), to be compared with mpfr_div from the library, which uses
+   it when MPFR is configured with --enable-gmp-internals. Both use the
+   current value of MPFR_DIV_THRESHOLD. */
+#undef HAVE___GMPN_DIV_Q
+#define mpfr_div mpfr_div_divrem
+#define mpfr_div_vec mpfr_div_vec_divrem
+int mpfr_div (mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t);
+void mpfr_div_vec (int *, const mpfr_ptr *, const mpfr_ptr *,
+                   const mpfr_ptr *, unsigned long, mpfr_rnd_t);
+#include "div.c"
+#undef mpfr_div
+#undef mpfr_div_vec
+
+static double speed_mpfr_div (struct speed_params *s) {
+  SPEED_MPFR_OP (mpfr_div);
+}
+static double speed_mpfr_div_divrem (struct speed_params *s) {
+  SPEED_MPFR_OP (mpfr_div_divrem);
+}
+
 
 
 /************************************************
@@ -182,17 +274,17 @@ tune_simple_func (mpfr_prec_t *threshold,
       measure = domeasure (threshold, func, p);
       printf ("prec=%lu mpfr_mul=%e ", p, measure);
       n = 1 + (p - 1) / GMP_NUMB_BITS;
-      if (n <= MPFR_MUL_THRESHOLD)
-        k = MUL_FFT_THRESHOLD + 1;
+      if (n <= MPFR_MUL_THRESHOLD || n > MPFR_MULHIGH_FULL_THRESHOLD)
+        k = n; /* full product */
       else if (n < MPFR_MULHIGH_TAB_SIZE)
         k = mulhigh_ktab[n];
       else
-        k = 2*n/3;
+        k = 3*(n/4);
       if (k < 0)
         printf ("[mpn_mul_basecase]\n");
       else if (k == 0)
         printf ("[mpfr_mulhigh_n_basecase]\n");
-      else if (k > MUL_FFT_THRESHOLD)
+      else if (k >= n)
         printf ("[mpn_mul_n]\n");
       else
         printf ("[mpfr_mulhigh_n]\n");
@@ -200,6 +292,53 @@ tune_simple_func (mpfr_prec_t *threshold,
     }
 }
 
+/* Compare mpfr_add1sp and mpfr_sub1sp with their versions using the
+   portable carry propagation, for 2 and 3 limbs (with 64-bit limbs, this
+   is where the carry intrinsics are used). */
+static void
+compare_carry (void)
+{
+  static const mpfr_exp_t dtab[] = { 0, 1, 13, GMP_NUMB_BITS + 13 };
+  mpfr_prec_t p;
+  int i;
+
+  speed_time_init ();
+  for (i = 0; i < numberof (dtab); i++)
+    {
+      carry_d = dtab[i];
+      printf ("exponent difference %ld\n", (long) carry_d);
+      for (p = GMP_NUMB_BITS + 1; p <= 3 * GMP_NUMB_BITS; p += 7)
+        printf ("prec=%lu add1sp=%e (generic %e) sub1sp=%e (generic %e)\n",
+                p, domeasure (NULL, speed_mpfr_add1sp, p),
+                domeasure (NULL, speed_mpfr_add1sp_generic, p),
+                domeasure (NULL, speed_mpfr_sub1sp, p),
+                domeasure (NULL, speed_mpfr_sub1sp_generic, p));
+    }
+}
+
+/* Compare mpfr_div with and without the mpn_div_q fast path, from 1 to
+   10^5 limbs. Mulders' short division is disabled, so that the integer
+   division is always used (except for 1 to 8 limbs, where both use the
+   special code). */
+static void
+compare_div (void)
+{
+  mpfr_prec_t p;
+  double t1, t2;
+
+  speed_time_init ();
+  mpfr_tune_set ("MPFR_DIV_THRESHOLD", 0, MPFR_PREC_MAX);
+  for (p = GMP_NUMB_BITS; p <= 100000 * GMP_NUMB_BITS; p += p / 4)
+    {
+      t1 = domeasure (NULL, speed_mpfr_div, p - 13);
+      t2 = domeasure (NULL, speed_mpfr_div_divrem, p - 13);
+      printf ("limbs=%lu div=%e divrem=%e ratio=%.3f\n",
+              (unsigned long) ((p - 14) / GMP_NUMB_BITS + 1), t1, t2,
+              t1 / t2);
+    }
+  mpfr_tune_reset ();
+}
+
 /*******************************************************
  *            Tune all the threshold of MPFR           *
  * Warning: tune the function in their dependent order!*
@@ -250,6 +389,7 @@ all (void)
   fprintf (f, "\n");
 
   /* Tune mpfr_mul (threshold is in limbs, but it doesn't matter too much) */
+  mpfr_mul_threshold = MPFR_MUL_THRESHOLD;
   if (verbose)
     printf ("Measuring mpfr_mul with mpfr_mul_threshold=%lu...\n",
             mpfr_mul_threshold);
@@ -271,6 +411,21 @@ int main (int argc, char *argv[])
   setbuf (stdout, NULL);
   setbuf (stderr, NULL);
 
+  /* with -c, compare the add/sub kernels with and without the carry
+     intrinsics */
+  if (argc > 1 && strcmp (argv[1], "-c") == 0)
+    {
+      compare_carry ();
+      return 0;
+    }
+
+  /* with -d, compare mpfr_div with and without mpn_div_q */
+  if (argc > 1 && strcmp (argv[1], "-d") == 0)
+    {
+      compare_div ();
+      return 0;
+    }
+
   verbose = argc > 1;
 
   if (verbose)
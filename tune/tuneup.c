@@ -20,6 +20,7 @@ along with the GNU MPFR Library; see the file COPYING.LESSER.
 If not, see <https://www.gnu.org/licenses/>. */
 
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #define MPFR_NEED_LONGLONG_H
@@ -35,6 +36,28 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 int verbose;
 
+/* If non-zero, output the parameters in the format read by mpfr_tune_load
+   (option -r) instead of the one of mparam.h. */
+static int runtime;
+
+static void
+output_param (FILE *f, const char *name, long value, const char *comment)
+{
+  if (runtime)
+    fprintf (f, "%s %ld\n", name, value);
+  else if (comment != NULL)
+    fprintf (f, "#define %s %ld /* %s */\n", name, value, comment);
+  else
+    fprintf (f, "#define %s %ld\n", name, value);
+}
+
+/* Output the name of a table, before its values. */
+static void
+output_tab_name (FILE *f, const char *name)
+{
+  fprintf (f, runtime ? "%s\n " : "#define %s  \\\n ", name);
+}
+
 /* template for an unary function */
 /* s->size: precision of both input and output
    s->xp  : Mantissa of first input
@@ -730,6 +753,14 @@ tune_simple_func_in_some_direction (long int *threshold1,
 #define MPFR_MULHIGH_TAB_SIZE MPFR_MULHIGH_SIZE
 #define MPFR_SQRHIGH_TAB_SIZE MPFR_SQRHIGH_SIZE
 #define MPFR_DIVHIGH_TAB_SIZE MPFR_DIVHIGH_SIZE
+/* The full products are disabled while the tables are tuned. */
+#define MULDERS_FULL_MAX (16 * MULDERS_TABLE_SIZE)
+mp_size_t mpfr_mulhigh_full_threshold = MULDERS_FULL_MAX + 1;
+mp_size_t mpfr_sqrhigh_full_threshold = MULDERS_FULL_MAX + 1;
+#undef  MPFR_MULHIGH_FULL_THRESHOLD
+#define MPFR_MULHIGH_FULL_THRESHOLD mpfr_mulhigh_full_threshold
+#undef  MPFR_SQRHIGH_FULL_THRESHOLD
+#define MPFR_SQRHIGH_FULL_THRESHOLD mpfr_sqrhigh_full_threshold
 #include "mulders.c"
 
 static double
@@ -902,14 +933,14 @@ tune_mul_mulders (FILE *f)
 
   if (verbose)
     printf ("Tuning mpfr_mulhigh_n[%d]", (int) MPFR_MULHIGH_TAB_SIZE);
-  fprintf (f, "#define MPFR_MULHIGH_TAB  \\\n ");
+  output_tab_name (f, "MPFR_MULHIGH_TAB");
   for (k = 0 ; k < MPFR_MULHIGH_TAB_SIZE ; k++)
     {
       fprintf (f, "%d", (int) tune_mul_mulders_upto (k));
       if (k != MPFR_MULHIGH_TAB_SIZE-1)
-        fputc (',', f);
+        fputc (runtime ? ' ' : ',', f);
       if ((k+1) % 16 == 0)
-        fprintf (f, " \\\n ");
+        fprintf (f, runtime ? "\n " : " \\\n ");
       if (verbose)
         putchar ('.');
     }
@@ -925,14 +956,14 @@ tune_sqr_mulders (FILE *f)
 
   if (verbose)
     printf ("Tuning mpfr_sqrhigh_n[%d]", (int) MPFR_SQRHIGH_TAB_SIZE);
-  fprintf (f, "#define MPFR_SQRHIGH_TAB  \\\n ");
+  output_tab_name (f, "MPFR_SQRHIGH_TAB");
   for (k = 0 ; k < MPFR_SQRHIGH_TAB_SIZE ; k++)
     {
       fprintf (f, "%d", (int) tune_sqr_mulders_upto (k));
       if (k != MPFR_SQRHIGH_TAB_SIZE-1)
-        fputc (',', f);
+        fputc (runtime ? ' ' : ',', f);
       if ((k+1) % 16 == 0)
-        fprintf (f, " \\\n ");
+        fprintf (f, runtime ? "\n " : " \\\n ");
       if (verbose)
         putchar ('.');
     }
@@ -941,6 +972,59 @@ tune_sqr_mulders (FILE *f)
     putchar ('\n');
 }
 
+/* Tune the size above which mpfr_mulhigh_n (sqr = 0) or mpfr_sqrhigh_n
+   (sqr = 1) computes the full product, searching from the end of the
+   table. Since the timings are noisy at large sizes, the full product
+   must be faster for two consecutive sizes. */
+static void
+tune_mulders_full (FILE *f, int sqr)
+{
+  struct speed_params s;
+  mp_size_t n, first = MULDERS_FULL_MAX, *threshold;
+  speed_function_t func;
+  const char *name;
+  double t1, t2;
+  int count = 0;
+  MPFR_TMP_DECL (marker);
+
+  threshold = sqr ? &mpfr_sqrhigh_full_threshold
+    : &mpfr_mulhigh_full_threshold;
+  func = sqr ? speed_mpfr_sqrhigh : speed_mpfr_mulhigh;
+  name = sqr ? "mpfr_sqrhigh" : "mpfr_mulhigh";
+  if (verbose)
+    printf ("Tuning %s_n full product threshold...\n", name);
+
+  MPFR_TMP_MARK (marker);
+  s.align_xp = s.align_yp = s.align_wp = 64;
+  s.xp = (mp_ptr) MPFR_TMP_ALLOC (MULDERS_FULL_MAX * sizeof (mp_limb_t));
+  s.yp = (mp_ptr) MPFR_TMP_ALLOC (MULDERS_FULL_MAX * sizeof (mp_limb_t));
+  mpn_random (s.xp, MULDERS_FULL_MAX);
+  mpn_random (s.yp, MULDERS_FULL_MAX);
+
+  for (n = sqr ? MPFR_SQRHIGH_TAB_SIZE : MPFR_MULHIGH_TAB_SIZE;
+       n <= MULDERS_FULL_MAX; n += n / 8)
+    {
+      s.size = n;
+      *threshold = MULDERS_FULL_MAX + 1;
+      t1 = mpfr_speed_measure (func, &s, (char *) name);
+      *threshold = n - 1;
+      t2 = mpfr_speed_measure (func, &s, (char *) name);
+      if (verbose)
+        printf ("n=%ld Mulders=%e full=%e\n", (long) n, t1, t2);
+      if (t2 >= t1)
+        count = 0;
+      else if (++count == 1)
+        first = n;
+      else
+        break;
+    }
+  *threshold = count == 2 ? first - 1 : MULDERS_FULL_MAX;
+
+  MPFR_TMP_FREE (marker);
+  output_param (f, sqr ? "MPFR_SQRHIGH_FULL_THRESHOLD"
+                : "MPFR_MULHIGH_FULL_THRESHOLD", (long) *threshold, "limbs");
+}
+
 static void
 tune_div_mulders (FILE *f)
 {
@@ -948,13 +1032,15 @@ tune_div_mulders (FILE *f)
 
   if (verbose)
     printf ("Tuning mpfr_divhigh_n[%d]", (int) MPFR_DIVHIGH_TAB_SIZE);
-  fprintf (f, "#define MPFR_DIVHIGH_TAB  \\\n ");
+  output_tab_name (f, "MPFR_DIVHIGH_TAB");
   for (k = 0 ; k < MPFR_DIVHIGH_TAB_SIZE ; k++)
     {
       fprintf (f, "%d", (int) tune_div_mulders_upto (k));
       if (k != MPFR_DIVHIGH_TAB_SIZE - 1)
-        fputc (',', f);
-      if ((k+1) % 16 == 0)
+        fputc (runtime ? ' ' : ',', f);
+      if ((k+1) % 16 == 0 && runtime)
+        fprintf (f, "\n ");
+      else if ((k+1) % 16 == 0)
         fprintf (f, " /*%zu-%zu*/ \\\n ", (size_t) k - 15, (size_t) k);
       if (verbose)
         putchar ('.');
@@ -999,6 +1085,7 @@ all (const char *filename)
   struct tm  *tp;
   mpfr_t x1, x2, x3, tmp1, tmp2;
   mpfr_prec_t p1, p2, p3;
+  const char *cend = runtime ? "" : " */";  /* end of the first comment */
 
   f = fopen (filename, "w");
   if (f == NULL)
@@ -1024,35 +1111,39 @@ all (const char *filename)
 
   time (&start_time);
   tp = localtime (&start_time);
-  fprintf (f, "/* Generated by MPFR's tuneup.c, %d-%02d-%02d, ",
-          tp->tm_year+1900, tp->tm_mon+1, tp->tm_mday);
+  fprintf (f, "%s Generated by MPFR's tuneup.c, %d-%02d-%02d, ",
+           runtime ? "#" : "/*",
+           tp->tm_year+1900, tp->tm_mon+1, tp->tm_mday);
 
 #ifdef __INTEL_COMPILER
-  fprintf (f, "icc %d.%d.%d */\n", __INTEL_COMPILER / 100, __INTEL_COMPILER / 10 % 10,
-           __INTEL_COMPILER % 10);
+  fprintf (f, "icc %d.%d.%d%s\n", __INTEL_COMPILER / 100, __INTEL_COMPILER / 10 % 10,
+           __INTEL_COMPILER % 10, cend);
 #elif defined(__GNUC__)
 #ifdef __GNUC_PATCHLEVEL__
-  fprintf (f, "gcc %d.%d.%d */\n", __GNUC__, __GNUC_MINOR__,
-           __GNUC_PATCHLEVEL__);
+  fprintf (f, "gcc %d.%d.%d%s\n", __GNUC__, __GNUC_MINOR__,
+           __GNUC_PATCHLEVEL__, cend);
 #else
-  fprintf (f, "gcc %d.%d */\n", __GNUC__, __GNUC_MINOR__);
+  fprintf (f, "gcc %d.%d%s\n", __GNUC__, __GNUC_MINOR__, cend);
 #endif
 #elif defined (__SUNPRO_C)
-  fprintf (f, "Sun C %d.%d */\n", __SUNPRO_C / 0x100, __SUNPRO_C % 0x100);
+  fprintf (f, "Sun C %d.%d%s\n", __SUNPRO_C / 0x100, __SUNPRO_C % 0x100, cend);
 #elif defined (__sgi) && defined (_COMPILER_VERSION)
-  fprintf (f, "MIPSpro C %d.%d.%d */\n",
+  fprintf (f, "MIPSpro C %d.%d.%d%s\n",
            _COMPILER_VERSION / 100,
            _COMPILER_VERSION / 10 % 10,
-           _COMPILER_VERSION % 10);
+           _COMPILER_VERSION % 10, cend);
 #elif defined (__DECC) && defined (__DECC_VER)
-  fprintf (f, "DEC C %d */\n", __DECC_VER);
+  fprintf (f, "DEC C %d%s\n", __DECC_VER, cend);
 #else
-  fprintf (f, "system compiler */\n");
+  fprintf (f, "system compiler%s\n", cend);
 #endif
   fprintf (f, "\n\n");
-  fprintf (f, "#ifndef MPFR_TUNE_CASE\n");
-  fprintf (f, "#define MPFR_TUNE_CASE \"src/mparam.h\"\n");
-  fprintf (f, "#endif\n\n");
+  if (! runtime)
+    {
+      fprintf (f, "#ifndef MPFR_TUNE_CASE\n");
+      fprintf (f, "#define MPFR_TUNE_CASE \"src/mparam.h\"\n");
+      fprintf (f, "#endif\n\n");
+    }
 
   /* Tune mulhigh */
   tune_mul_mulders (f);
@@ -1060,6 +1151,11 @@ all (const char *filename)
   /* Tune sqrhigh */
   tune_sqr_mulders (f);
 
+  /* Tune the sizes of the full products, which are also used by
+     mpfr_divhigh_n */
+  tune_mulders_full (f, 0);
+  tune_mulders_full (f, 1);
+
   /* Tune divhigh */
   tune_div_mulders (f);
   fflush (f);
@@ -1069,47 +1165,47 @@ all (const char *filename)
     printf ("Tuning mpfr_mul...\n");
   tune_simple_func (&mpfr_mul_threshold, speed_mpfr_mul,
                     2*GMP_NUMB_BITS+1);
-  fprintf (f, "#define MPFR_MUL_THRESHOLD %lu /* limbs */\n",
-           (unsigned long) (mpfr_mul_threshold - 1) / GMP_NUMB_BITS + 1);
+  output_param (f, "MPFR_MUL_THRESHOLD",
+                (long) (mpfr_mul_threshold - 1) / GMP_NUMB_BITS + 1, "limbs");
 
   /* Tune mpfr_sqr (threshold is in limbs, but it doesn't matter too much) */
   if (verbose)
     printf ("Tuning mpfr_sqr...\n");
   tune_simple_func (&mpfr_sqr_threshold, speed_mpfr_sqr,
                     2*GMP_NUMB_BITS+1);
-  fprintf (f, "#define MPFR_SQR_THRESHOLD %lu /* limbs */\n",
-           (unsigned long) (mpfr_sqr_threshold - 1) / GMP_NUMB_BITS + 1);
+  output_param (f, "MPFR_SQR_THRESHOLD",
+                (long) (mpfr_sqr_threshold - 1) / GMP_NUMB_BITS + 1, "limbs");
 
   /* Tune mpfr_div (threshold is in limbs, but it doesn't matter too much) */
   if (verbose)
     printf ("Tuning mpfr_div...\n");
   tune_simple_func (&mpfr_div_threshold, speed_mpfr_div,
                     2*GMP_NUMB_BITS+1);
-  fprintf (f, "#define MPFR_DIV_THRESHOLD %lu /* limbs */\n",
-           (unsigned long) (mpfr_div_threshold - 1) / GMP_NUMB_BITS + 1);
+  output_param (f, "MPFR_DIV_THRESHOLD",
+                (long) (mpfr_div_threshold - 1) / GMP_NUMB_BITS + 1, "limbs");
 
   /* Tune mpfr_exp_2 */
   if (verbose)
     printf ("Tuning mpfr_exp_2...\n");
   tune_simple_func (&mpfr_exp_2_threshold, speed_mpfr_exp_2, GMP_NUMB_BITS);
-  fprintf (f, "#define MPFR_EXP_2_THRESHOLD %lu /* bits */\n",
-           (unsigned long) mpfr_exp_2_threshold);
+  output_param (f, "MPFR_EXP_2_THRESHOLD", (long) mpfr_exp_2_threshold,
+                "bits");
 
   /* Tune mpfr_exp */
   if (verbose)
     printf ("Tuning mpfr_exp...\n");
   tune_simple_func (&mpfr_exp_threshold, speed_mpfr_exp,
                     MPFR_PREC_MIN+3*GMP_NUMB_BITS);
-  fprintf (f, "#define MPFR_EXP_THRESHOLD %lu /* bits */\n",
-           (unsigned long) mpfr_exp_threshold);
+  output_param (f, "MPFR_EXP_THRESHOLD", (long) mpfr_exp_threshold,
+                "bits");
 
   /* Tune mpfr_sin_cos */
   if (verbose)
     printf ("Tuning mpfr_sin_cos...\n");
   tune_simple_func (&mpfr_sincos_threshold, speed_mpfr_sincos,
                     MPFR_PREC_MIN+3*GMP_NUMB_BITS);
-  fprintf (f, "#define MPFR_SINCOS_THRESHOLD %lu /* bits */\n",
-           (unsigned long) mpfr_sincos_threshold);
+  output_param (f, "MPFR_SINCOS_THRESHOLD", (long) mpfr_sincos_threshold,
+                "bits");
 
   /* Tune mpfr_ai */
   if (verbose)
@@ -1153,16 +1249,19 @@ all (const char *filename)
   mpfr_div (tmp1, tmp1, x3, MPFR_RNDN);
   mpfr_ai_threshold3 = mpfr_get_si (tmp1, MPFR_RNDN);
 
-  fprintf (f, "#define MPFR_AI_THRESHOLD1 %ld /* threshold for negative input of mpfr_ai */\n", mpfr_ai_threshold1);
-  fprintf (f, "#define MPFR_AI_THRESHOLD2 %ld\n", mpfr_ai_threshold2);
-  fprintf (f, "#define MPFR_AI_THRESHOLD3 %ld\n", mpfr_ai_threshold3);
+  output_param (f, "MPFR_AI_THRESHOLD1", mpfr_ai_threshold1,
+                "threshold for negative input of mpfr_ai");
+  output_param (f, "MPFR_AI_THRESHOLD2", mpfr_ai_threshold2, NULL);
+  output_param (f, "MPFR_AI_THRESHOLD3", mpfr_ai_threshold3, NULL);
 
   mpfr_clear (x1); mpfr_clear (x2); mpfr_clear (x3);
   mpfr_clear (tmp1); mpfr_clear (tmp2);
 
   /* End of tuning */
   time (&end_time);
-  fprintf (f, "/* Tuneup completed successfully, took %ld seconds */\n",
+  fprintf (f, runtime ?
+           "# Tuneup completed successfully, took %ld seconds\n" :
+           "/* Tuneup completed successfully, took %ld seconds */\n",
            (long) (end_time - start_time));
   if (verbose)
     printf ("Complete (took %ld seconds).\n", (long) (end_time - start_time));
@@ -1174,17 +1273,25 @@ all (const char *filename)
 /* Main function */
 int main (int argc, char *argv[])
 {
+  int i;
+
   /* Unbuffered so if output is redirected to a file it isn't lost if the
      program is killed part way through.  */
   setbuf (stdout, NULL);
   setbuf (stderr, NULL);
 
-  verbose = argc > 1;
+  /* -r: generate the file mpfr.tune, to be read by mpfr_tune_load, instead
+     of mparam.h; any other argument: verbose */
+  for (i = 1; i < argc; i++)
+    if (strcmp (argv[i], "-r") == 0)
+      runtime = 1;
+    else
+      verbose = 1;
 
   if (verbose)
     printf ("Tuning MPFR (Coffee time?)...\n");
 
-  all ("mparam.h");
+  all (runtime ? "mpfr.tune" : "mparam.h");
 
   return 0;
 }